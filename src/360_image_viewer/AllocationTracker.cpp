@@ -0,0 +1,276 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "AllocationTracker.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(VIEWER_TRACK_ALLOCATIONS) && __has_include(<execinfo.h>)
+    #include <execinfo.h>
+    #define VIEWER_HAS_BACKTRACE
+#endif
+
+namespace
+{
+    constexpr int MAX_STACK_DEPTH = 24;
+    constexpr size_t MAX_SAMPLES = 16;
+
+    struct StackSample
+    {
+        void* frames[MAX_STACK_DEPTH];
+        int depth;
+        size_t size;
+    };
+
+    // Everything here is trivially constructible so that using it from
+    // operator new doesn't allocate.
+    thread_local AllocationCounts thread_counts;
+    thread_local unsigned sampling_interval = 0;
+    thread_local bool is_sampling = false;
+    thread_local StackSample samples[MAX_SAMPLES];
+    thread_local size_t sample_count = 0;
+
+#ifdef VIEWER_TRACK_ALLOCATIONS
+    void sample_stack(size_t size)
+    {
+        // backtrace may allocate the first time it is called, and
+        // is_sampling stops the recursion.
+        if (sampling_interval == 0 || is_sampling || sample_count == MAX_SAMPLES
+            || thread_counts.allocations % sampling_interval != 0)
+        {
+            return;
+        }
+#ifdef VIEWER_HAS_BACKTRACE
+        is_sampling = true;
+        auto& sample = samples[sample_count++];
+        sample.depth = backtrace(sample.frames, MAX_STACK_DEPTH);
+        sample.size = size;
+        is_sampling = false;
+#endif
+    }
+
+    void* allocate(size_t size, size_t alignment, bool can_throw)
+    {
+        ++thread_counts.allocations;
+        thread_counts.bytes += size;
+        sample_stack(size);
+
+        if (size == 0)
+            size = 1;
+        void* p = nullptr;
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            p = std::malloc(size);
+#ifdef _WIN32
+        else
+            p = _aligned_malloc(size, alignment);
+#else
+        else
+            p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+        if (!p && can_throw)
+            throw std::bad_alloc();
+        return p;
+    }
+
+    void deallocate(void* p, size_t alignment)
+    {
+        if (!p)
+            return;
+        ++thread_counts.deallocations;
+#ifdef _WIN32
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            _aligned_free(p);
+            return;
+        }
+#endif
+        (void)alignment;
+        std::free(p);
+    }
+#endif
+}
+
+#ifdef VIEWER_TRACK_ALLOCATIONS
+
+constexpr auto DEFAULT_ALIGNMENT = size_t(__STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+void* operator new(size_t size)
+{
+    return allocate(size, DEFAULT_ALIGNMENT, true);
+}
+
+void* operator new[](size_t size)
+{
+    return allocate(size, DEFAULT_ALIGNMENT, true);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size, DEFAULT_ALIGNMENT, false);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size, DEFAULT_ALIGNMENT, false);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return allocate(size, size_t(alignment), true);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return allocate(size, size_t(alignment), true);
+}
+
+void* operator new(size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept
+{
+    return allocate(size, size_t(alignment), false);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept
+{
+    return allocate(size, size_t(alignment), false);
+}
+
+void operator delete(void* p) noexcept
+{
+    deallocate(p, DEFAULT_ALIGNMENT);
+}
+
+void operator delete[](void* p) noexcept
+{
+    deallocate(p, DEFAULT_ALIGNMENT);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    deallocate(p, DEFAULT_ALIGNMENT);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+    deallocate(p, DEFAULT_ALIGNMENT);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    deallocate(p, DEFAULT_ALIGNMENT);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    deallocate(p, DEFAULT_ALIGNMENT);
+}
+
+void operator delete(void* p, std::align_val_t alignment) noexcept
+{
+    deallocate(p, size_t(alignment));
+}
+
+void operator delete[](void* p, std::align_val_t alignment) noexcept
+{
+    deallocate(p, size_t(alignment));
+}
+
+void operator delete(void* p, size_t, std::align_val_t alignment) noexcept
+{
+    deallocate(p, size_t(alignment));
+}
+
+void operator delete[](void* p, size_t, std::align_val_t alignment) noexcept
+{
+    deallocate(p, size_t(alignment));
+}
+
+void operator delete(void* p, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept
+{
+    deallocate(p, size_t(alignment));
+}
+
+void operator delete[](void* p, std::align_val_t alignment,
+                       const std::nothrow_t&) noexcept
+{
+    deallocate(p, size_t(alignment));
+}
+
+#endif
+
+AllocationCounts get_thread_allocation_counts()
+{
+    return thread_counts;
+}
+
+void set_allocation_sampling(unsigned interval)
+{
+    sampling_interval = interval;
+}
+
+void write_allocation_samples()
+{
+    for (size_t i = 0; i < sample_count; ++i)
+    {
+        const auto& sample = samples[i];
+        fprintf(stderr, "Allocation of %zu bytes:\n", sample.size);
+#ifdef VIEWER_HAS_BACKTRACE
+        backtrace_symbols_fd(sample.frames, sample.depth, 2);
+#endif
+    }
+    fflush(stderr);
+    sample_count = 0;
+}
+
+void FrameAllocationCounter::end_frame()
+{
+    auto counts = get_thread_allocation_counts();
+    if (has_started_)
+    {
+        auto n = counts.allocations - frame_start_.allocations;
+        ++frame_count_;
+        if (n != 0)
+            ++allocating_frame_count_;
+        total_allocations_ += n;
+        max_allocations_ = std::max(max_allocations_, n);
+    }
+    frame_start_ = counts;
+    has_started_ = true;
+}
+
+void FrameAllocationCounter::reset()
+{
+    frame_count_ = 0;
+    allocating_frame_count_ = 0;
+    total_allocations_ = 0;
+    max_allocations_ = 0;
+}
+
+size_t FrameAllocationCounter::frame_count() const
+{
+    return frame_count_;
+}
+
+size_t FrameAllocationCounter::allocating_frame_count() const
+{
+    return allocating_frame_count_;
+}
+
+size_t FrameAllocationCounter::total_allocations() const
+{
+    return total_allocations_;
+}
+
+size_t FrameAllocationCounter::max_allocations() const
+{
+    return max_allocations_;
+}
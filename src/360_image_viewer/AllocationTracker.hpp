@@ -0,0 +1,72 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+
+// Building with the CMake option VIEWER_TRACK_ALLOCATIONS replaces the
+// global operator new and delete with versions that count the
+// allocations made by each thread. Without it, the counts are always 0.
+#ifdef VIEWER_TRACK_ALLOCATIONS
+    constexpr bool IS_TRACKING_ALLOCATIONS = true;
+#else
+    constexpr bool IS_TRACKING_ALLOCATIONS = false;
+#endif
+
+struct AllocationCounts
+{
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytes = 0;
+};
+
+// Returns the number of allocations the calling thread has made since
+// it started.
+[[nodiscard]]
+AllocationCounts get_thread_allocation_counts();
+
+// Makes the calling thread record the call stack of every interval'th
+// allocation, up to a fixed number of stacks. 0 stops the recording.
+// Call stacks are only available on platforms with execinfo.h.
+void set_allocation_sampling(unsigned interval);
+
+// Writes the recorded call stacks to stderr and forgets them. Doesn't
+// allocate memory itself.
+void write_allocation_samples();
+
+// Counts the allocations the calling thread makes in each frame.
+class FrameAllocationCounter
+{
+public:
+    // Marks the end of one frame and the start of the next. The first
+    // call only starts the first frame.
+    void end_frame();
+
+    // Forgets the frames that have been counted.
+    void reset();
+
+    [[nodiscard]]
+    size_t frame_count() const;
+
+    // The number of frames that allocated memory.
+    [[nodiscard]]
+    size_t allocating_frame_count() const;
+
+    [[nodiscard]]
+    size_t total_allocations() const;
+
+    // The largest number of allocations made by a single frame.
+    [[nodiscard]]
+    size_t max_allocations() const;
+private:
+    AllocationCounts frame_start_;
+    bool has_started_ = false;
+    size_t frame_count_ = 0;
+    size_t allocating_frame_count_ = 0;
+    size_t total_allocations_ = 0;
+    size_t max_allocations_ = 0;
+};
@@ -0,0 +1,155 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "AnnotationLayer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // The diameter of the markers in pixels.
+    constexpr float MARKER_SIZE = 9;
+    constexpr float HIGHLIGHTED_MARKER_SIZE = 15;
+
+    // Returns the angle from the screen's center to its farthest corner.
+    double get_view_radius(Camera& camera)
+    {
+        auto center = camera.calc_center_pos();
+        double max_angle = 0;
+        for (auto corner: {Xyz::Vector2D(-1, -1), Xyz::Vector2D(1, -1),
+                           Xyz::Vector2D(-1, 1), Xyz::Vector2D(1, 1)})
+        {
+            auto pos = Xyz::to_cartesian(camera.calc_sphere_pos(corner));
+            auto cos_angle = std::clamp(Xyz::dot(center, pos), -1.0, 1.0);
+            max_angle = std::max(max_angle, std::acos(cos_angle));
+        }
+        return max_angle;
+    }
+
+    // Returns the angle on the sphere covered by pixels pixels at the
+    // center of the screen.
+    double get_pixel_angle(Camera& camera, float pixels)
+    {
+        auto [w, h] = camera.screen_res();
+        auto size = std::max(std::min(w, h), 1.0);
+        return camera.view_angle() * pixels / size;
+    }
+}
+
+void AnnotationLayer::set_markers(const std::vector<Xyz::SphericalPointD>& positions)
+{
+    std::vector<Xyz::Vector3F> directions;
+    directions.reserve(positions.size());
+    for (const auto& pos: positions)
+        directions.push_back(Xyz::vector_cast<float>(Xyz::to_cartesian(pos)));
+
+    index_ = MarkerIndex(directions);
+    marker_positions_.resize(index_.size());
+    for (size_t i = 0; i < index_.size(); ++i)
+        marker_positions_[index_.ids()[i]] = uint32_t(i);
+    highlighted_ = {};
+    is_uploaded_ = false;
+}
+
+size_t AnnotationLayer::marker_count() const
+{
+    return index_.size();
+}
+
+std::optional<size_t>
+AnnotationLayer::find_marker(Camera& camera,
+                             const Xyz::Vector2D& screen_pos)
+{
+    if (index_.size() == 0)
+        return {};
+
+    auto pos = Xyz::to_cartesian(camera.calc_sphere_pos(screen_pos));
+    auto radius = get_pixel_angle(camera, MARKER_SIZE / 2);
+    // draw recomputes ranges_, so it can be borrowed here.
+    if (auto i = index_.find_nearest(pos, radius, ranges_))
+        return index_.ids()[*i];
+    return {};
+}
+
+bool AnnotationLayer::set_highlighted_marker(std::optional<size_t> index)
+{
+    if (index == highlighted_)
+        return false;
+    highlighted_ = index;
+    return true;
+}
+
+void AnnotationLayer::draw(Camera& camera,
+                           const Xyz::Matrix4F& mv_matrix,
+                           const Xyz::Matrix4F& p_matrix)
+{
+    visible_count_ = 0;
+    if (index_.size() == 0)
+        return;
+
+    if (!is_setup_)
+        setup();
+    Tungsten::bind_vertex_array(vertex_array_);
+    if (!is_uploaded_)
+        upload_markers();
+
+    auto radius = get_view_radius(camera)
+                  + get_pixel_angle(camera, HIGHLIGHTED_MARKER_SIZE);
+    index_.find_ranges(camera.calc_center_pos(), radius, ranges_);
+
+    Tungsten::use_program(program_.program);
+    program_.mv_matrix.set(mv_matrix);
+    program_.p_matrix.set(p_matrix);
+    program_.color.set({1.f, 0.6f, 0.f, 1.f});
+    program_.point_size.set(MARKER_SIZE);
+    for (auto [first, end]: ranges_)
+    {
+        glDrawArrays(GL_POINTS, GLint(first), GLsizei(end - first));
+        visible_count_ += end - first;
+    }
+
+    if (highlighted_ && *highlighted_ < marker_positions_.size())
+    {
+        program_.color.set({1.f, 1.f, 0.f, 1.f});
+        program_.point_size.set(HIGHLIGHTED_MARKER_SIZE);
+        glDrawArrays(GL_POINTS, GLint(marker_positions_[*highlighted_]), 1);
+    }
+}
+
+size_t AnnotationLayer::visible_count() const
+{
+    return visible_count_;
+}
+
+void AnnotationLayer::setup()
+{
+#ifdef GL_PROGRAM_POINT_SIZE
+    // Desktop OpenGL ignores gl_PointSize unless this is enabled.
+    glEnable(GL_PROGRAM_POINT_SIZE);
+#endif
+    vertex_array_ = Tungsten::generate_vertex_array();
+    Tungsten::bind_vertex_array(vertex_array_);
+    buffer_ = Tungsten::generate_buffer();
+    Tungsten::bind_buffer(GL_ARRAY_BUFFER, buffer_);
+    program_.setup();
+    Tungsten::define_vertex_attribute_float_pointer(
+        program_.position, 3, 3 * sizeof(float), 0);
+    Tungsten::enable_vertex_attribute(program_.position);
+    is_setup_ = true;
+}
+
+// The vertex array must be bound.
+void AnnotationLayer::upload_markers()
+{
+    const auto& positions = index_.positions();
+    Tungsten::bind_buffer(GL_ARRAY_BUFFER, buffer_);
+    Tungsten::set_buffer_data(GL_ARRAY_BUFFER,
+                              GLsizeiptr(positions.size() * sizeof(positions[0])),
+                              positions.data(), GL_STATIC_DRAW);
+    is_uploaded_ = true;
+}
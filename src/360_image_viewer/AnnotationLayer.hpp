@@ -0,0 +1,63 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <optional>
+#include <vector>
+#include <Tungsten/Tungsten.hpp>
+#include "Camera.hpp"
+#include "MarkerIndex.hpp"
+#include "MarkerShaderProgram.hpp"
+
+// Draws markers at points of interest on the sphere and finds the
+// marker under the mouse cursor. The markers are stored in a MarkerIndex
+// and uploaded once in the index's order, each frame only the ranges of
+// markers in cells that overlap the view are drawn.
+class AnnotationLayer
+{
+public:
+    // Marker i gets index i, the positions are in radians.
+    void set_markers(const std::vector<Xyz::SphericalPointD>& positions);
+
+    [[nodiscard]]
+    size_t marker_count() const;
+
+    // Returns the index of the marker closest to screen_pos, if there
+    // is one within the marker's radius.
+    [[nodiscard]]
+    std::optional<size_t> find_marker(Camera& camera,
+                                      const Xyz::Vector2D& screen_pos);
+
+    // Returns true if the highlighted marker changed.
+    bool set_highlighted_marker(std::optional<size_t> index);
+
+    // Draws the markers that are visible with the view in camera.
+    void draw(Camera& camera,
+              const Xyz::Matrix4F& mv_matrix,
+              const Xyz::Matrix4F& p_matrix);
+
+    // The number of markers drawn by the last call to draw.
+    [[nodiscard]]
+    size_t visible_count() const;
+private:
+    void setup();
+
+    void upload_markers();
+
+    MarkerIndex index_;
+    std::vector<MarkerIndex::Range> ranges_;
+    // The position in index_ of each marker.
+    std::vector<uint32_t> marker_positions_;
+    std::optional<size_t> highlighted_;
+    size_t visible_count_ = 0;
+
+    bool is_setup_ = false;
+    bool is_uploaded_ = false;
+    Tungsten::BufferHandle buffer_;
+    Tungsten::VertexArrayHandle vertex_array_;
+    MarkerShaderProgram program_;
+};
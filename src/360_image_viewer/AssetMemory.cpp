@@ -0,0 +1,54 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "AssetMemory.hpp"
+
+#include <iomanip>
+#include <ostream>
+
+namespace
+{
+    double to_mb(size_t bytes)
+    {
+        return double(bytes) / (1 << 20);
+    }
+
+    void write_line(std::ostream& os, const std::string& name,
+                    size_t host_bytes, size_t gpu_bytes)
+    {
+        os << std::left << std::setw(20) << name << std::right
+           << std::fixed << std::setprecision(2)
+           << std::setw(12) << to_mb(host_bytes)
+           << std::setw(12) << to_mb(gpu_bytes) << "\n";
+    }
+}
+
+size_t get_host_bytes(const std::vector<AssetMemory>& assets)
+{
+    size_t result = 0;
+    for (const auto& asset: assets)
+        result += asset.host_bytes;
+    return result;
+}
+
+size_t get_gpu_bytes(const std::vector<AssetMemory>& assets)
+{
+    size_t result = 0;
+    for (const auto& asset: assets)
+        result += asset.gpu_bytes;
+    return result;
+}
+
+void write_asset_memory(std::ostream& os,
+                        const std::vector<AssetMemory>& assets)
+{
+    os << std::left << std::setw(20) << "asset" << std::right
+       << std::setw(12) << "host MB" << std::setw(12) << "GPU MB" << "\n";
+    for (const auto& asset: assets)
+        write_line(os, asset.name, asset.host_bytes, asset.gpu_bytes);
+    write_line(os, "total", get_host_bytes(assets), get_gpu_bytes(assets));
+}
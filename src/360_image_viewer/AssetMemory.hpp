@@ -0,0 +1,31 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// The memory an asset currently uses in host RAM and on the GPU. GPU
+// bytes are estimated from the size and format of the textures.
+struct AssetMemory
+{
+    std::string name;
+    size_t host_bytes = 0;
+    size_t gpu_bytes = 0;
+};
+
+[[nodiscard]]
+size_t get_host_bytes(const std::vector<AssetMemory>& assets);
+
+[[nodiscard]]
+size_t get_gpu_bytes(const std::vector<AssetMemory>& assets);
+
+// Writes a table with one line per asset and a line with the totals.
+void write_asset_memory(std::ostream& os,
+                        const std::vector<AssetMemory>& assets);
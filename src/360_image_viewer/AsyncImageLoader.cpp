@@ -0,0 +1,317 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "AsyncImageLoader.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include "ImageLoader.hpp"
+#include "JpegDecoder.hpp"
+#include "Parallel.hpp"
+
+namespace
+{
+    enum EventCode
+    {
+        IMAGE_LOADED,
+        ROWS_DECODED
+    };
+
+    // Enough stripes that the visible part of a zoomed-in view is only a
+    // small part of the image.
+    constexpr unsigned REGION_STRIPES = 64;
+}
+
+void log_cache_stats(const DecodedImageCacheStats& stats)
+{
+    SDL_Log("Decoded image cache: %zu of %zu lookups were hits (%.0f%%),"
+            " %.1f MB saved.", stats.hits, stats.lookups,
+            stats.hit_rate() * 100, double(stats.bytes_saved) / (1 << 20));
+}
+
+AsyncImageLoader::AsyncImageLoader() = default;
+
+AsyncImageLoader::~AsyncImageLoader()
+{
+    if (!worker_.joinable())
+        return;
+
+    {
+        std::lock_guard lock(mutex_);
+        is_stopping_ = true;
+    }
+    condition_.notify_one();
+    worker_.join();
+}
+
+void AsyncImageLoader::load_file(std::string path, const ImageRequest& request,
+                                 unsigned decode_thread_count,
+                                 DecodedImageCache* image_cache)
+{
+    Job job{[path, decode_thread_count, image_cache]
+            {
+                using namespace std::chrono;
+                auto start = steady_clock::now();
+                auto img = image_cache
+                           ? image_cache->read_image_file(path, decode_thread_count)
+                           : read_image_file(path, decode_thread_count);
+                auto msecs = duration<double, std::milli>(steady_clock::now() - start).count();
+                SDL_Log("Read %s (%zux%zu) in %.1f ms.", path.c_str(),
+                        img.width(), img.height(), msecs);
+                if (image_cache)
+                    log_cache_stats(image_cache->stats());
+                return img;
+            },
+            {}, request, decode_thread_count};
+    // Images in the cache are already decoded.
+    if (request.view_region && !image_cache)
+    {
+        job.read_jpeg = [path]
+        {
+            auto file = std::make_shared<std::vector<char>>(read_file_if_jpeg(path));
+            if (file->empty())
+                return EncodedImage();
+            return EncodedImage{file, file->data(), file->size()};
+        };
+    }
+    start(std::move(job));
+}
+
+void AsyncImageLoader::load_data(void* data, size_t size,
+                                 const ImageRequest& request,
+                                 unsigned decode_thread_count)
+{
+    // The job is a std::function, which must be copyable, so the buffer
+    // can't be held by a unique_ptr.
+    auto buffer = std::shared_ptr<void>(data, free);
+    Job job{[buffer, size, decode_thread_count]() mutable
+            {
+                using namespace std::chrono;
+                auto start = steady_clock::now();
+                auto img = read_image_data(buffer.get(), size, decode_thread_count);
+                buffer.reset();
+                auto msecs = duration<double, std::milli>(steady_clock::now() - start).count();
+                SDL_Log("Read %zu bytes (%zux%zu) in %.1f ms.", size,
+                        img.width(), img.height(), msecs);
+                return img;
+            },
+            {}, request, decode_thread_count};
+    if (request.view_region && is_jpeg(data, size))
+    {
+        job.read_jpeg = [buffer, size]
+        {
+            return EncodedImage{buffer, buffer.get(), size};
+        };
+    }
+    start(std::move(job));
+}
+
+std::optional<LoadedImage> AsyncImageLoader::take_result(const SDL_Event& event)
+{
+    if (event_type_ == 0 || event.type != event_type_
+        || event.user.code != IMAGE_LOADED)
+    {
+        return {};
+    }
+
+    std::lock_guard lock(mutex_);
+    auto result = std::move(result_);
+    result_.reset();
+    return result;
+}
+
+std::optional<DecodedRows> AsyncImageLoader::take_rows(const SDL_Event& event)
+{
+    if (event_type_ == 0 || event.type != event_type_
+        || event.user.code != ROWS_DECODED)
+    {
+        return {};
+    }
+
+    std::lock_guard lock(mutex_);
+    auto rows = std::move(rows_);
+    rows_.reset();
+    return rows;
+}
+
+void AsyncImageLoader::start(Job job)
+{
+    if (event_type_ == 0)
+        event_type_ = SDL_RegisterEvents(1);
+
+    if constexpr (!HAS_THREADS)
+    {
+        run_job(job);
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        pending_job_ = std::move(job);
+    }
+    condition_.notify_one();
+
+    if (!worker_.joinable())
+        worker_ = std::thread([this] {run_worker();});
+}
+
+void AsyncImageLoader::run_worker()
+{
+    while (true)
+    {
+        std::optional<Job> job;
+        {
+            std::unique_lock lock(mutex_);
+            condition_.wait(lock, [this] {return is_stopping_ || pending_job_;});
+            if (is_stopping_)
+                return;
+            job = std::move(pending_job_);
+            pending_job_.reset();
+        }
+        run_job(*job);
+    }
+}
+
+void AsyncImageLoader::run_job(Job& job)
+{
+    try
+    {
+        using namespace std::chrono;
+        auto start = steady_clock::now();
+        Yimage::Image img;
+        if (job.read_jpeg)
+        {
+            auto jpeg = job.read_jpeg();
+            job.read_jpeg = {};
+            if (jpeg.data && load_by_region(jpeg, job.request, start,
+                                            job.decode_thread_count))
+            {
+                return;
+            }
+            // Don't read the file a second time.
+            if (jpeg.data)
+            {
+                img = read_image_data(jpeg.data, jpeg.size, job.decode_thread_count);
+                auto msecs = duration<double, std::milli>(steady_clock::now() - start).count();
+                SDL_Log("Read %zu bytes (%zux%zu) in %.1f ms.", jpeg.size,
+                        img.width(), img.height(), msecs);
+            }
+        }
+        if (!img)
+            img = job.read_image();
+        job.read_image = {};
+        auto decode_ms = duration<double, std::milli>(steady_clock::now() - start).count();
+        LoadedImage result{job.request,
+                           prepare_sphere_texture(std::move(img),
+                                                  job.request.texture_options,
+                                                  job.request.texture_limits),
+                           decode_ms};
+        {
+            std::lock_guard lock(mutex_);
+            // Drop the result if a newer request has arrived meanwhile.
+            if (pending_job_)
+                return;
+            result_ = std::move(result);
+        }
+
+        SDL_Event event = {};
+        event.type = event_type_;
+        event.user.code = IMAGE_LOADED;
+        SDL_PushEvent(&event);
+    }
+    catch (std::exception& ex)
+    {
+        std::cerr << ex.what() << "\n";
+    }
+}
+
+bool AsyncImageLoader::load_by_region(const EncodedImage& jpeg,
+                                      const ImageRequest& request,
+                                      std::chrono::steady_clock::time_point start,
+                                      unsigned thread_count)
+{
+    using namespace std::chrono;
+    JpegStripeDecoder decoder(jpeg.data, jpeg.size, REGION_STRIPES);
+    if (decoder.stripe_count() < 2)
+        return false;
+
+    auto img = std::make_shared<Yimage::Image>(decoder.make_image());
+    if (!can_upload_partially(img->width(), img->height(), img->pixel_type(),
+                              request.texture_options, request.texture_limits))
+    {
+        return false;
+    }
+
+    std::vector<RowRange> stripes;
+    for (size_t i = 0; i < decoder.stripe_count(); ++i)
+        stripes.push_back({decoder.stripe_first_row(i), decoder.stripe_row_count(i)});
+    auto order = make_load_order(*request.view_region, stripes, img->height());
+    if (thread_count == 0)
+        thread_count = get_default_thread_count();
+
+    // The visible stripes are decoded as one batch, the rest in batches
+    // of one stripe per thread. Each batch is handed to the main thread
+    // as soon as it has been decoded.
+    DecodedRows rows;
+    rows.request = request;
+    rows.image = img;
+    rows.start_time = start;
+    size_t begin = 0;
+    auto end = std::max<size_t>(order.visible_count, 1);
+    while (begin < order.bands.size())
+    {
+        std::vector<size_t> batch(order.bands.begin() + std::ptrdiff_t(begin),
+                                  order.bands.begin() + std::ptrdiff_t(end));
+        decoder.decode_stripes(batch, *img, thread_count);
+        rows.rows.clear();
+        for (auto index: batch)
+            rows.rows.push_back(stripes[index]);
+        rows.is_complete = end == order.bands.size();
+        rows.decode_ms = duration<double, std::milli>(steady_clock::now() - start).count();
+        if (begin == 0)
+        {
+            SDL_Log("Decoded the visible %zu of %zu stripes in %.1f ms.",
+                    end, stripes.size(), rows.decode_ms);
+        }
+        if (!post_rows(rows))
+            return true;
+        begin = end;
+        end = std::min<size_t>(end + thread_count, order.bands.size());
+    }
+
+    SDL_Log("Read %zu bytes (%zux%zu) a region at a time in %.1f ms.",
+            jpeg.size, img->width(), img->height(), rows.decode_ms);
+    return true;
+}
+
+bool AsyncImageLoader::post_rows(const DecodedRows& rows)
+{
+    {
+        std::lock_guard lock(mutex_);
+        if (pending_job_ || is_stopping_)
+            return false;
+        // The main thread may not have taken the previous rows yet.
+        if (rows_ && rows_->image == rows.image)
+        {
+            rows_->rows.insert(rows_->rows.end(), rows.rows.begin(), rows.rows.end());
+            rows_->is_complete = rows.is_complete;
+            rows_->decode_ms = rows.decode_ms;
+        }
+        else
+        {
+            rows_ = rows;
+        }
+    }
+
+    SDL_Event event = {};
+    event.type = event_type_;
+    event.user.code = ROWS_DECODED;
+    SDL_PushEvent(&event);
+    return true;
+}
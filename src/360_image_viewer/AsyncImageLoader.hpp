@@ -0,0 +1,135 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "DecodedImageCache.hpp"
+#include "LoadScheduler.hpp"
+#include "Sphere.hpp"
+
+struct ImageRequest
+{
+    int azimuth = 0;
+    int polar = 0;
+    int zoom_level = 0;
+    TextureOptions texture_options;
+    TextureLimits texture_limits;
+    // If set, JPEGs that can be split into stripes and uploaded without
+    // changes are loaded a band of rows at a time, starting with the
+    // rows that are visible in this region.
+    std::optional<ViewRegion> view_region;
+};
+
+struct LoadedImage
+{
+    ImageRequest request;
+    SphereTexture texture;
+    // The time spent reading and decoding the image.
+    double decode_ms = 0;
+};
+
+// Rows of an image that is loaded a region at a time. The loader's
+// thread decodes the image's other rows while the main thread uploads
+// these, the main thread must therefore only read the rows it has been
+// given.
+struct DecodedRows
+{
+    ImageRequest request;
+    std::shared_ptr<const Yimage::Image> image;
+    std::vector<RowRange> rows;
+    // True if these are the last rows of the image.
+    bool is_complete = false;
+    // When the loader started reading the image.
+    std::chrono::steady_clock::time_point start_time;
+    // The time from start_time until the last rows were decoded.
+    double decode_ms = 0;
+};
+
+// Writes the hit rate and the saved bytes to the log.
+void log_cache_stats(const DecodedImageCacheStats& stats);
+
+// Reads images and prepares their textures on a background thread, and
+// hands the results back to the main thread with SDL user events. If
+// the program is built without thread support, the work is done by the
+// calling thread instead. Only the most recent request is kept, older
+// requests are dropped if they haven't started yet.
+class AsyncImageLoader
+{
+public:
+    AsyncImageLoader();
+
+    ~AsyncImageLoader();
+
+    // The image is read through image_cache unless it is null.
+    void load_file(std::string path, const ImageRequest& request,
+                   unsigned decode_thread_count = 0,
+                   DecodedImageCache* image_cache = nullptr);
+
+    // Takes ownership of data, which must have been allocated with
+    // malloc. It is freed as soon as the image has been decoded.
+    void load_data(void* data, size_t size, const ImageRequest& request,
+                   unsigned decode_thread_count = 0);
+
+    // Returns the loaded image if event is the one that announced it.
+    [[nodiscard]]
+    std::optional<LoadedImage> take_result(const SDL_Event& event);
+
+    // Returns the rows that have been decoded since the last time if
+    // event is the one that announced them.
+    [[nodiscard]]
+    std::optional<DecodedRows> take_rows(const SDL_Event& event);
+private:
+    // A file that is kept in memory by owner.
+    struct EncodedImage
+    {
+        std::shared_ptr<const void> owner;
+        const void* data = nullptr;
+        size_t size = 0;
+    };
+
+    struct Job
+    {
+        std::function<Yimage::Image()> read_image;
+        // Returns the file if it is a JPEG that can be loaded a region
+        // at a time, the image is otherwise read with read_image.
+        std::function<EncodedImage()> read_jpeg;
+        ImageRequest request;
+        unsigned decode_thread_count = 0;
+    };
+
+    void start(Job job);
+
+    void run_worker();
+
+    void run_job(Job& job);
+
+    // Returns false if the image must be decoded in one piece.
+    bool load_by_region(const EncodedImage& jpeg, const ImageRequest& request,
+                        std::chrono::steady_clock::time_point start,
+                        unsigned thread_count);
+
+    // Returns false if a newer request has arrived and the current one
+    // should be abandoned.
+    bool post_rows(const DecodedRows& rows);
+
+    Uint32 event_type_ = 0;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::optional<Job> pending_job_;
+    std::optional<LoadedImage> result_;
+    std::optional<DecodedRows> rows_;
+    bool is_stopping_ = false;
+    std::thread worker_;
+};
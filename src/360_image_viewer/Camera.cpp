@@ -0,0 +1,47 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Camera.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include "SpherePosCalculator.hpp"
+
+double get_inertia_duration(double speed)
+{
+    return std::sqrt(std::abs(speed));
+}
+
+double get_inertia_factor(double speed, double secs)
+{
+    // I'm using the equation of the "top left" quarter of an ellipse
+    // to control the "deceleration" of the screen movement.
+    // The ellipses a-value is the square root of the speed, its b-value
+    // is one quarter of the a-value, its center lies at x, y = radius, 0.
+    auto radius = get_inertia_duration(speed);
+    secs = std::clamp(secs, 0.0, radius);
+    return 0.25 * std::sqrt(secs * (2 * radius - secs));
+}
+
+Xyz::Matrix4F make_mv_matrix(Camera& camera)
+{
+    auto eye_vec = Xyz::vector_cast<float>(camera.calc_eye_pos());
+    auto center_vec = Xyz::vector_cast<float>(camera.calc_center_pos());
+    auto up_vec = Xyz::vector_cast<float>(camera.calc_up_vector());
+    return Xyz::make_look_at_matrix(eye_vec, center_vec, up_vec);
+}
+
+Xyz::Matrix4F make_p_matrix(const Camera& camera)
+{
+    // The near plane goes through the sphere's center, where the screen
+    // factors are measured.
+    auto eye_dist = camera.eye_dist();
+    auto [x, y] = Xyz::vector_cast<float>(
+        calc_screen_factors(camera.screen_res(), camera.view_angle(), eye_dist));
+    return Xyz::make_frustum_matrix<float>(-x, x, -y, y, float(eye_dist),
+                                           float(eye_dist + 1.5));
+}
@@ -0,0 +1,100 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <chrono>
+#include <Xyz/Xyz.hpp>
+
+// Drag positions older than this are ignored when the speed of the
+// inertia motion is calculated.
+constexpr double MAX_CENTER_POINT_AGE = 0.05;
+// The maximum speed of the inertia motion in radians per second.
+constexpr double MAX_SPEED = 4;
+
+// The viewer's camera. It sits inside the unit sphere, looks at the
+// point calc_center_pos and is moved by dragging the image with the
+// mouse. When the mouse button is released while the mouse is moving,
+// the camera continues moving for a while and slows down gradually.
+class Camera
+{
+public:
+    using Clock = std::chrono::high_resolution_clock;
+
+    virtual ~Camera() = default;
+
+    [[nodiscard]]
+    virtual Xyz::Vector3D calc_center_pos() = 0;
+
+    [[nodiscard]]
+    virtual Xyz::Vector3D calc_eye_pos() = 0;
+
+    [[nodiscard]]
+    virtual Xyz::Vector3D calc_up_vector() = 0;
+
+    // Returns the point on the sphere at screen_pos, where the screen
+    // goes from -1 to 1 along both axes.
+    [[nodiscard]]
+    virtual Xyz::SphericalPointD calc_sphere_pos(const Xyz::Vector2D& screen_pos) = 0;
+
+    // Makes the camera look in the given direction with the horizon
+    // level.
+    virtual void set_direction(double azimuth, double polar) = 0;
+
+    // Grabs the point on the sphere at screen_pos and stops any
+    // ongoing inertia motion.
+    virtual void begin_drag(const Xyz::Vector2D& screen_pos,
+                            Clock::time_point time) = 0;
+
+    // Turns the camera so that the grabbed point is at screen_pos.
+    virtual void drag(const Xyz::Vector2D& screen_pos,
+                      Clock::time_point time) = 0;
+
+    // Releases the grabbed point. Returns true if it was moving, in
+    // which case an inertia motion has started.
+    virtual bool end_drag(Clock::time_point time) = 0;
+
+    // Moves the camera to where the inertia motion is at time. Returns
+    // false if there is no motion, or it has ended.
+    virtual bool update_motion(Clock::time_point time) = 0;
+
+    [[nodiscard]]
+    virtual bool is_moving() const = 0;
+
+    [[nodiscard]]
+    virtual double eye_dist() const = 0;
+
+    virtual void set_eye_dist(double eye_dist) = 0;
+
+    [[nodiscard]]
+    virtual double view_angle() const = 0;
+
+    virtual void set_view_angle(double view_angle) = 0;
+
+    [[nodiscard]]
+    virtual Xyz::Vector2D screen_res() const = 0;
+
+    virtual void set_screen_res(const Xyz::Vector2D& screen_res) = 0;
+};
+
+// Returns how long an inertia motion with the given initial speed lasts
+// in seconds.
+[[nodiscard]]
+double get_inertia_duration(double speed);
+
+// Returns the distance an inertia motion with the given initial speed
+// has covered after secs seconds, divided by the speed.
+[[nodiscard]]
+double get_inertia_factor(double speed, double secs);
+
+// Returns the model-view matrix for the camera's current view.
+[[nodiscard]]
+Xyz::Matrix4F make_mv_matrix(Camera& camera);
+
+// Returns the projection matrix for the camera's view angle and screen
+// resolution.
+[[nodiscard]]
+Xyz::Matrix4F make_p_matrix(const Camera& camera);
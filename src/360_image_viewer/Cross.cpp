@@ -21,14 +21,6 @@ Cross::Cross()
     Tungsten::set_buffer_data(GL_ARRAY_BUFFER, sizeof(array),
                               array, GL_STATIC_DRAW);
     count_ = std::size(array) / 3;
-    program_.setup();
-    Tungsten::use_program(program_.program);
-    program_.color.set({1.f, 1.f, 0.f, 1.f});
-    program_.mv_matrix.set(Xyz::make_identity_matrix<float, 4>());
-    program_.p_matrix.set(Xyz::make_identity_matrix<float, 4>());
-    Tungsten::define_vertex_attribute_float_pointer(
-        program_.position, 3, 3 * sizeof(float), 0);
-    Tungsten::enable_vertex_attribute(program_.position);
 }
 
 void Cross::draw()
@@ -37,6 +29,23 @@ void Cross::draw()
         return;
 
     Tungsten::bind_vertex_array(vertex_array_);
+    if (!has_program_)
+        setup_program();
     Tungsten::use_program(program_.program);
     Tungsten::draw_line_array(0, count_);
 }
+
+// The cross is hidden by default, so its shader program isn't compiled
+// until it is shown. The vertex array must be bound.
+void Cross::setup_program()
+{
+    program_.setup();
+    Tungsten::use_program(program_.program);
+    program_.color.set({1.f, 1.f, 0.f, 1.f});
+    program_.mv_matrix.set(Xyz::make_identity_matrix<float, 4>());
+    program_.p_matrix.set(Xyz::make_identity_matrix<float, 4>());
+    Tungsten::define_vertex_attribute_float_pointer(
+        program_.position, 3, 3 * sizeof(float), 0);
+    Tungsten::enable_vertex_attribute(program_.position);
+    has_program_ = true;
+}
@@ -18,8 +18,11 @@ public:
 
     bool visible = false;
 private:
+    void setup_program();
+
     Tungsten::BufferHandle buffer_;
     Tungsten::VertexArrayHandle vertex_array_;
     GLsizei count_;
     Unicolor3DShaderProgram program_;
+    bool has_program_ = false;
 };
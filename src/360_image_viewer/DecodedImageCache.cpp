@@ -0,0 +1,251 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "DecodedImageCache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "ImageLoader.hpp"
+#include "ImageUtilities.hpp"
+
+namespace
+{
+    constexpr char FILE_MAGIC[4] = {'D', 'I', 'M', 'G'};
+    constexpr uint32_t FILE_VERSION = 1;
+    // The pixels start at the beginning of the second page.
+    constexpr size_t PIXEL_OFFSET = 4096;
+    constexpr size_t CHUNK_SIZE = 1 << 20;
+    constexpr uint64_t PRIME = 0x100000001B3ULL;
+
+    struct BlobHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t pixel_type;
+        uint32_t reserved;
+        uint64_t width;
+        uint64_t height;
+        uint64_t pixel_bytes;
+        uint64_t file_hash;
+        uint64_t file_size;
+    };
+
+    // The hash is split into four lanes that process every fourth
+    // 64-bit word, which lets the CPU work on them in parallel.
+    class ContentHasher
+    {
+    public:
+        // All calls but the last must be with a multiple of 32 bytes.
+        void add(const char* data, size_t size)
+        {
+            size_t i = 0;
+            for (; i + 32 <= size; i += 32)
+            {
+                uint64_t words[4];
+                memcpy(words, data + i, sizeof(words));
+                for (int j = 0; j < 4; ++j)
+                    lanes_[j] = mix(lanes_[j], words[j]);
+            }
+            for (; i < size; ++i)
+                lanes_[0] = (lanes_[0] ^ uint8_t(data[i])) * PRIME;
+            size_ += size;
+        }
+
+        [[nodiscard]]
+        ContentKey key() const
+        {
+            auto hash = lanes_[0];
+            for (int j = 1; j < 4; ++j)
+                hash = mix(hash, lanes_[j]);
+            hash ^= size_;
+            // The finalizer from MurmurHash3.
+            hash ^= hash >> 33u;
+            hash *= 0xFF51AFD7ED558CCDULL;
+            hash ^= hash >> 33u;
+            hash *= 0xC4CEB9FE1A85EC53ULL;
+            hash ^= hash >> 33u;
+            return {hash, size_};
+        }
+    private:
+        static uint64_t mix(uint64_t hash, uint64_t word)
+        {
+            hash = (hash ^ word) * PRIME;
+            return hash ^ (hash >> 29u);
+        }
+
+        uint64_t lanes_[4] = {0xCBF29CE484222325ULL, 0x84222325CBF29CE4ULL,
+                              0x9E3779B97F4A7C15ULL, 0x7F4A7C159E3779B9ULL};
+        uint64_t size_ = 0;
+    };
+
+    [[nodiscard]]
+    std::optional<Yimage::Image> read_blob(const std::string& path,
+                                           const ContentKey& key)
+    {
+        std::ifstream file(path, std::ios::binary);
+        BlobHeader header = {};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+            || memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0
+            || header.version != FILE_VERSION
+            || header.file_hash != key.hash
+            || header.file_size != key.size)
+        {
+            return {};
+        }
+
+        auto pixel_type = Yimage::PixelType(header.pixel_type);
+        size_t pixel_size;
+        try
+        {
+            pixel_size = get_pixel_size(pixel_type);
+        }
+        catch (std::exception&)
+        {
+            return {};
+        }
+
+        if (header.width == 0 || header.height == 0
+            || header.pixel_bytes != header.width * header.height * pixel_size)
+        {
+            return {};
+        }
+
+        Yimage::Image img(pixel_type, header.width, header.height);
+        if (img.size() != header.pixel_bytes
+            || !file.seekg(std::streamoff(PIXEL_OFFSET))
+            || !file.read(reinterpret_cast<char*>(img.data()),
+                          std::streamsize(img.size())))
+        {
+            return {};
+        }
+        return img;
+    }
+
+    void write_blob(const std::string& path, const ContentKey& key,
+                    const Yimage::Image& img)
+    {
+        BlobHeader header = {};
+        memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        header.version = FILE_VERSION;
+        header.pixel_type = uint32_t(img.pixel_type());
+        header.width = img.width();
+        header.height = img.height();
+        header.pixel_bytes = img.size();
+        header.file_hash = key.hash;
+        header.file_size = key.size;
+
+        std::vector<char> page(PIXEL_OFFSET);
+        memcpy(page.data(), &header, sizeof(header));
+
+        // Write to a temporary file and rename it, so that readers never
+        // see a partially written file.
+        auto tmp_path = path + ".tmp" + std::to_string(std::random_device()());
+        {
+            std::ofstream file(tmp_path, std::ios::binary);
+            file.write(page.data(), std::streamsize(page.size()));
+            file.write(reinterpret_cast<const char*>(img.data()),
+                       std::streamsize(img.size()));
+            if (!file)
+            {
+                file.close();
+                std::filesystem::remove(tmp_path);
+                throw std::runtime_error("Failed to write " + tmp_path + ".");
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp_path, path, ec);
+        if (ec)
+        {
+            std::error_code remove_ec;
+            std::filesystem::remove(tmp_path, remove_ec);
+            throw std::runtime_error("Failed to rename " + tmp_path + " to "
+                                     + path + ": " + ec.message());
+        }
+    }
+}
+
+std::optional<ContentKey> get_content_key(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return {};
+
+    ContentHasher hasher;
+    std::vector<char> buffer(CHUNK_SIZE);
+    while (file)
+    {
+        file.read(buffer.data(), std::streamsize(buffer.size()));
+        hasher.add(buffer.data(), size_t(file.gcount()));
+    }
+    if (!file.eof())
+        return {};
+    return hasher.key();
+}
+
+DecodedImageCache::DecodedImageCache(std::string dir)
+    : dir_(std::move(dir))
+{}
+
+Yimage::Image DecodedImageCache::read_image_file(const std::string& path,
+                                                 unsigned thread_count)
+{
+    auto key = get_content_key(path);
+    if (!key)
+        return ::read_image_file(path, thread_count);
+
+    auto blob_path = get_blob_path(*key);
+    if (auto img = read_blob(blob_path, *key))
+    {
+        add_lookup(img->size());
+        return std::move(*img);
+    }
+
+    add_lookup(0);
+    auto img = ::read_image_file(path, thread_count);
+    // A failure to store the image shouldn't prevent it from being shown.
+    try
+    {
+        std::filesystem::create_directories(dir_);
+        write_blob(blob_path, *key, img);
+    }
+    catch (std::exception& ex)
+    {
+        std::cerr << "Can not cache " << path << ": " << ex.what() << "\n";
+    }
+    return img;
+}
+
+DecodedImageCacheStats DecodedImageCache::stats() const
+{
+    std::lock_guard lock(mutex_);
+    return stats_;
+}
+
+std::string DecodedImageCache::get_blob_path(const ContentKey& key) const
+{
+    char name[48];
+    snprintf(name, sizeof(name), "%016llx-%llx.dimg",
+             static_cast<unsigned long long>(key.hash),
+             static_cast<unsigned long long>(key.size));
+    return (std::filesystem::path(dir_) / name).string();
+}
+
+void DecodedImageCache::add_lookup(size_t bytes_saved)
+{
+    std::lock_guard lock(mutex_);
+    ++stats_.lookups;
+    if (bytes_saved != 0)
+    {
+        ++stats_.hits;
+        stats_.bytes_saved += bytes_saved;
+    }
+}
@@ -0,0 +1,72 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <Yimage/Yimage.hpp>
+
+// Identifies a file by its contents rather than its path.
+struct ContentKey
+{
+    uint64_t hash = 0;
+    uint64_t size = 0;
+};
+
+// Reads the file in fixed-size chunks and hashes its contents. Returns
+// nothing if the file can't be read.
+[[nodiscard]]
+std::optional<ContentKey> get_content_key(const std::string& path);
+
+struct DecodedImageCacheStats
+{
+    size_t lookups = 0;
+    size_t hits = 0;
+    // The number of decoded pixel bytes that were read from the cache
+    // instead of being produced by the decoder.
+    size_t bytes_saved = 0;
+
+    [[nodiscard]]
+    double hit_rate() const
+    {
+        return lookups == 0 ? 0.0 : double(hits) / double(lookups);
+    }
+};
+
+// Stores decoded images in a directory with one file per image, named
+// after the hash of the encoded file. The same image is therefore only
+// decoded once, regardless of the path it is read from. The pixels are
+// stored uncompressed at a page-aligned offset, so the files can be
+// memory mapped. Files are written under a temporary name and renamed
+// when they are complete, which makes it safe for several processes
+// to use the same directory.
+class DecodedImageCache
+{
+public:
+    explicit DecodedImageCache(std::string dir);
+
+    // Returns the decoded image from the cache if it is there, otherwise
+    // decodes the file with ::read_image_file and stores the result.
+    // Can be called from any thread.
+    [[nodiscard]]
+    Yimage::Image read_image_file(const std::string& path,
+                                  unsigned thread_count = 0);
+
+    [[nodiscard]]
+    DecodedImageCacheStats stats() const;
+private:
+    [[nodiscard]]
+    std::string get_blob_path(const ContentKey& key) const;
+
+    void add_lookup(size_t bytes_saved);
+
+    std::string dir_;
+    mutable std::mutex mutex_;
+    DecodedImageCacheStats stats_;
+};
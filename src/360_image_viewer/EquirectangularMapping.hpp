@@ -0,0 +1,65 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <Xyz/Xyz.hpp>
+#include <Yimage/Yimage.hpp>
+
+// Returns the position in an equirectangular image, with both coordinates
+// in the range [0, 1], that the sphere mesh shows in the direction pos.
+// The top of the image is the north pole, the left and right edges are at
+// azimuth -90 degrees.
+[[nodiscard]]
+inline Xyz::Vector2D get_texture_pos(const Xyz::SphericalPointD& pos)
+{
+    constexpr auto PI = Xyz::Constants<double>::PI;
+    auto x = 0.75 - pos.azimuth / (2 * PI);
+    return {x - std::floor(x), 0.5 - pos.polar / PI};
+}
+
+// Returns the texture position in the direction dir, which doesn't have
+// to be normalized.
+[[nodiscard]]
+inline Xyz::Vector2D get_texture_pos(const Xyz::Vector3D& dir)
+{
+    auto [x, y, z] = dir;
+    return get_texture_pos(Xyz::SphericalPointD(1.0, std::atan2(y, x),
+                                                std::atan2(z, std::hypot(x, y))));
+}
+
+// Bilinear interpolation in an equirectangular image that wraps around
+// horizontally. Writes three bytes to rgb; gray images are expanded.
+inline void sample_panorama(const Yimage::Image& img, size_t channels,
+                            const Xyz::Vector2D& tex_pos, unsigned char* rgb)
+{
+    auto width = img.width(), height = img.height();
+    auto x = tex_pos[0] * double(width) - 0.5;
+    auto y = std::clamp(tex_pos[1] * double(height) - 0.5,
+                        0.0, double(height - 1));
+    auto x0 = std::floor(x), y0 = std::floor(y);
+    auto fx = x - x0, fy = y - y0;
+    auto col0 = size_t(int64_t(x0) + int64_t(width)) % width;
+    auto col1 = (col0 + 1) % width;
+    auto row0 = size_t(y0);
+    auto row1 = std::min(row0 + 1, height - 1);
+
+    auto row_size = img.row_size();
+    auto p00 = img.data() + row0 * row_size + col0 * channels;
+    auto p01 = img.data() + row0 * row_size + col1 * channels;
+    auto p10 = img.data() + row1 * row_size + col0 * channels;
+    auto p11 = img.data() + row1 * row_size + col1 * channels;
+    for (size_t c = 0; c < 3; ++c)
+    {
+        // Gray images have one color channel.
+        auto i = channels < 3 ? 0 : c;
+        auto top = p00[i] + fx * (p01[i] - p00[i]);
+        auto bottom = p10[i] + fx * (p11[i] - p10[i]);
+        rgb[c] = static_cast<unsigned char>(top + fy * (bottom - top) + 0.5);
+    }
+}
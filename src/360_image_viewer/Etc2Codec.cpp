@@ -0,0 +1,606 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Etc2Codec.hpp"
+
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include "ImageUtilities.hpp"
+#include "Parallel.hpp"
+
+namespace
+{
+    constexpr int MODIFIER_TABLES[8][4] = {
+        {2, 8, -2, -8},
+        {5, 17, -5, -17},
+        {9, 29, -9, -29},
+        {13, 42, -13, -42},
+        {18, 60, -18, -60},
+        {24, 80, -24, -80},
+        {33, 106, -33, -106},
+        {47, 183, -47, -183}
+    };
+
+    constexpr char FILE_MAGIC[4] = {'E', 'T', 'C', '2'};
+    constexpr uint32_t FILE_VERSION = 1;
+    constexpr size_t HEADER_SIZE = 24;
+
+    using Rgb = std::array<int, 3>;
+    // The pixels of a 4x4 block, row by row.
+    using Block = std::array<Rgb, 16>;
+
+    [[nodiscard]]
+    int clamp_255(int value)
+    {
+        return std::clamp(value, 0, 255);
+    }
+
+    [[nodiscard]]
+    int extend_bits(int value, int bits)
+    {
+        return (value << (8 - bits)) | (value >> (2 * bits - 8));
+    }
+
+    [[nodiscard]]
+    int quantize(double value, int bits)
+    {
+        auto max = (1 << bits) - 1;
+        return std::clamp(int(std::lround(value * max / 255.0)), 0, max);
+    }
+
+    [[nodiscard]]
+    int sign_extend_3(int value)
+    {
+        return value >= 4 ? value - 8 : value;
+    }
+
+    [[nodiscard]]
+    int get_error(const Rgb& a, const Rgb& b)
+    {
+        auto dr = a[0] - b[0], dg = a[1] - b[1], db = a[2] - b[2];
+        return dr * dr + dg * dg + db * db;
+    }
+
+    [[nodiscard]]
+    Rgb get_pixel(const unsigned char* pixel, size_t channels)
+    {
+        if (channels < 3)
+            return {pixel[0], pixel[0], pixel[0]};
+        return {pixel[0], pixel[1], pixel[2]};
+    }
+
+    // Pixels outside the image are replaced by the nearest pixel inside it.
+    [[nodiscard]]
+    Block read_block(const Yimage::Image& img, size_t channels,
+                     size_t block_x, size_t block_y)
+    {
+        Block block;
+        for (size_t y = 0; y < 4; ++y)
+        {
+            auto img_y = std::min(block_y * 4 + y, img.height() - 1);
+            auto row = img.data() + img_y * img.width() * channels;
+            for (size_t x = 0; x < 4; ++x)
+            {
+                auto img_x = std::min(block_x * 4 + x, img.width() - 1);
+                block[y * 4 + x] = get_pixel(row + img_x * channels, channels);
+            }
+        }
+        return block;
+    }
+
+    [[nodiscard]]
+    std::pair<int, int> get_subblock_pixel(bool flip, int subblock, int i)
+    {
+        if (flip)
+            return {i % 4, subblock * 2 + i / 4};
+        return {subblock * 2 + i / 4, i % 4};
+    }
+
+    [[nodiscard]]
+    std::array<double, 3> get_subblock_average(const Block& block,
+                                               bool flip, int subblock)
+    {
+        std::array<double, 3> sum = {};
+        for (int i = 0; i < 8; ++i)
+        {
+            auto [x, y] = get_subblock_pixel(flip, subblock, i);
+            for (int c = 0; c < 3; ++c)
+                sum[c] += block[y * 4 + x][c];
+        }
+        return {sum[0] / 8, sum[1] / 8, sum[2] / 8};
+    }
+
+    struct SubblockFit
+    {
+        int table = 0;
+        int error = INT_MAX;
+        uint32_t msb = 0;
+        uint32_t lsb = 0;
+    };
+
+    // Finds the modifier table and per-pixel modifiers that best
+    // approximate the subblock's pixels given its base color. Modifiers
+    // are added to all three channels, so the best one is the one closest
+    // to the mean difference between the pixel and the base color.
+    [[nodiscard]]
+    SubblockFit fit_subblock(const Block& block, bool flip, int subblock,
+                             const Rgb& base)
+    {
+        SubblockFit best;
+        for (int t = 0; t < 8 && best.error != 0; ++t)
+        {
+            const auto& modifiers = MODIFIER_TABLES[t];
+            SubblockFit fit{t, 0, 0, 0};
+            for (int i = 0; i < 8; ++i)
+            {
+                auto [x, y] = get_subblock_pixel(flip, subblock, i);
+                const auto& pixel = block[y * 4 + x];
+                auto diff = pixel[0] - base[0] + pixel[1] - base[1]
+                            + pixel[2] - base[2];
+                int index = 0;
+                for (int k = 1; k < 4; ++k)
+                {
+                    if (std::abs(diff - 3 * modifiers[k])
+                        < std::abs(diff - 3 * modifiers[index]))
+                    {
+                        index = k;
+                    }
+                }
+
+                auto m = modifiers[index];
+                Rgb color = {clamp_255(base[0] + m),
+                             clamp_255(base[1] + m),
+                             clamp_255(base[2] + m)};
+                fit.error += get_error(pixel, color);
+                auto bit = unsigned(x * 4 + y);
+                fit.msb |= uint32_t(index >> 1) << bit;
+                fit.lsb |= uint32_t(index & 1) << bit;
+            }
+
+            if (fit.error < best.error)
+                best = fit;
+        }
+        return best;
+    }
+
+    struct EncodedBlock
+    {
+        uint64_t bits = 0;
+        int error = INT_MAX;
+    };
+
+    [[nodiscard]]
+    uint64_t get_subblock_bits(const SubblockFit& fit0,
+                               const SubblockFit& fit1,
+                               bool flip)
+    {
+        return uint64_t(fit0.table) << 37u
+               | uint64_t(fit1.table) << 34u
+               | uint64_t(flip) << 32u
+               | uint64_t(fit0.msb | fit1.msb) << 16u
+               | uint64_t(fit0.lsb | fit1.lsb);
+    }
+
+    [[nodiscard]]
+    EncodedBlock encode_individual(const Block& block, bool flip)
+    {
+        Rgb q[2], base[2];
+        for (int s = 0; s < 2; ++s)
+        {
+            auto average = get_subblock_average(block, flip, s);
+            for (int c = 0; c < 3; ++c)
+            {
+                q[s][c] = quantize(average[c], 4);
+                base[s][c] = extend_bits(q[s][c], 4);
+            }
+        }
+
+        auto fit0 = fit_subblock(block, flip, 0, base[0]);
+        auto fit1 = fit_subblock(block, flip, 1, base[1]);
+        auto bits = uint64_t(q[0][0]) << 60u | uint64_t(q[1][0]) << 56u
+                    | uint64_t(q[0][1]) << 52u | uint64_t(q[1][1]) << 48u
+                    | uint64_t(q[0][2]) << 44u | uint64_t(q[1][2]) << 40u
+                    | get_subblock_bits(fit0, fit1, flip);
+        return {bits, fit0.error + fit1.error};
+    }
+
+    [[nodiscard]]
+    EncodedBlock encode_differential(const Block& block, bool flip)
+    {
+        Rgb q, delta, base[2];
+        auto average0 = get_subblock_average(block, flip, 0);
+        auto average1 = get_subblock_average(block, flip, 1);
+        for (int c = 0; c < 3; ++c)
+        {
+            q[c] = quantize(average0[c], 5);
+            delta[c] = std::clamp(quantize(average1[c], 5) - q[c], -4, 3);
+            base[0][c] = extend_bits(q[c], 5);
+            base[1][c] = extend_bits(q[c] + delta[c], 5);
+        }
+
+        auto fit0 = fit_subblock(block, flip, 0, base[0]);
+        auto fit1 = fit_subblock(block, flip, 1, base[1]);
+        auto bits = uint64_t(q[0]) << 59u | uint64_t(delta[0] & 7) << 56u
+                    | uint64_t(q[1]) << 51u | uint64_t(delta[1] & 7) << 48u
+                    | uint64_t(q[2]) << 43u | uint64_t(delta[2] & 7) << 40u
+                    | uint64_t(1) << 33u
+                    | get_subblock_bits(fit0, fit1, flip);
+        return {bits, fit0.error + fit1.error};
+    }
+
+    [[nodiscard]]
+    Rgb get_planar_color(const Rgb& o, const Rgb& h, const Rgb& v,
+                         int x, int y)
+    {
+        Rgb result;
+        for (int c = 0; c < 3; ++c)
+        {
+            result[c] = clamp_255((x * (h[c] - o[c]) + y * (v[c] - o[c])
+                                   + 4 * o[c] + 2) >> 2);
+        }
+        return result;
+    }
+
+    // In planar mode the dummy bits must make the red and green
+    // differential values valid and the blue ones overflow.
+    [[nodiscard]]
+    uint8_t get_non_overflowing_byte(uint8_t byte)
+    {
+        auto base = byte >> 3u;
+        auto delta = sign_extend_3(byte & 7);
+        if (base + delta < 0 || base + delta > 31)
+            byte |= 0x80u;
+        return byte;
+    }
+
+    [[nodiscard]]
+    uint64_t get_planar_bits(const Rgb& o, const Rgb& h, const Rgb& v)
+    {
+        std::array<uint8_t, 8> bytes = {};
+        bytes[0] = uint8_t(o[0] << 1u | o[1] >> 6u);
+        bytes[1] = uint8_t((o[1] & 0x3F) << 1u | o[2] >> 5u);
+        auto bo43 = (o[2] >> 3) & 3, bo21 = (o[2] >> 1) & 3;
+        if (bo43 + bo21 >= 4)
+            bytes[2] = uint8_t(0xE0 | bo43 << 3 | bo21);
+        else
+            bytes[2] = uint8_t(bo43 << 3 | 0x04 | bo21);
+        bytes[3] = uint8_t((o[2] & 1) << 7u | (h[0] >> 1) << 2u | 0x02 | (h[0] & 1));
+        bytes[4] = uint8_t(h[1] << 1u | h[2] >> 5u);
+        bytes[5] = uint8_t((h[2] & 0x1F) << 3u | v[0] >> 3u);
+        bytes[6] = uint8_t((v[0] & 7) << 5u | v[1] >> 2u);
+        bytes[7] = uint8_t((v[1] & 3) << 6u | v[2]);
+        bytes[0] = get_non_overflowing_byte(bytes[0]);
+        bytes[1] = get_non_overflowing_byte(bytes[1]);
+
+        uint64_t bits = 0;
+        for (auto byte: bytes)
+            bits = bits << 8u | byte;
+        return bits;
+    }
+
+    // Fits the plane O + x * (H - O) / 4 + y * (V - O) / 4 to the block's
+    // pixels with least squares.
+    [[nodiscard]]
+    EncodedBlock encode_planar(const Block& block)
+    {
+        constexpr int BITS[3] = {6, 7, 6};
+        Rgb qo, qh, qv, o, h, v;
+        for (int c = 0; c < 3; ++c)
+        {
+            double mean = 0, dx = 0, dy = 0;
+            for (int y = 0; y < 4; ++y)
+            {
+                for (int x = 0; x < 4; ++x)
+                {
+                    auto value = double(block[y * 4 + x][c]);
+                    mean += value;
+                    dx += (x - 1.5) * value;
+                    dy += (y - 1.5) * value;
+                }
+            }
+            mean /= 16;
+            // The sum of (x - 1.5)^2 over a block is 20.
+            auto a = dx / 20, b = dy / 20;
+            auto origin = mean - 1.5 * a - 1.5 * b;
+            qo[c] = quantize(origin, BITS[c]);
+            qh[c] = quantize(origin + 4 * a, BITS[c]);
+            qv[c] = quantize(origin + 4 * b, BITS[c]);
+            o[c] = extend_bits(qo[c], BITS[c]);
+            h[c] = extend_bits(qh[c], BITS[c]);
+            v[c] = extend_bits(qv[c], BITS[c]);
+        }
+
+        int error = 0;
+        for (int y = 0; y < 4; ++y)
+        {
+            for (int x = 0; x < 4; ++x)
+                error += get_error(block[y * 4 + x], get_planar_color(o, h, v, x, y));
+        }
+        return {get_planar_bits(qo, qh, qv), error};
+    }
+
+    [[nodiscard]]
+    uint64_t encode_block(const Block& block)
+    {
+        auto best = encode_planar(block);
+        for (auto flip: {false, true})
+        {
+            for (auto encode: {encode_differential, encode_individual})
+            {
+                if (best.error == 0)
+                    return best.bits;
+                auto result = encode(block, flip);
+                if (result.error < best.error)
+                    best = result;
+            }
+        }
+        return best.bits;
+    }
+
+    void write_block(uint64_t bits, uint8_t* dst)
+    {
+        for (int i = 7; i >= 0; --i)
+        {
+            dst[i] = uint8_t(bits);
+            bits >>= 8u;
+        }
+    }
+
+    [[nodiscard]]
+    Block decode_planar_block(const uint8_t* in)
+    {
+        Rgb o = {extend_bits((in[0] >> 1) & 0x3F, 6),
+                 extend_bits((in[0] & 1) << 6 | (in[1] >> 1 & 0x3F), 7),
+                 extend_bits((in[1] & 1) << 5 | (in[2] & 0x18)
+                             | (in[2] & 3) << 1 | in[3] >> 7, 6)};
+        Rgb h = {extend_bits((in[3] & 0x7C) >> 1 | (in[3] & 1), 6),
+                 extend_bits(in[4] >> 1, 7),
+                 extend_bits((in[4] & 1) << 5 | in[5] >> 3, 6)};
+        Rgb v = {extend_bits((in[5] & 7) << 3 | in[6] >> 5, 6),
+                 extend_bits((in[6] & 0x1F) << 2 | in[7] >> 6, 7),
+                 extend_bits(in[7] & 0x3F, 6)};
+        Block block;
+        for (int y = 0; y < 4; ++y)
+        {
+            for (int x = 0; x < 4; ++x)
+                block[y * 4 + x] = get_planar_color(o, h, v, x, y);
+        }
+        return block;
+    }
+
+    [[nodiscard]]
+    Block decode_block(const uint8_t* in)
+    {
+        Rgb base[2];
+        if (in[3] & 2u)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                auto q = in[c] >> 3;
+                auto q2 = q + sign_extend_3(in[c] & 7);
+                if (q2 < 0 || q2 > 31)
+                {
+                    if (c == 2)
+                        return decode_planar_block(in);
+                    throw std::runtime_error("ETC2 T and H modes are not supported.");
+                }
+                base[0][c] = extend_bits(q, 5);
+                base[1][c] = extend_bits(q2, 5);
+            }
+        }
+        else
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                base[0][c] = extend_bits(in[c] >> 4, 4);
+                base[1][c] = extend_bits(in[c] & 0xF, 4);
+            }
+        }
+
+        int tables[2] = {in[3] >> 5, (in[3] >> 2) & 7};
+        bool flip = in[3] & 1u;
+        auto msb = unsigned(in[4]) << 8u | in[5];
+        auto lsb = unsigned(in[6]) << 8u | in[7];
+        Block block;
+        for (int y = 0; y < 4; ++y)
+        {
+            for (int x = 0; x < 4; ++x)
+            {
+                auto bit = unsigned(x * 4 + y);
+                auto index = (msb >> bit & 1) << 1 | (lsb >> bit & 1);
+                auto s = flip ? y / 2 : x / 2;
+                auto m = MODIFIER_TABLES[tables[s]][index];
+                block[y * 4 + x] = {clamp_255(base[s][0] + m),
+                                    clamp_255(base[s][1] + m),
+                                    clamp_255(base[s][2] + m)};
+            }
+        }
+        return block;
+    }
+
+    [[nodiscard]]
+    uint64_t get_image_hash(const Yimage::Image& img)
+    {
+        constexpr uint64_t PRIME = 0x100000001B3ULL;
+        uint64_t hash = 0xCBF29CE484222325ULL ^ img.width() ^ (uint64_t(img.height()) << 32u);
+        hash ^= uint64_t(img.pixel_type()) << 48u;
+
+        auto data = img.data();
+        auto size = img.size();
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            uint64_t word;
+            memcpy(&word, data + i, 8);
+            hash = (hash ^ word) * PRIME;
+            hash ^= hash >> 29u;
+        }
+        for (; i < size; ++i)
+            hash = (hash ^ data[i]) * PRIME;
+        return hash;
+    }
+
+    [[nodiscard]]
+    std::string get_cache_file_name(const Yimage::Image& img)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx.etc2",
+                 static_cast<unsigned long long>(get_image_hash(img)));
+        return name;
+    }
+}
+
+Etc2Image encode_etc2(const Yimage::Image& img, unsigned thread_count)
+{
+    auto channels = get_channel_count(img.pixel_type());
+    Etc2Image result;
+    result.width = img.width();
+    result.height = img.height();
+    auto blocks_x = (img.width() + 3) / 4;
+    auto blocks_y = (img.height() + 3) / 4;
+    result.blocks.resize(blocks_x * blocks_y * 8);
+
+    parallel_for(blocks_y, [&](size_t by)
+    {
+        for (size_t bx = 0; bx < blocks_x; ++bx)
+        {
+            auto block = read_block(img, channels, bx, by);
+            write_block(encode_block(block),
+                        &result.blocks[(by * blocks_x + bx) * 8]);
+        }
+    }, thread_count);
+    return result;
+}
+
+Yimage::Image decode_etc2(const Etc2Image& img)
+{
+    auto blocks_x = (img.width + 3) / 4;
+    auto blocks_y = (img.height + 3) / 4;
+    if (img.blocks.size() != blocks_x * blocks_y * 8)
+        throw std::runtime_error("The ETC2 image has the wrong size.");
+
+    Yimage::Image result(Yimage::PixelType::RGB_8, img.width, img.height);
+    auto data = result.data();
+    for (size_t by = 0; by < blocks_y; ++by)
+    {
+        for (size_t bx = 0; bx < blocks_x; ++bx)
+        {
+            auto block = decode_block(&img.blocks[(by * blocks_x + bx) * 8]);
+            auto w = std::min<size_t>(4, img.width - bx * 4);
+            auto h = std::min<size_t>(4, img.height - by * 4);
+            for (size_t y = 0; y < h; ++y)
+            {
+                auto pixel = data + ((by * 4 + y) * img.width + bx * 4) * 3;
+                for (size_t x = 0; x < w; ++x)
+                {
+                    for (size_t c = 0; c < 3; ++c)
+                        *pixel++ = uint8_t(block[y * 4 + x][c]);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+double calc_psnr(const Yimage::Image& a, const Yimage::Image& b)
+{
+    if (a.width() != b.width() || a.height() != b.height())
+        throw std::runtime_error("Can not compare images of different sizes.");
+
+    auto a_channels = get_channel_count(a.pixel_type());
+    auto b_channels = get_channel_count(b.pixel_type());
+    auto count = a.width() * a.height();
+    double sum = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        sum += get_error(get_pixel(a.data() + i * a_channels, a_channels),
+                         get_pixel(b.data() + i * b_channels, b_channels));
+    }
+
+    if (sum == 0)
+        return INFINITY;
+    auto mse = sum / double(3 * count);
+    return 10 * std::log10(255.0 * 255.0 / mse);
+}
+
+void write_etc2_file(const std::string& path, const Etc2Image& img)
+{
+    // Write to a temporary file and rename it, so that other processes
+    // never see a partially written file.
+    auto tmp_path = path + ".tmp" + std::to_string(std::random_device()());
+    {
+        std::ofstream file(tmp_path, std::ios::binary);
+        char header[HEADER_SIZE];
+        uint32_t fields[3] = {FILE_VERSION, uint32_t(img.width), uint32_t(img.height)};
+        memcpy(header, FILE_MAGIC, sizeof(FILE_MAGIC));
+        memcpy(header + 4, fields, sizeof(fields));
+        memcpy(header + 16, &img.psnr, sizeof(img.psnr));
+        file.write(header, sizeof(header));
+        file.write(reinterpret_cast<const char*>(img.blocks.data()),
+                   std::streamsize(img.blocks.size()));
+        if (!file)
+            throw std::runtime_error("Failed to write " + tmp_path + ".");
+    }
+    std::filesystem::rename(tmp_path, path);
+}
+
+std::optional<Etc2Image> read_etc2_file(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    char header[HEADER_SIZE];
+    uint32_t fields[3];
+    if (!file.read(header, sizeof(header))
+        || memcmp(header, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+    {
+        return {};
+    }
+
+    memcpy(fields, header + 4, sizeof(fields));
+    if (fields[0] != FILE_VERSION)
+        return {};
+
+    Etc2Image img;
+    img.width = fields[1];
+    img.height = fields[2];
+    memcpy(&img.psnr, header + 16, sizeof(img.psnr));
+    img.blocks.resize(((img.width + 3) / 4) * ((img.height + 3) / 4) * 8);
+    if (!file.read(reinterpret_cast<char*>(img.blocks.data()),
+                   std::streamsize(img.blocks.size())))
+    {
+        return {};
+    }
+    return img;
+}
+
+Etc2Image get_etc2_image(const Yimage::Image& img,
+                         const std::string& cache_dir)
+{
+    std::filesystem::path cache_path;
+    if (!cache_dir.empty())
+    {
+        cache_path = std::filesystem::path(cache_dir) / get_cache_file_name(img);
+        if (auto cached = read_etc2_file(cache_path.string()))
+            return std::move(*cached);
+    }
+
+    auto result = encode_etc2(img);
+    if (!cache_dir.empty())
+    {
+        // Decoding the whole image again is only worth it when the
+        // result is kept.
+        result.psnr = calc_psnr(img, decode_etc2(result));
+        std::filesystem::create_directories(cache_dir);
+        write_etc2_file(cache_path.string(), result);
+    }
+    return result;
+}
@@ -0,0 +1,51 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <Yimage/Yimage.hpp>
+
+// An image in the GL_COMPRESSED_RGB8_ETC2 format. Every 4x4 block of
+// pixels is stored as 8 bytes, blocks are stored row by row.
+struct Etc2Image
+{
+    size_t width = 0;
+    size_t height = 0;
+    std::vector<uint8_t> blocks;
+    // The PSNR relative to the original image, 0 if unknown.
+    double psnr = 0;
+};
+
+// Encodes an 8-bit image as ETC2 RGB8. Only the individual, differential
+// and planar modes are used. Alpha channels are ignored.
+[[nodiscard]]
+Etc2Image encode_etc2(const Yimage::Image& img, unsigned thread_count = 0);
+
+// Decodes an ETC2 RGB8 image produced by encode_etc2.
+[[nodiscard]]
+Yimage::Image decode_etc2(const Etc2Image& img);
+
+// Returns the peak signal-to-noise ratio in dB between the RGB channels
+// of two images of the same size.
+[[nodiscard]]
+double calc_psnr(const Yimage::Image& a, const Yimage::Image& b);
+
+void write_etc2_file(const std::string& path, const Etc2Image& img);
+
+[[nodiscard]]
+std::optional<Etc2Image> read_etc2_file(const std::string& path);
+
+// Returns the ETC2 version of img from cache_dir if it is there,
+// otherwise encodes it, calculates its PSNR and stores the result in
+// cache_dir. The cache is not used if cache_dir is empty, and the PSNR
+// is then left at 0.
+[[nodiscard]]
+Etc2Image get_etc2_image(const Yimage::Image& img,
+                         const std::string& cache_dir);
@@ -0,0 +1,193 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "HalfFloatImage.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "Parallel.hpp"
+#include "PixelKernels.hpp"
+
+namespace
+{
+    // The number of rows each thread converts at a time.
+    constexpr size_t BAND_HEIGHT = 16;
+
+    size_t get_16_bit_channel_count(Yimage::PixelType type)
+    {
+        switch (type)
+        {
+        case Yimage::PixelType::MONO_16:
+            return 1;
+        case Yimage::PixelType::MONO_ALPHA_16:
+            return 2;
+        case Yimage::PixelType::RGB_16:
+            return 3;
+        case Yimage::PixelType::RGBA_16:
+            return 4;
+        default:
+            throw std::runtime_error("Unsupported 16-bit pixel type: "
+                                     + std::to_string(int(type)) + ".");
+        }
+    }
+
+    Yimage::PixelType get_8_bit_pixel_type(size_t channels)
+    {
+        switch (channels)
+        {
+        case 1:
+            return Yimage::PixelType::MONO_8;
+        case 2:
+            return Yimage::PixelType::MONO_ALPHA_8;
+        case 3:
+            return Yimage::PixelType::RGB_8;
+        default:
+            return Yimage::PixelType::RGBA_8;
+        }
+    }
+
+    // Maps every 16-bit sRGB value to linear light.
+    const std::vector<float>& get_linear_table()
+    {
+        static const std::vector<float> table = []
+        {
+            std::vector<float> result(65536);
+            for (size_t i = 0; i < result.size(); ++i)
+            {
+                auto c = double(i) / 65535.0;
+                result[i] = float(c <= 0.04045
+                                  ? c / 12.92
+                                  : std::pow((c + 0.055) / 1.055, 2.4));
+            }
+            return result;
+        }();
+        return table;
+    }
+
+    const uint16_t* get_row(const Yimage::Image& img, size_t y)
+    {
+        return reinterpret_cast<const uint16_t*>(img.data() + y * img.row_size());
+    }
+
+    // Converts img to linear RGB floats, averaging blocks of factor x
+    // factor pixels, and calls store(row, y) with every converted row.
+    template <typename StoreFunc>
+    void convert_to_linear_rows(const Yimage::Image& img, size_t factor,
+                                StoreFunc store, unsigned thread_count)
+    {
+        auto channels = get_16_bit_channel_count(img.pixel_type());
+        const auto& table = get_linear_table();
+        const auto width = img.width() / factor;
+        const auto height = img.height() / factor;
+        const auto scale = 1.0f / float(factor * factor);
+        auto band_count = (height + BAND_HEIGHT - 1) / BAND_HEIGHT;
+        parallel_for(band_count, [&](size_t band)
+        {
+            std::vector<float> row(width * 3);
+            auto end = std::min((band + 1) * BAND_HEIGHT, height);
+            for (auto y = band * BAND_HEIGHT; y < end; ++y)
+            {
+                std::fill(row.begin(), row.end(), 0.0f);
+                for (auto sy = y * factor; sy < (y + 1) * factor; ++sy)
+                {
+                    auto src = get_row(img, sy);
+                    auto dst = row.data();
+                    for (size_t x = 0; x < width; ++x, dst += 3)
+                    {
+                        for (size_t i = 0; i < factor; ++i, src += channels)
+                        {
+                            if (channels < 3)
+                            {
+                                auto v = table[src[0]];
+                                dst[0] += v;
+                                dst[1] += v;
+                                dst[2] += v;
+                            }
+                            else
+                            {
+                                dst[0] += table[src[0]];
+                                dst[1] += table[src[1]];
+                                dst[2] += table[src[2]];
+                            }
+                        }
+                    }
+                }
+                if (factor > 1)
+                {
+                    for (auto& v: row)
+                        v *= scale;
+                }
+                store(row.data(), y);
+            }
+        }, thread_count);
+    }
+}
+
+bool is_16_bit(Yimage::PixelType type)
+{
+    switch (type)
+    {
+    case Yimage::PixelType::MONO_16:
+    case Yimage::PixelType::MONO_ALPHA_16:
+    case Yimage::PixelType::RGB_16:
+    case Yimage::PixelType::RGBA_16:
+        return true;
+    default:
+        return false;
+    }
+}
+
+HalfFloatImage make_half_float_image(const Yimage::Image& img,
+                                     size_t max_size,
+                                     unsigned thread_count)
+{
+    size_t factor = 1;
+    while (img.width() / factor > max_size || img.height() / factor > max_size)
+        ++factor;
+
+    HalfFloatImage result;
+    result.width = img.width() / factor;
+    result.height = img.height() / factor;
+    result.pixels.resize(result.width * result.height * 3);
+    const auto& kernels = get_pixel_kernels();
+    convert_to_linear_rows(img, factor, [&](const float* row, size_t y)
+    {
+        auto count = result.width * 3;
+        kernels.f32_to_f16(row, &result.pixels[y * count], count);
+    }, thread_count);
+    return result;
+}
+
+std::vector<float> make_float_image(const Yimage::Image& img,
+                                    unsigned thread_count)
+{
+    std::vector<float> result(img.width() * img.height() * 3);
+    convert_to_linear_rows(img, 1, [&](const float* row, size_t y)
+    {
+        auto count = img.width() * 3;
+        std::copy(row, row + count, &result[y * count]);
+    }, thread_count);
+    return result;
+}
+
+Yimage::Image convert_to_8_bit(const Yimage::Image& img, unsigned thread_count)
+{
+    auto channels = get_16_bit_channel_count(img.pixel_type());
+    Yimage::Image result(get_8_bit_pixel_type(channels),
+                         img.width(), img.height());
+    auto values_per_row = img.width() * channels;
+    parallel_for(img.height(), [&](size_t y)
+    {
+        auto src = get_row(img, y);
+        auto dst = result.data() + y * result.row_size();
+        for (size_t i = 0; i < values_per_row; ++i)
+            dst[i] = uint8_t((uint32_t(src[i]) * 255 + 32767) / 65535);
+    }, thread_count);
+    return result;
+}
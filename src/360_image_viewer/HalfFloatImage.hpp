@@ -0,0 +1,46 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <Yimage/Yimage.hpp>
+
+// An RGB image with half-float channels in linear light. It is uploaded
+// as a GL_RGB16F texture, which takes half the memory of GL_RGB32F and,
+// unlike it, can be filtered linearly by every OpenGL ES 3 driver.
+struct HalfFloatImage
+{
+    size_t width = 0;
+    size_t height = 0;
+    std::vector<uint16_t> pixels;
+};
+
+[[nodiscard]]
+bool is_16_bit(Yimage::PixelType type);
+
+// Converts a 16-bit sRGB image to linear light and then to half floats
+// with the SIMD pixel kernels. Images wider or taller than max_size are
+// reduced by the smallest integer factor that makes them fit, by
+// averaging blocks of pixels in linear light. Alpha channels are
+// dropped.
+[[nodiscard]]
+HalfFloatImage make_half_float_image(const Yimage::Image& img,
+                                     size_t max_size,
+                                     unsigned thread_count = 0);
+
+// Converts a 16-bit sRGB image to RGB floats in linear light. Only used
+// to measure what make_half_float_image saves.
+[[nodiscard]]
+std::vector<float> make_float_image(const Yimage::Image& img,
+                                    unsigned thread_count = 0);
+
+// Converts a 16-bit image to 8 bits per channel, for drivers that don't
+// support half-float textures.
+[[nodiscard]]
+Yimage::Image convert_to_8_bit(const Yimage::Image& img,
+                               unsigned thread_count = 0);
@@ -6,41 +6,477 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #include "Hud.hpp"
-#include <Yconvert/Yconvert.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
 
 namespace
 {
-    std::u32string to_u32string(const std::string& str)
+    enum HudLine
     {
-        return Yconvert::convert_to<std::u32string>(
-            str,
-            Yconvert::Encoding::UTF_8,
-            Yconvert::Encoding::UTF_32_NATIVE);
+        AZIMUTH_LINE,
+        POLAR_LINE,
+        ZOOM_LINE,
+        FRAME_LINE,
+        LOAD_LINE,
+        TEXTURE_LINE,
+        TRIANGLE_LINE,
+        QUALITY_LINE,
+        MARKER_LINE,
+        HUD_LINE,
+        HUD_LINE_COUNT
+    };
+
+    // The frame-time graph covers this part of the screen, its top is
+    // MAX_FRAME_TIME.
+    constexpr float GRAPH_LEFT = 0.5f;
+    constexpr float GRAPH_RIGHT = 0.98f;
+    constexpr float GRAPH_BOTTOM = -0.98f;
+    constexpr float GRAPH_TOP = -0.7f;
+    constexpr float MAX_FRAME_TIME = 50;
+    constexpr float REFERENCE_FRAME_TIME = 1000.0f / 60;
+
+    constexpr auto STATS_INTERVAL = std::chrono::milliseconds(500);
+
+    constexpr int ATLAS_COLUMNS = 16;
+    // Two triangles with a position and a texture coordinate per vertex.
+    constexpr size_t FLOATS_PER_GLYPH = 6 * 5;
+
+    constexpr size_t FORMAT_SIZE = 64;
+
+    template <typename... Args>
+    std::array<char, FORMAT_SIZE> format(const char* fmt, Args... args)
+    {
+        std::array<char, FORMAT_SIZE> buffer;
+        snprintf(buffer.data(), buffer.size(), fmt, args...);
+        return buffer;
+    }
+
+    float get_graph_y(float frame_time)
+    {
+        auto t = std::min(frame_time, MAX_FRAME_TIME) / MAX_FRAME_TIME;
+        return GRAPH_BOTTOM + t * (GRAPH_TOP - GRAPH_BOTTOM);
     }
 }
 
 Hud::Hud()
-    : renderer_(Tungsten::FontManager::instance().default_font())
-{}
+{
+    static_assert(HUD_LINE_COUNT == LINE_COUNT);
+    static_assert(FORMAT_SIZE <= LINE_SIZE);
+    set_angles(0, 0);
+    set_zoom(0);
+    set_line(FRAME_LINE, "FPS: -");
+    set_line(LOAD_LINE, "Decode: -  Upload: -");
+    set_line(TEXTURE_LINE, "Texture: -");
+    set_line(TRIANGLE_LINE, "Triangles: -");
+    set_line(QUALITY_LINE, "Quality: -");
+    set_line(MARKER_LINE, "Marker: -");
+    set_line(HUD_LINE, "HUD: -");
+}
+
+Hud::~Hud()
+{
+    if (is_setup_)
+    {
+        glDeleteFramebuffers(1, &framebuffer_);
+        glDeleteTextures(1, &text_texture_);
+        glDeleteTextures(1, &glyph_texture_);
+    }
+}
 
 void Hud::set_angles(double azimuth, double polar)
 {
-    azimuth_ = azimuth;
-    polar_ = polar;
+    set_line(AZIMUTH_LINE, format("Azimuth: %.2f", azimuth).data());
+    set_line(POLAR_LINE, format("Polar: %.2f", polar).data());
 }
 
 void Hud::set_zoom(int zoom)
 {
-    zoom_ = zoom;
+    set_line(ZOOM_LINE, format("Zoom: %d", zoom).data());
+}
+
+void Hud::set_load_times(double decode_ms, double upload_ms,
+                         int upload_frames)
+{
+    if (upload_frames > 1)
+    {
+        set_line(LOAD_LINE, format("Decode: %.1f ms  Upload: %.1f ms in %d frames",
+                                   decode_ms, upload_ms, upload_frames).data());
+        return;
+    }
+    set_line(LOAD_LINE, format("Decode: %.1f ms  Upload: %.1f ms",
+                               decode_ms, upload_ms).data());
+}
+
+void Hud::set_texture_memory(size_t bytes)
+{
+    set_line(TEXTURE_LINE, format("Texture: %.1f MB",
+                                  double(bytes) / (1024.0 * 1024.0)).data());
+}
+
+void Hud::set_triangle_count(size_t count)
+{
+    set_line(TRIANGLE_LINE, format("Triangles: %zu", count).data());
+}
+
+void Hud::set_quality(size_t level, const QualityLevel& quality)
+{
+    set_line(QUALITY_LINE, format("Quality: %zu  Mesh: %dx%d  Bias: %.1f  Scale: %.0f%%",
+                                  level, quality.circles, quality.points,
+                                  double(quality.mip_bias),
+                                  double(quality.render_scale) * 100).data());
+}
+
+void Hud::set_marker(std::optional<size_t> index)
+{
+    if (index)
+        set_line(MARKER_LINE, format("Marker: %zu", *index).data());
+    else
+        set_line(MARKER_LINE, "Marker: -");
+}
+
+void Hud::add_frame(Clock::time_point time)
+{
+    using namespace std::chrono;
+    if (prev_frame_ != Clock::time_point())
+    {
+        auto ms = duration<double, std::milli>(time - prev_frame_).count();
+        frame_times_[frame_index_] = float(ms);
+        frame_index_ = (frame_index_ + 1) % GRAPH_SIZE;
+        frame_count_ = std::min(frame_count_ + 1, GRAPH_SIZE);
+        stats_frame_time_ += ms;
+        ++stats_frames_;
+        is_graph_changed_ = true;
+    }
+    prev_frame_ = time;
+
+    if (stats_time_ == Clock::time_point())
+        stats_time_ = time;
+    else if (time - stats_time_ >= STATS_INTERVAL)
+        update_frame_stats(time);
 }
 
 void Hud::draw(const Xyz::Vector2F& screen_size)
 {
     if (!visible)
         return;
-    auto text = "Azimuth: " + std::to_string(azimuth_) + "\n"
-                "Polar: " + std::to_string(polar_) + "\n"
-                "Zoom: " + std::to_string(zoom_);
-    renderer_.draw(to_u32string(text), {-1, -1}, screen_size,
-                   {.color = Yimage::Color::White});
+
+    auto start = Clock::now();
+    if (!is_setup_)
+        setup();
+
+    // The text texture covers the lower left quarter of the viewport.
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    auto width = std::max(viewport[2] / 2, 1);
+    auto height = std::max(viewport[3] / 2, 1);
+    if (is_text_changed_ || width != text_width_ || height != text_height_)
+    {
+        render_text(screen_size, width, height);
+        is_text_changed_ = false;
+    }
+
+    draw_text_texture();
+    draw_graph();
+
+    using namespace std::chrono;
+    auto ms = duration<double, std::milli>(Clock::now() - start).count();
+    draw_time_ = draw_time_ == 0 ? ms : 0.9 * draw_time_ + 0.1 * ms;
+}
+
+void Hud::set_line(size_t index, const char* line)
+{
+    auto& buffer = lines_[index];
+    if (strncmp(buffer, line, LINE_SIZE - 1) != 0)
+    {
+        strncpy(buffer, line, LINE_SIZE - 1);
+        is_text_changed_ = true;
+    }
+}
+
+void Hud::update_frame_stats(Clock::time_point now)
+{
+    using namespace std::chrono;
+    auto secs = duration<double>(now - stats_time_).count();
+    if (stats_frames_ != 0)
+    {
+        set_line(FRAME_LINE, format("FPS: %.0f  Frame: %.1f ms",
+                                    double(stats_frames_) / secs,
+                                    stats_frame_time_ / double(stats_frames_)).data());
+    }
+    if (draw_time_ != 0)
+        set_line(HUD_LINE, format("HUD: %.3f ms", draw_time_).data());
+    stats_time_ = now;
+    stats_frames_ = 0;
+    stats_frame_time_ = 0;
+}
+
+void Hud::setup()
+{
+    glGenFramebuffers(1, &framebuffer_);
+    create_glyph_atlas();
+
+    glGenTextures(1, &text_texture_);
+    glBindTexture(GL_TEXTURE_2D, text_texture_);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    float quad[] = {-1, -1, 0, 0, 0,
+                    0, -1, 0, 1, 0,
+                    -1, 0, 0, 0, 1,
+                    0, 0, 0, 1, 1};
+    quad_array_ = Tungsten::generate_vertex_array();
+    Tungsten::bind_vertex_array(quad_array_);
+    quad_buffer_ = Tungsten::generate_buffer();
+    Tungsten::bind_buffer(GL_ARRAY_BUFFER, quad_buffer_);
+    Tungsten::set_buffer_data(GL_ARRAY_BUFFER, sizeof(quad), quad,
+                              GL_STATIC_DRAW);
+    quad_program_.setup();
+    Tungsten::use_program(quad_program_.program);
+    quad_program_.mv_matrix.set(Xyz::make_identity_matrix<float, 4>());
+    quad_program_.p_matrix.set(Xyz::make_identity_matrix<float, 4>());
+    quad_program_.texture.set(0);
+    quad_program_.texture_transform.set({1, 0});
+    Tungsten::define_vertex_attribute_float_pointer(
+        quad_program_.position, 3, 5 * sizeof(float), 0);
+    Tungsten::enable_vertex_attribute(quad_program_.position);
+    Tungsten::define_vertex_attribute_float_pointer(
+        quad_program_.texture_coord, 2, 5 * sizeof(float), 3 * sizeof(float));
+    Tungsten::enable_vertex_attribute(quad_program_.texture_coord);
+
+    // Room for every character of every line.
+    glyph_vertices_.reserve(LINE_COUNT * LINE_SIZE * FLOATS_PER_GLYPH);
+    glyph_array_ = Tungsten::generate_vertex_array();
+    Tungsten::bind_vertex_array(glyph_array_);
+    glyph_buffer_ = Tungsten::generate_buffer();
+    Tungsten::bind_buffer(GL_ARRAY_BUFFER, glyph_buffer_);
+    Tungsten::set_buffer_data(GL_ARRAY_BUFFER,
+                              GLsizeiptr(glyph_vertices_.capacity() * sizeof(float)),
+                              nullptr, GL_DYNAMIC_DRAW);
+    Tungsten::define_vertex_attribute_float_pointer(
+        quad_program_.position, 3, 5 * sizeof(float), 0);
+    Tungsten::enable_vertex_attribute(quad_program_.position);
+    Tungsten::define_vertex_attribute_float_pointer(
+        quad_program_.texture_coord, 2, 5 * sizeof(float), 3 * sizeof(float));
+    Tungsten::enable_vertex_attribute(quad_program_.texture_coord);
+
+    // A reference line at 60 FPS followed by the graph itself.
+    graph_array_ = Tungsten::generate_vertex_array();
+    Tungsten::bind_vertex_array(graph_array_);
+    graph_buffer_ = Tungsten::generate_buffer();
+    Tungsten::bind_buffer(GL_ARRAY_BUFFER, graph_buffer_);
+    Tungsten::set_buffer_data(GL_ARRAY_BUFFER,
+                              (2 + GRAPH_SIZE) * 3 * sizeof(float),
+                              nullptr, GL_DYNAMIC_DRAW);
+    graph_program_.setup();
+    Tungsten::use_program(graph_program_.program);
+    graph_program_.mv_matrix.set(Xyz::make_identity_matrix<float, 4>());
+    graph_program_.p_matrix.set(Xyz::make_identity_matrix<float, 4>());
+    Tungsten::define_vertex_attribute_float_pointer(
+        graph_program_.position, 3, 3 * sizeof(float), 0);
+    Tungsten::enable_vertex_attribute(graph_program_.position);
+
+    is_setup_ = true;
+}
+
+void Hud::create_glyph_atlas()
+{
+    Tungsten::TextRenderer renderer(
+        Tungsten::FontManager::instance().default_font());
+    float max_width = 0;
+    for (size_t i = 0; i < GLYPH_COUNT; ++i)
+    {
+        std::u32string text(1, char32_t(FIRST_GLYPH + i));
+        auto size = renderer.get_size(text);
+        glyphs_[i].width = size[0];
+        max_width = std::max(max_width, size[0]);
+        line_height_ = std::max(line_height_, size[1]);
+    }
+
+    // An empty pixel between the cells keeps linear filtering from
+    // picking up the neighboring glyphs.
+    auto cell_width = int(std::ceil(max_width)) + 1;
+    auto cell_height = int(std::ceil(line_height_)) + 1;
+    auto rows = (int(GLYPH_COUNT) + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+    auto width = ATLAS_COLUMNS * cell_width;
+    auto height = rows * cell_height;
+
+    glGenTextures(1, &glyph_texture_);
+    glBindTexture(GL_TEXTURE_2D, glyph_texture_);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    GLint prev_framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prev_framebuffer);
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_2D, glyph_texture_, 0);
+    glViewport(0, 0, width, height);
+    glClearColor(0, 0, 0, 0);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    auto atlas_width = float(width), atlas_height = float(height);
+    for (size_t i = 0; i < GLYPH_COUNT; ++i)
+    {
+        auto x = float(int(i) % ATLAS_COLUMNS * cell_width);
+        auto y = float(int(i) / ATLAS_COLUMNS * cell_height);
+        std::u32string text(1, char32_t(FIRST_GLYPH + i));
+        renderer.draw(text,
+                      Xyz::Vector2F(2 * x / atlas_width - 1,
+                                    2 * y / atlas_height - 1),
+                      Xyz::Vector2F(atlas_width, atlas_height),
+                      {.color = Yimage::Color::White});
+        auto& glyph = glyphs_[i];
+        glyph.tex_min = Xyz::Vector2F(x / atlas_width, y / atlas_height);
+        glyph.tex_max = Xyz::Vector2F((x + glyph.width) / atlas_width,
+                                      (y + line_height_) / atlas_height);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, GLuint(prev_framebuffer));
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void Hud::render_text(const Xyz::Vector2F& screen_size,
+                      int width, int height)
+{
+    // The texture covers half the screen in each direction, the text
+    // keeps its size by getting the scale of half the screen size.
+    Xyz::Vector2F scale(4 / screen_size[0], 4 / screen_size[1]);
+    auto line_height = line_height_ * scale[1];
+    glyph_vertices_.clear();
+    for (size_t i = 0; i < LINE_COUNT; ++i)
+    {
+        // The last line is at the bottom of the texture.
+        auto y0 = -1 + float(LINE_COUNT - 1 - i) * line_height;
+        auto y1 = y0 + line_height;
+        auto x0 = -1.0f;
+        for (auto c = lines_[i]; *c; ++c)
+        {
+            if (*c < FIRST_GLYPH || *c > LAST_GLYPH)
+                continue;
+            const auto& glyph = glyphs_[*c - FIRST_GLYPH];
+            auto x1 = x0 + glyph.width * scale[0];
+            if (*c != ' ')
+            {
+                const auto& t0 = glyph.tex_min;
+                const auto& t1 = glyph.tex_max;
+                const float vertices[FLOATS_PER_GLYPH] = {
+                    x0, y0, 0, t0[0], t0[1],
+                    x1, y0, 0, t1[0], t0[1],
+                    x0, y1, 0, t0[0], t1[1],
+                    x0, y1, 0, t0[0], t1[1],
+                    x1, y0, 0, t1[0], t0[1],
+                    x1, y1, 0, t1[0], t1[1]
+                };
+                glyph_vertices_.insert(glyph_vertices_.end(),
+                                       std::begin(vertices),
+                                       std::end(vertices));
+            }
+            x0 = x1;
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, text_texture_);
+    if (width != text_width_ || height != text_height_)
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        text_width_ = width;
+        text_height_ = height;
+    }
+
+    GLint prev_framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prev_framebuffer);
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_2D, text_texture_, 0);
+    glViewport(0, 0, width, height);
+    glClearColor(0, 0, 0, 0);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    Tungsten::bind_vertex_array(glyph_array_);
+    Tungsten::bind_buffer(GL_ARRAY_BUFFER, glyph_buffer_);
+    glBufferSubData(GL_ARRAY_BUFFER, 0,
+                    GLsizeiptr(glyph_vertices_.size() * sizeof(float)),
+                    glyph_vertices_.data());
+    Tungsten::use_program(quad_program_.program);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, glyph_texture_);
+    // The glyphs were blended into a transparent texture, just like the
+    // text texture.
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glDrawArrays(GL_TRIANGLES, 0,
+                 GLsizei(glyph_vertices_.size() / (FLOATS_PER_GLYPH / 6)));
+    glDisable(GL_BLEND);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, GLuint(prev_framebuffer));
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void Hud::draw_text_texture()
+{
+    Tungsten::bind_vertex_array(quad_array_);
+    Tungsten::use_program(quad_program_.program);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, text_texture_);
+    // The text was blended into a transparent texture, its colors are
+    // therefore premultiplied with alpha.
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glDisable(GL_BLEND);
+}
+
+void Hud::draw_graph()
+{
+    if (frame_count_ < 2)
+        return;
+
+    Tungsten::bind_vertex_array(graph_array_);
+    if (is_graph_changed_)
+    {
+        float vertices[(2 + GRAPH_SIZE) * 3] = {};
+        auto ref_y = get_graph_y(REFERENCE_FRAME_TIME);
+        float reference[] = {GRAPH_LEFT, ref_y, 0, GRAPH_RIGHT, ref_y, 0};
+        std::copy(std::begin(reference), std::end(reference), vertices);
+
+        // The oldest frame is to the left, the newest to the right.
+        auto first = (frame_index_ + GRAPH_SIZE - frame_count_) % GRAPH_SIZE;
+        auto step = (GRAPH_RIGHT - GRAPH_LEFT) / float(GRAPH_SIZE - 1);
+        auto offset = GRAPH_SIZE - frame_count_;
+        for (size_t i = 0; i < frame_count_; ++i)
+        {
+            auto v = &vertices[(2 + i) * 3];
+            v[0] = GRAPH_LEFT + float(offset + i) * step;
+            v[1] = get_graph_y(frame_times_[(first + i) % GRAPH_SIZE]);
+        }
+
+        Tungsten::bind_buffer(GL_ARRAY_BUFFER, graph_buffer_);
+        glBufferSubData(GL_ARRAY_BUFFER, 0,
+                        GLsizeiptr((2 + frame_count_) * 3 * sizeof(float)),
+                        vertices);
+        is_graph_changed_ = false;
+    }
+
+    Tungsten::use_program(graph_program_.program);
+    graph_program_.color.set({0.5f, 0.5f, 0.5f, 1.f});
+    glDrawArrays(GL_LINES, 0, 2);
+    graph_program_.color.set({0.f, 1.f, 0.f, 1.f});
+    glDrawArrays(GL_LINE_STRIP, 2, GLsizei(frame_count_));
 }
@@ -6,23 +6,124 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <chrono>
+#include <optional>
+#include <vector>
 #include <Tungsten/Tungsten.hpp>
+#include "QualityGovernor.hpp"
+#include "Render3DShaderProgram.hpp"
+#include "Unicolor3DShaderProgram.hpp"
 
+// Shows the view direction and a performance overlay with a frame-time
+// graph, frame rate, load times, texture memory and triangle count.
+//
+// The text is rendered to a texture that is only redrawn when the text
+// changes, other frames just draw the texture. The frame statistics are
+// updated twice per second to keep the text from changing every frame.
+//
+// Tungsten's text renderer allocates memory every time it draws, so it
+// is only used to draw the printable ASCII characters into a glyph atlas
+// the first time the HUD is drawn while visible. After that the lines
+// are laid out as quads from the atlas in a vertex buffer whose capacity
+// is reserved up front, and neither updating nor redrawing the text
+// allocates memory.
 class Hud
 {
 public:
+    using Clock = std::chrono::steady_clock;
+
     Hud();
 
+    ~Hud();
+
+    Hud(const Hud&) = delete;
+
+    Hud& operator=(const Hud&) = delete;
+
     void set_angles(double azimuth, double polar);
 
     void set_zoom(int zoom);
 
+    // upload_frames is the number of frames the upload was spread over.
+    void set_load_times(double decode_ms, double upload_ms,
+                        int upload_frames = 1);
+
+    void set_texture_memory(size_t bytes);
+
+    void set_triangle_count(size_t count);
+
+    // Shows the quality level chosen by the quality governor.
+    void set_quality(size_t level, const QualityLevel& quality);
+
+    // Shows the index of the marker under the mouse cursor.
+    void set_marker(std::optional<size_t> index);
+
+    // Registers that a frame was drawn at time.
+    void add_frame(Clock::time_point time);
+
     void draw(const Xyz::Vector2F& screen_size);
 
     bool visible = false;
 private:
-    Tungsten::TextRenderer renderer_;
-    double azimuth_ = {};
-    double polar_ = {};
-    int zoom_ = {};
+    static constexpr size_t GRAPH_SIZE = 120;
+    static constexpr size_t LINE_COUNT = 10;
+    static constexpr size_t LINE_SIZE = 64;
+    static constexpr char FIRST_GLYPH = ' ';
+    static constexpr char LAST_GLYPH = '~';
+    static constexpr size_t GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+
+    // A character's rectangle in the glyph atlas, and its width in
+    // pixels. All characters are as tall as a line.
+    struct Glyph
+    {
+        Xyz::Vector2F tex_min;
+        Xyz::Vector2F tex_max;
+        float width = 0;
+    };
+
+    void set_line(size_t index, const char* line);
+
+    void update_frame_stats(Clock::time_point now);
+
+    void setup();
+
+    void create_glyph_atlas();
+
+    void render_text(const Xyz::Vector2F& screen_size, int width, int height);
+
+    void draw_text_texture();
+
+    void draw_graph();
+
+    char lines_[LINE_COUNT][LINE_SIZE] = {};
+    bool is_text_changed_ = true;
+
+    // The frame intervals in milliseconds, in a ring buffer.
+    float frame_times_[GRAPH_SIZE] = {};
+    size_t frame_index_ = 0;
+    size_t frame_count_ = 0;
+    Clock::time_point prev_frame_ = {};
+    Clock::time_point stats_time_ = {};
+    size_t stats_frames_ = 0;
+    double stats_frame_time_ = 0;
+    double draw_time_ = 0;
+    bool is_graph_changed_ = true;
+
+    bool is_setup_ = false;
+    GLuint framebuffer_ = 0;
+    GLuint text_texture_ = 0;
+    int text_width_ = 0;
+    int text_height_ = 0;
+    GLuint glyph_texture_ = 0;
+    Glyph glyphs_[GLYPH_COUNT] = {};
+    float line_height_ = 0;
+    std::vector<float> glyph_vertices_;
+    Tungsten::BufferHandle glyph_buffer_;
+    Tungsten::VertexArrayHandle glyph_array_;
+    Tungsten::BufferHandle quad_buffer_;
+    Tungsten::VertexArrayHandle quad_array_;
+    Render3DShaderProgram quad_program_;
+    Tungsten::BufferHandle graph_buffer_;
+    Tungsten::VertexArrayHandle graph_array_;
+    Unicolor3DShaderProgram graph_program_;
 };
@@ -0,0 +1,174 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ImageLoader.hpp"
+
+#include <fstream>
+#include <istream>
+#include <streambuf>
+#include <vector>
+#include "JpegDecoder.hpp"
+
+namespace
+{
+    // A read-only stream buffer for memory that is owned by someone else.
+    class MemoryBuffer : public std::streambuf
+    {
+    public:
+        MemoryBuffer(const void* data, size_t size)
+        {
+            auto begin = const_cast<char*>(static_cast<const char*>(data));
+            setg(begin, begin, begin + size);
+        }
+    protected:
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                         std::ios_base::openmode) override
+        {
+            auto pos = dir == std::ios_base::beg ? eback()
+                       : dir == std::ios_base::cur ? gptr()
+                       : egptr();
+            pos += off;
+            if (pos < eback() || pos > egptr())
+                return pos_type(off_type(-1));
+            setg(eback(), pos, egptr());
+            return pos_type(pos - eback());
+        }
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode mode) override
+        {
+            return seekoff(off_type(pos), std::ios_base::beg, mode);
+        }
+    };
+}
+
+std::vector<char> read_file_if_jpeg(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return {};
+
+    auto size = size_t(file.tellg());
+    char signature[3];
+    file.seekg(0);
+    if (!file.read(signature, sizeof(signature))
+        || !is_jpeg(signature, sizeof(signature)))
+    {
+        return {};
+    }
+
+    std::vector<char> result(size);
+    file.seekg(0);
+    if (!file.read(result.data(), std::streamsize(size)))
+        return {};
+    return result;
+}
+
+Yimage::Image read_image_file(const std::string& path, unsigned thread_count)
+{
+    auto data = read_file_if_jpeg(path);
+    if (!data.empty())
+    {
+        auto img = read_jpeg_parallel(data.data(), data.size(), thread_count);
+        if (img)
+            return img;
+    }
+    return Yimage::read_image(path);
+}
+
+Yimage::Image read_image_data(const void* data, size_t size,
+                              unsigned thread_count)
+{
+    if (is_jpeg(data, size))
+    {
+        auto img = read_jpeg_parallel(data, size, thread_count);
+        if (img)
+            return img;
+    }
+
+    MemoryBuffer buffer(data, size);
+    std::istream stream(&buffer);
+    return Yimage::read_image(stream);
+}
+
+StreamingImageReader::StreamingImageReader() = default;
+
+StreamingImageReader::~StreamingImageReader() = default;
+
+void StreamingImageReader::add_data(const void* data, size_t size)
+{
+    if (!is_streaming_ || !jpeg_decoder_ || jpeg_decoder_->image().height() == 0)
+    {
+        auto bytes = static_cast<const char*>(data);
+        data_.insert(data_.end(), bytes, bytes + size);
+    }
+
+    if (!is_streaming_)
+        return;
+
+    if (!jpeg_decoder_)
+    {
+        // The first chunk can be very small.
+        if (data_.size() < 3)
+            return;
+        if (!is_jpeg(data_.data(), data_.size()))
+        {
+            is_streaming_ = false;
+            return;
+        }
+        jpeg_decoder_ = std::make_unique<JpegStreamDecoder>();
+        data = data_.data();
+        size = data_.size();
+    }
+
+    if (!jpeg_decoder_->add_data(data, size))
+    {
+        jpeg_decoder_.reset();
+        is_streaming_ = false;
+        return;
+    }
+
+    // The file is no longer needed once the decoder has accepted its
+    // header.
+    if (jpeg_decoder_->image().height() != 0 && !data_.empty())
+        data_ = {};
+}
+
+void StreamingImageReader::finish()
+{
+    if (jpeg_decoder_)
+    {
+        jpeg_decoder_->finish();
+        image_ = jpeg_decoder_->release_image();
+        jpeg_decoder_.reset();
+    }
+    else if (!data_.empty())
+    {
+        image_ = read_image_data(data_.data(), data_.size());
+        data_ = {};
+    }
+    is_streaming_ = false;
+}
+
+const Yimage::Image& StreamingImageReader::image() const
+{
+    return jpeg_decoder_ ? jpeg_decoder_->image() : image_;
+}
+
+size_t StreamingImageReader::row_count() const
+{
+    return jpeg_decoder_ ? jpeg_decoder_->row_count() : image_.height();
+}
+
+Yimage::Image StreamingImageReader::release_image()
+{
+    auto img = std::move(image_);
+    jpeg_decoder_.reset();
+    data_ = {};
+    image_ = {};
+    is_streaming_ = true;
+    return img;
+}
@@ -0,0 +1,64 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <Yimage/Yimage.hpp>
+
+// Returns the contents of the file at path if it is a JPEG file,
+// otherwise an empty vector.
+[[nodiscard]]
+std::vector<char> read_file_if_jpeg(const std::string& path);
+
+// Reads a PNG or JPEG file. JPEGs with suitable restart markers are
+// decoded in parallel, everything else is handed to Yimage::read_image.
+[[nodiscard]]
+Yimage::Image read_image_file(const std::string& path,
+                              unsigned thread_count = 0);
+
+// Reads a PNG or JPEG image from memory without copying it.
+[[nodiscard]]
+Yimage::Image read_image_data(const void* data, size_t size,
+                              unsigned thread_count = 0);
+
+class JpegStreamDecoder;
+
+// Reads an image file that arrives in chunks. JPEGs are decoded as the
+// data arrives, other files when all of it has arrived.
+class StreamingImageReader
+{
+public:
+    StreamingImageReader();
+
+    ~StreamingImageReader();
+
+    void add_data(const void* data, size_t size);
+
+    // Decodes whatever remains of the image.
+    void finish();
+
+    // Empty until the size of the image is known.
+    [[nodiscard]]
+    const Yimage::Image& image() const;
+
+    // Returns the number of rows at the top of image() that have been
+    // decoded.
+    [[nodiscard]]
+    size_t row_count() const;
+
+    // Returns the image and resets the reader.
+    [[nodiscard]]
+    Yimage::Image release_image();
+private:
+    std::unique_ptr<JpegStreamDecoder> jpeg_decoder_;
+    // Holds the file until it is known whether it can be streamed.
+    std::vector<char> data_;
+    Yimage::Image image_;
+    bool is_streaming_ = true;
+};
@@ -0,0 +1,287 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ImageResampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "ImageUtilities.hpp"
+#include "Parallel.hpp"
+#include "PixelKernels.hpp"
+
+namespace
+{
+    constexpr double LANCZOS_RADIUS = 3;
+    constexpr size_t CHUNKS_PER_THREAD = 4;
+
+    [[nodiscard]]
+    double sinc(double x)
+    {
+        constexpr double PI = 3.14159265358979323846;
+        if (x == 0)
+            return 1;
+        return std::sin(PI * x) / (PI * x);
+    }
+
+    [[nodiscard]]
+    double lanczos3(double x)
+    {
+        if (std::abs(x) >= LANCZOS_RADIUS)
+            return 0;
+        return sinc(x) * sinc(x / LANCZOS_RADIUS);
+    }
+
+    // All destination pixels get the same number of taps to keep the
+    // inner loops simple, the unused ones have weight 0.
+    struct FilterWeights
+    {
+        size_t taps = 0;
+        std::vector<ptrdiff_t> first_index;
+        std::vector<float> weights;
+    };
+
+    [[nodiscard]]
+    FilterWeights make_filter_weights(size_t src_size, size_t dst_size)
+    {
+        auto scale = double(src_size) / double(dst_size);
+        auto kernel_scale = std::max(scale, 1.0);
+        auto support = LANCZOS_RADIUS * kernel_scale;
+
+        FilterWeights result;
+        result.taps = size_t(std::ceil(2 * support)) + 1;
+        result.first_index.resize(dst_size);
+        result.weights.resize(dst_size * result.taps);
+
+        for (size_t i = 0; i < dst_size; ++i)
+        {
+            auto center = (double(i) + 0.5) * scale;
+            auto first = ptrdiff_t(std::ceil(center - support - 0.5));
+            result.first_index[i] = first;
+
+            auto weights = &result.weights[i * result.taps];
+            double sum = 0;
+            for (size_t t = 0; t < result.taps; ++t)
+            {
+                auto dist = double(first) + double(t) + 0.5 - center;
+                auto w = lanczos3(dist / kernel_scale);
+                weights[t] = float(w);
+                sum += w;
+            }
+            for (size_t t = 0; t < result.taps; ++t)
+                weights[t] = float(weights[t] / sum);
+        }
+        return result;
+    }
+
+    struct ResampleJob
+    {
+        const unsigned char* src;
+        unsigned char* dst;
+        size_t channels;
+        size_t src_width;
+        size_t src_height;
+        size_t dst_width;
+        size_t dst_height;
+        FilterWeights h_filter;
+        FilterWeights v_filter;
+        // Number of wrapped-around pixels needed on each side of a
+        // source row.
+        size_t left_pad;
+        size_t right_pad;
+        const PixelKernels* kernels;
+    };
+
+    template <size_t N>
+    void filter_row(const float* src, const FilterWeights& filter,
+                    size_t left_pad, float* dst, size_t dst_width)
+    {
+        for (size_t x = 0; x < dst_width; ++x)
+        {
+            float sum[N] = {};
+            auto w = &filter.weights[x * filter.taps];
+            auto s = src + (filter.first_index[x] + ptrdiff_t(left_pad)) * N;
+            for (size_t t = 0; t < filter.taps; ++t)
+            {
+                for (size_t c = 0; c < N; ++c)
+                    sum[c] += w[t] * s[t * N + c];
+            }
+            for (size_t c = 0; c < N; ++c)
+                dst[x * N + c] = sum[c];
+        }
+    }
+
+    void filter_source_row(const ResampleJob& job, size_t row,
+                           std::vector<float>& buffer, float* dst)
+    {
+        auto n = job.channels;
+        auto src = job.src + row * job.src_width * n;
+        job.kernels->u8_to_f32(src, &buffer[job.left_pad * n],
+                               job.src_width * n);
+
+        // The padding can be wider than the image itself.
+        auto copy_pixel = [&](size_t x)
+        {
+            auto src_x = (x + job.src_width - job.left_pad % job.src_width)
+                         % job.src_width;
+            for (size_t c = 0; c < n; ++c)
+                buffer[x * n + c] = float(src[src_x * n + c]);
+        };
+        auto padded_width = job.left_pad + job.src_width + job.right_pad;
+        for (size_t x = 0; x < job.left_pad; ++x)
+            copy_pixel(x);
+        for (size_t x = job.left_pad + job.src_width; x < padded_width; ++x)
+            copy_pixel(x);
+
+        switch (n)
+        {
+        case 1:
+            filter_row<1>(buffer.data(), job.h_filter, job.left_pad, dst, job.dst_width);
+            break;
+        case 2:
+            filter_row<2>(buffer.data(), job.h_filter, job.left_pad, dst, job.dst_width);
+            break;
+        case 3:
+            filter_row<3>(buffer.data(), job.h_filter, job.left_pad, dst, job.dst_width);
+            break;
+        default:
+            filter_row<4>(buffer.data(), job.h_filter, job.left_pad, dst, job.dst_width);
+            break;
+        }
+    }
+
+    // Produces destination rows [y_begin, y_end). The horizontally filtered
+    // source rows are kept in a ring buffer with room for exactly the rows
+    // needed by one destination row.
+    void resample_rows(const ResampleJob& job, size_t y_begin, size_t y_end)
+    {
+        auto taps = job.v_filter.taps;
+        auto row_length = job.dst_width * job.channels;
+        std::vector<float> ring(taps * row_length);
+        std::vector<float> src_buffer(
+            (job.left_pad + job.src_width + job.right_pad) * job.channels);
+        std::vector<float> sums(row_length);
+
+        auto get_ring_row = [&](ptrdiff_t index)
+        {
+            auto slot = size_t((index % ptrdiff_t(taps) + ptrdiff_t(taps))
+                               % ptrdiff_t(taps));
+            return &ring[slot * row_length];
+        };
+
+        auto next_index = job.v_filter.first_index[y_begin];
+        for (auto y = y_begin; y < y_end; ++y)
+        {
+            auto first = job.v_filter.first_index[y];
+            next_index = std::max(next_index, first);
+            for (; next_index < first + ptrdiff_t(taps); ++next_index)
+            {
+                auto row = std::clamp<ptrdiff_t>(next_index, 0,
+                                                 ptrdiff_t(job.src_height) - 1);
+                filter_source_row(job, size_t(row), src_buffer,
+                                  get_ring_row(next_index));
+            }
+
+            std::fill(sums.begin(), sums.end(), 0.0f);
+            auto weights = &job.v_filter.weights[y * taps];
+            for (size_t t = 0; t < taps; ++t)
+            {
+                auto w = weights[t];
+                if (w == 0)
+                    continue;
+                job.kernels->multiply_add(get_ring_row(first + ptrdiff_t(t)),
+                                          w, sums.data(), row_length);
+            }
+
+            job.kernels->f32_to_u8(sums.data(), job.dst + y * row_length,
+                                   row_length);
+        }
+    }
+
+    [[nodiscard]]
+    ResampleJob make_job(const Yimage::Image& img, unsigned char* dst,
+                         size_t width, size_t height)
+    {
+        ResampleJob job{
+            .src = img.data(),
+            .dst = dst,
+            .channels = get_channel_count(img.pixel_type()),
+            .src_width = img.width(),
+            .src_height = img.height(),
+            .dst_width = width,
+            .dst_height = height,
+            .h_filter = make_filter_weights(img.width(), width),
+            .v_filter = make_filter_weights(img.height(), height),
+            .left_pad = 0,
+            .right_pad = 0,
+            .kernels = &get_pixel_kernels()
+        };
+
+        for (size_t x = 0; x < width; ++x)
+        {
+            auto first = job.h_filter.first_index[x];
+            auto end = first + ptrdiff_t(job.h_filter.taps);
+            job.left_pad = std::max(job.left_pad,
+                                    size_t(std::max<ptrdiff_t>(-first, 0)));
+            job.right_pad = std::max(job.right_pad,
+                                     size_t(std::max<ptrdiff_t>(end - ptrdiff_t(img.width()), 0)));
+        }
+        return job;
+    }
+}
+
+Yimage::Image resize_image(const Yimage::Image& img,
+                           size_t width, size_t height,
+                           unsigned thread_count)
+{
+    if (width == 0 || height == 0 || img.width() == 0 || img.height() == 0)
+        throw std::runtime_error("Can not resize empty images.");
+
+    Yimage::Image result(img.pixel_type(), width, height);
+    auto job = make_job(img, result.data(), width, height);
+    if (thread_count == 0)
+        thread_count = get_default_thread_count();
+    auto chunk_count = std::min(height, thread_count * CHUNKS_PER_THREAD);
+    parallel_for(chunk_count, [&](size_t i)
+    {
+        resample_rows(job, i * height / chunk_count,
+                      (i + 1) * height / chunk_count);
+    }, thread_count);
+
+    return result;
+}
+
+void resize_rows(const Yimage::Image& img,
+                 size_t first_row, size_t row_count, size_t width,
+                 unsigned char* dst, size_t dst_stride)
+{
+    if (width == 0 || img.width() == 0)
+        throw std::runtime_error("Can not resize empty images.");
+
+    auto job = make_job(img, dst, width, img.height());
+    std::vector<float> src_buffer(
+        (job.left_pad + job.src_width + job.right_pad) * job.channels);
+    std::vector<float> row(width * job.channels);
+    for (size_t i = 0; i < row_count; ++i)
+    {
+        filter_source_row(job, first_row + i, src_buffer, row.data());
+        job.kernels->f32_to_u8(row.data(), dst + i * dst_stride, row.size());
+    }
+}
+
+std::pair<size_t, size_t> get_size_to_fit(size_t width, size_t height,
+                                          size_t max_size)
+{
+    if (width <= max_size && height <= max_size)
+        return {width, height};
+
+    auto scale = std::min(double(max_size) / double(width),
+                          double(max_size) / double(height));
+    return {std::clamp(size_t(double(width) * scale), size_t(1), max_size),
+            std::clamp(size_t(double(height) * scale), size_t(1), max_size)};
+}
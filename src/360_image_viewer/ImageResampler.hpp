@@ -0,0 +1,32 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <utility>
+#include <Yimage/Yimage.hpp>
+
+// Resizes img with a separable Lanczos3 filter. The image wraps around
+// horizontally, as equirectangular panoramas do, and is clamped at the
+// top and bottom. Rows are streamed through a small ring buffer per
+// thread, so no full-size intermediate image is ever allocated.
+[[nodiscard]]
+Yimage::Image resize_image(const Yimage::Image& img,
+                           size_t width, size_t height,
+                           unsigned thread_count = 0);
+
+// Resizes rows [first_row, first_row + row_count) of img horizontally to
+// width pixels with the same filter as resize_image. The rows are written
+// to dst with dst_stride bytes between the start of each row.
+void resize_rows(const Yimage::Image& img,
+                 size_t first_row, size_t row_count, size_t width,
+                 unsigned char* dst, size_t dst_stride);
+
+// Returns the largest size with the same aspect ratio as width x height
+// that fits within max_size x max_size.
+[[nodiscard]]
+std::pair<size_t, size_t> get_size_to_fit(size_t width, size_t height,
+                                          size_t max_size);
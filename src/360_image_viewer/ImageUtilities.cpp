@@ -0,0 +1,46 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ImageUtilities.hpp"
+
+#include <stdexcept>
+#include <string>
+
+size_t get_channel_count(Yimage::PixelType type)
+{
+    switch (type)
+    {
+    case Yimage::PixelType::MONO_8:
+        return 1;
+    case Yimage::PixelType::MONO_ALPHA_8:
+        return 2;
+    case Yimage::PixelType::RGB_8:
+        return 3;
+    case Yimage::PixelType::RGBA_8:
+        return 4;
+    default:
+        throw std::runtime_error("Unsupported pixel type: "
+                                 + std::to_string(int(type)) + ".");
+    }
+}
+
+size_t get_pixel_size(Yimage::PixelType type)
+{
+    switch (type)
+    {
+    case Yimage::PixelType::MONO_16:
+        return 2;
+    case Yimage::PixelType::MONO_ALPHA_16:
+        return 4;
+    case Yimage::PixelType::RGB_16:
+        return 6;
+    case Yimage::PixelType::RGBA_16:
+        return 8;
+    default:
+        return get_channel_count(type);
+    }
+}
@@ -0,0 +1,20 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <Yimage/Yimage.hpp>
+
+// Returns the number of channels in pixels of the given type. Only 8-bit
+// pixel types are supported, other types throw an exception.
+[[nodiscard]]
+size_t get_channel_count(Yimage::PixelType type);
+
+// Returns the number of bytes in pixels of the given type. Supports the
+// 8-bit pixel types and the 16-bit ones with the same channels, other
+// types throw an exception.
+[[nodiscard]]
+size_t get_pixel_size(Yimage::PixelType type);
@@ -0,0 +1,104 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "IncrementalUpload.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    // Small enough that a stripe rarely overshoots a time budget by
+    // much, large enough that the per-call overhead doesn't matter.
+    constexpr size_t STRIPE_SIZE = 1024 * 1024;
+
+    size_t get_stripe_rows(size_t row_count, size_t row_size,
+                           const UploadBudget& budget)
+    {
+        if (budget.max_ms_per_frame <= 0 && budget.max_bytes_per_frame == 0)
+            return row_count;
+        auto size = STRIPE_SIZE;
+        if (budget.max_bytes_per_frame != 0)
+            size = std::min(size, budget.max_bytes_per_frame);
+        return std::max<size_t>(size / std::max<size_t>(row_size, 1), 1);
+    }
+}
+
+IncrementalUpload::IncrementalUpload(size_t row_count, size_t row_size,
+                                     UploadRowsFunc upload_rows,
+                                     const UploadBudget& budget)
+    : row_count_(row_count),
+      row_size_(row_size),
+      stripe_rows_(get_stripe_rows(row_count, row_size, budget)),
+      upload_rows_(std::move(upload_rows)),
+      budget_(budget),
+      start_time_(Clock::now()),
+      end_time_(start_time_)
+{}
+
+bool IncrementalUpload::upload_next_stripes()
+{
+    using namespace std::chrono;
+    if (is_done())
+        return true;
+
+    auto frame_start = Clock::now();
+    size_t bytes = 0;
+    auto is_within_budget = [&]
+    {
+        auto next_bytes = std::min(stripe_rows_, row_count_ - next_row_) * row_size_;
+        if (budget_.max_bytes_per_frame != 0
+            && bytes + next_bytes > budget_.max_bytes_per_frame)
+        {
+            return false;
+        }
+        if (budget_.max_ms_per_frame > 0)
+        {
+            auto ms = duration<double, std::milli>(Clock::now() - frame_start).count();
+            return ms < budget_.max_ms_per_frame;
+        }
+        return true;
+    };
+
+    do
+    {
+        auto count = std::min(stripe_rows_, row_count_ - next_row_);
+        auto stripe_start = Clock::now();
+        upload_rows_(next_row_, count);
+        upload_time_ += Clock::now() - stripe_start;
+        next_row_ += count;
+        bytes += count * row_size_;
+    } while (!is_done() && is_within_budget());
+
+    ++frame_count_;
+    if (is_done())
+        end_time_ = Clock::now();
+    return is_done();
+}
+
+bool IncrementalUpload::is_done() const
+{
+    return next_row_ == row_count_;
+}
+
+int IncrementalUpload::frame_count() const
+{
+    return frame_count_;
+}
+
+double IncrementalUpload::elapsed_ms() const
+{
+    using namespace std::chrono;
+    auto end = is_done() ? end_time_ : Clock::now();
+    return duration<double, std::milli>(end - start_time_).count();
+}
+
+double IncrementalUpload::upload_ms() const
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(upload_time_).count();
+}
@@ -0,0 +1,69 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+
+// Limits how much of a texture is uploaded per frame. 0 means no limit,
+// and when both are 0 the whole texture is uploaded at once.
+struct UploadBudget
+{
+    double max_ms_per_frame = 0;
+    size_t max_bytes_per_frame = 0;
+};
+
+// Spreads the upload of a texture over several frames by uploading it in
+// horizontal stripes. The caller allocates the texture's storage and
+// provides a function that uploads a range of rows to it.
+//
+// At least one stripe is uploaded per frame, however small the budget.
+class IncrementalUpload
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using UploadRowsFunc = std::function<void(size_t first_row,
+                                              size_t row_count)>;
+
+    IncrementalUpload() = default;
+
+    IncrementalUpload(size_t row_count, size_t row_size,
+                      UploadRowsFunc upload_rows,
+                      const UploadBudget& budget);
+
+    // Uploads as many stripes as the budget allows. Returns true when the
+    // last stripe has been uploaded.
+    bool upload_next_stripes();
+
+    [[nodiscard]]
+    bool is_done() const;
+
+    // The number of calls to upload_next_stripes that uploaded stripes.
+    [[nodiscard]]
+    int frame_count() const;
+
+    // The time from the upload was created until the last stripe was
+    // uploaded, or until now if the upload isn't done.
+    [[nodiscard]]
+    double elapsed_ms() const;
+
+    // The time spent in upload_rows.
+    [[nodiscard]]
+    double upload_ms() const;
+private:
+    size_t row_count_ = 0;
+    size_t row_size_ = 0;
+    size_t stripe_rows_ = 0;
+    size_t next_row_ = 0;
+    UploadRowsFunc upload_rows_;
+    UploadBudget budget_;
+    int frame_count_ = 0;
+    Clock::time_point start_time_;
+    Clock::time_point end_time_;
+    Clock::duration upload_time_ = {};
+};
@@ -0,0 +1,713 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "JpegDecoder.hpp"
+
+#include <algorithm>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <jpeglib.h>
+#include <jerror.h>
+#include "Parallel.hpp"
+
+namespace
+{
+    // Having more stripes than threads evens out the difference in
+    // decoding time between simple and complex parts of the image.
+    constexpr unsigned STRIPES_PER_THREAD = 4;
+
+    struct JpegLayout
+    {
+        // Offset of the height field in the SOF segment.
+        size_t height_offset = 0;
+        // Offsets of the first byte of entropy-coded data and of the
+        // marker that ends it.
+        size_t scan_begin = 0;
+        size_t scan_end = 0;
+        unsigned width = 0;
+        unsigned height = 0;
+        unsigned components = 0;
+        unsigned mcu_width = 0;
+        unsigned mcu_height = 0;
+        // True if a component has fewer rows of samples than the image.
+        // The decoder's fancy upsampling of such components looks at the
+        // neighboring rows of samples, also across MCU rows.
+        bool is_vertically_subsampled = false;
+        unsigned restart_interval = 0;
+        // Offsets of the RSTn markers in the entropy-coded data. The
+        // marker at index i precedes restart interval i + 1.
+        std::vector<size_t> restart_offsets;
+    };
+
+    struct Stripe
+    {
+        unsigned first_interval;
+        unsigned first_mcu_row;
+    };
+
+    [[nodiscard]]
+    unsigned read_u16(const uint8_t* p)
+    {
+        return unsigned(p[0]) << 8u | p[1];
+    }
+
+    [[nodiscard]]
+    bool is_restart_marker(uint8_t marker)
+    {
+        return 0xD0 <= marker && marker <= 0xD7;
+    }
+
+    [[nodiscard]]
+    bool is_unsupported_frame_marker(uint8_t marker)
+    {
+        // Progressive, lossless, hierarchical and arithmetic coded frames.
+        return 0xC2 <= marker && marker <= 0xCF
+               && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+    }
+
+    [[nodiscard]]
+    bool read_frame_header(const uint8_t* segment, size_t size,
+                           JpegLayout& layout)
+    {
+        if (size < 6 || segment[0] != 8)
+            return false;
+
+        layout.height = read_u16(segment + 1);
+        layout.width = read_u16(segment + 3);
+        layout.components = segment[5];
+        if (layout.width == 0 || layout.height == 0)
+            return false;
+        if (layout.components != 1 && layout.components != 3)
+            return false;
+        if (size < 6 + 3 * layout.components)
+            return false;
+
+        if (layout.components == 1)
+        {
+            layout.mcu_width = layout.mcu_height = 8;
+            return true;
+        }
+
+        unsigned h_max = 1, v_max = 1, v_min = 4;
+        for (unsigned i = 0; i < layout.components; ++i)
+        {
+            auto sampling = segment[6 + 3 * i + 1];
+            h_max = std::max(h_max, unsigned(sampling >> 4u));
+            v_max = std::max(v_max, unsigned(sampling & 0xFu));
+            v_min = std::min(v_min, unsigned(sampling & 0xFu));
+        }
+        layout.mcu_width = 8 * h_max;
+        layout.mcu_height = 8 * v_max;
+        layout.is_vertically_subsampled = v_min < v_max;
+        return true;
+    }
+
+    [[nodiscard]]
+    bool read_entropy_coded_data(const uint8_t* data, size_t size,
+                                 JpegLayout& layout)
+    {
+        auto pos = layout.scan_begin;
+        while (pos + 1 < size)
+        {
+            auto next = static_cast<const uint8_t*>(
+                memchr(data + pos, 0xFF, size - pos - 1));
+            if (!next)
+                return false;
+
+            pos = size_t(next - data);
+            auto marker = data[pos + 1];
+            if (marker == 0x00)
+            {
+                pos += 2;
+            }
+            else if (marker == 0xFF)
+            {
+                ++pos;
+            }
+            else if (is_restart_marker(marker))
+            {
+                layout.restart_offsets.push_back(pos);
+                pos += 2;
+            }
+            else
+            {
+                layout.scan_end = pos;
+                // Files with more than one scan can't be split.
+                return marker == 0xD9;
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]]
+    std::optional<JpegLayout> read_jpeg_layout(const uint8_t* data, size_t size)
+    {
+        if (!is_jpeg(data, size))
+            return {};
+
+        JpegLayout layout;
+        bool has_frame = false;
+        size_t pos = 2;
+        while (pos + 4 <= size && data[pos] == 0xFF)
+        {
+            auto marker = data[pos + 1];
+            if (marker == 0xFF)
+            {
+                ++pos;
+                continue;
+            }
+
+            auto length = read_u16(data + pos + 2);
+            if (length < 2 || pos + 2 + length > size)
+                return {};
+
+            auto segment = data + pos + 4;
+            auto segment_size = length - 2;
+            if (marker == 0xC0 || marker == 0xC1)
+            {
+                if (!read_frame_header(segment, segment_size, layout))
+                    return {};
+                layout.height_offset = pos + 5;
+                has_frame = true;
+            }
+            else if (is_unsupported_frame_marker(marker))
+            {
+                return {};
+            }
+            else if (marker == 0xDD)
+            {
+                if (segment_size < 2)
+                    return {};
+                layout.restart_interval = read_u16(segment);
+            }
+            else if (marker == 0xDA)
+            {
+                // The scan must contain all components, otherwise there
+                // will be more scans after this one.
+                if (!has_frame || layout.restart_interval == 0
+                    || segment_size < 1 || segment[0] != layout.components)
+                {
+                    return {};
+                }
+                layout.scan_begin = pos + 2 + length;
+                if (!read_entropy_coded_data(data, size, layout))
+                    return {};
+                return layout;
+            }
+
+            pos += 2 + length;
+        }
+        return {};
+    }
+
+    // Returns the restart intervals that begin at the start of an MCU
+    // row, which are the only places where the image can be split,
+    // followed by the end of the image. Returns an empty vector if the
+    // restart markers don't match the image size.
+    [[nodiscard]]
+    std::vector<Stripe> find_row_starts(const JpegLayout& layout)
+    {
+        auto mcus_per_row = (layout.width + layout.mcu_width - 1) / layout.mcu_width;
+        auto mcu_rows = (layout.height + layout.mcu_height - 1) / layout.mcu_height;
+        auto mcu_count = size_t(mcus_per_row) * mcu_rows;
+        auto interval_count = (mcu_count + layout.restart_interval - 1)
+                              / layout.restart_interval;
+        // The restart markers are the only guarantee that the MCU numbering
+        // is correct, there must be exactly one between each interval.
+        if (layout.restart_offsets.size() + 1 != interval_count)
+            return {};
+
+        std::vector<Stripe> result{{0, 0}};
+        for (unsigned i = 1; i < interval_count; ++i)
+        {
+            auto mcu = size_t(i) * layout.restart_interval;
+            if (mcu % mcus_per_row == 0)
+                result.push_back({i, unsigned(mcu / mcus_per_row)});
+        }
+        result.push_back({unsigned(interval_count), mcu_rows});
+        return result;
+    }
+
+    [[nodiscard]]
+    std::vector<Stripe>
+    select_stripes(const std::vector<Stripe>& row_starts, unsigned max_stripes)
+    {
+        if (row_starts.size() < 2)
+            return {};
+
+        auto mcu_rows = row_starts.back().first_mcu_row;
+        auto stripe_count = std::min(max_stripes, mcu_rows);
+        std::vector<Stripe> stripes{row_starts.front()};
+        for (size_t i = 1; i + 1 < row_starts.size() && stripes.size() < stripe_count; ++i)
+        {
+            auto target_row = stripes.size() * mcu_rows / stripe_count;
+            if (row_starts[i].first_mcu_row >= target_row)
+                stripes.push_back(row_starts[i]);
+        }
+        return stripes;
+    }
+
+    // Creates a complete JPEG file containing only the given restart
+    // intervals, which must be height rows in total.
+    [[nodiscard]]
+    std::vector<uint8_t> make_stripe_jpeg(const uint8_t* data,
+                                          const JpegLayout& layout,
+                                          unsigned first_interval,
+                                          unsigned end_interval,
+                                          unsigned height)
+    {
+        auto begin = first_interval == 0
+                     ? layout.scan_begin
+                     : layout.restart_offsets[first_interval - 1] + 2;
+        auto end = end_interval - 1 < layout.restart_offsets.size()
+                   ? layout.restart_offsets[end_interval - 1]
+                   : layout.scan_end;
+
+        std::vector<uint8_t> result;
+        result.reserve(layout.scan_begin + (end - begin) + 2);
+        result.insert(result.end(), data, data + layout.scan_begin);
+        result[layout.height_offset] = uint8_t(height >> 8u);
+        result[layout.height_offset + 1] = uint8_t(height);
+        result.insert(result.end(), data + begin, data + end);
+        result.push_back(0xFF);
+        result.push_back(0xD9);
+
+        // The decoder expects the restart markers to start at RST0.
+        for (auto i = first_interval; i + 1 < end_interval; ++i)
+        {
+            auto offset = layout.scan_begin
+                          + layout.restart_offsets[i] - begin + 1;
+            result[offset] = uint8_t(0xD0 + (i - first_interval) % 8);
+        }
+        return result;
+    }
+
+    struct JpegErrorManager
+    {
+        jpeg_error_mgr pub;
+        jmp_buf jump_buffer;
+        char message[JMSG_LENGTH_MAX];
+    };
+
+    void handle_jpeg_error(j_common_ptr cinfo)
+    {
+        auto err = reinterpret_cast<JpegErrorManager*>(cinfo->err);
+        (*cinfo->err->format_message)(cinfo, err->message);
+        longjmp(err->jump_buffer, 1);
+    }
+
+    // Decodes jpeg, which must be width x height pixels, and writes rows
+    // [first_row, first_row + row_count) to rows. The other rows are
+    // decoded into scratch_row and discarded. libjpeg reports errors with
+    // longjmp, this function must therefore not have any local variables
+    // with non-trivial destructors. Returns nullptr on success, otherwise
+    // an error message.
+    const char* decode_stripe(const std::vector<uint8_t>& jpeg,
+                              unsigned components,
+                              unsigned char* rows, size_t row_size,
+                              unsigned width, unsigned height,
+                              unsigned first_row, unsigned row_count,
+                              unsigned char* scratch_row,
+                              JpegErrorManager& err)
+    {
+        jpeg_decompress_struct cinfo = {};
+        cinfo.err = jpeg_std_error(&err.pub);
+        err.pub.error_exit = handle_jpeg_error;
+        if (setjmp(err.jump_buffer))
+        {
+            jpeg_destroy_decompress(&cinfo);
+            return err.message;
+        }
+
+        jpeg_create_decompress(&cinfo);
+        jpeg_mem_src(&cinfo, jpeg.data(), static_cast<unsigned long>(jpeg.size()));
+        jpeg_read_header(&cinfo, TRUE);
+        cinfo.out_color_space = components == 3 ? JCS_RGB : JCS_GRAYSCALE;
+        jpeg_start_decompress(&cinfo);
+        if (cinfo.output_width != width || cinfo.output_height != height
+            || cinfo.output_components != int(components))
+        {
+            jpeg_destroy_decompress(&cinfo);
+            return "stripe has unexpected dimensions";
+        }
+
+        // The rows after the last one that is kept are only there to give
+        // it the same upsampling context as in the whole image, and the
+        // decoder has already read them.
+        while (cinfo.output_scanline < first_row + row_count)
+        {
+            auto line = cinfo.output_scanline;
+            JSAMPROW row = line < first_row
+                           ? scratch_row
+                           : rows + (line - first_row) * row_size;
+            jpeg_read_scanlines(&cinfo, &row, 1);
+        }
+
+        if (cinfo.output_scanline == cinfo.output_height)
+            jpeg_finish_decompress(&cinfo);
+        jpeg_destroy_decompress(&cinfo);
+        return nullptr;
+    }
+
+    enum class StreamState
+    {
+        HEADER,
+        START,
+        SCANLINES,
+        FINISH,
+        DONE,
+        UNSUPPORTED
+    };
+
+    // A data source that makes libjpeg suspend when it runs out of data,
+    // rather than fail.
+    struct StreamSource
+    {
+        jpeg_source_mgr pub;
+        std::vector<uint8_t> buffer;
+        // Bytes libjpeg has asked to skip that haven't arrived yet.
+        size_t skip_count = 0;
+        bool is_finished = false;
+    };
+
+    void init_stream_source(j_decompress_ptr)
+    {}
+
+    boolean fill_stream_buffer(j_decompress_ptr cinfo)
+    {
+        auto src = reinterpret_cast<StreamSource*>(cinfo->src);
+        if (!src->is_finished)
+            return FALSE;
+
+        // Same as libjpeg's own sources: end truncated files with an EOI.
+        static const JOCTET EOI[2] = {0xFF, JPEG_EOI};
+        WARNMS(cinfo, JWRN_JPEG_EOF);
+        src->pub.next_input_byte = EOI;
+        src->pub.bytes_in_buffer = 2;
+        return TRUE;
+    }
+
+    void skip_stream_data(j_decompress_ptr cinfo, long count)
+    {
+        if (count <= 0)
+            return;
+
+        auto src = reinterpret_cast<StreamSource*>(cinfo->src);
+        auto n = size_t(count);
+        if (n <= src->pub.bytes_in_buffer)
+        {
+            src->pub.next_input_byte += n;
+            src->pub.bytes_in_buffer -= n;
+            return;
+        }
+
+        src->skip_count += n - src->pub.bytes_in_buffer;
+        src->pub.next_input_byte += src->pub.bytes_in_buffer;
+        src->pub.bytes_in_buffer = 0;
+    }
+
+    void term_stream_source(j_decompress_ptr)
+    {}
+
+    // Decodes until libjpeg suspends or the image is complete. Like
+    // decode_stripe, this function can not have local variables with
+    // non-trivial destructors. Returns nullptr unless there is an error.
+    const char* decode_stream(jpeg_decompress_struct& cinfo,
+                              StreamState& state,
+                              Yimage::Image& img,
+                              size_t& row_count,
+                              JpegErrorManager& err)
+    {
+        if (setjmp(err.jump_buffer))
+            return err.message;
+
+        if (state == StreamState::HEADER)
+        {
+            if (jpeg_read_header(&cinfo, TRUE) == JPEG_SUSPENDED)
+                return nullptr;
+
+            if (cinfo.num_components == 1)
+            {
+                cinfo.out_color_space = JCS_GRAYSCALE;
+            }
+            else if (cinfo.num_components == 3)
+            {
+                cinfo.out_color_space = JCS_RGB;
+            }
+            else
+            {
+                state = StreamState::UNSUPPORTED;
+                return nullptr;
+            }
+
+            img = Yimage::Image(cinfo.num_components == 1
+                                ? Yimage::PixelType::MONO_8
+                                : Yimage::PixelType::RGB_8,
+                                cinfo.image_width, cinfo.image_height);
+            state = StreamState::START;
+        }
+
+        if (state == StreamState::START)
+        {
+            if (!jpeg_start_decompress(&cinfo))
+                return nullptr;
+            state = StreamState::SCANLINES;
+        }
+
+        if (state == StreamState::SCANLINES)
+        {
+            constexpr JDIMENSION MAX_ROWS = 16;
+            JSAMPROW rows[MAX_ROWS];
+            auto row_size = img.row_size();
+            while (cinfo.output_scanline < cinfo.output_height)
+            {
+                auto first_row = cinfo.output_scanline;
+                auto n = std::min(MAX_ROWS, cinfo.output_height - first_row);
+                for (JDIMENSION i = 0; i < n; ++i)
+                    rows[i] = img.data() + (first_row + i) * row_size;
+                if (jpeg_read_scanlines(&cinfo, rows, n) == 0)
+                    return nullptr;
+                row_count = cinfo.output_scanline;
+            }
+            state = StreamState::FINISH;
+        }
+
+        if (state == StreamState::FINISH)
+        {
+            if (!jpeg_finish_decompress(&cinfo))
+                return nullptr;
+            state = StreamState::DONE;
+        }
+        return nullptr;
+    }
+}
+
+bool is_jpeg(const void* data, size_t size)
+{
+    auto bytes = static_cast<const uint8_t*>(data);
+    return size >= 3 && bytes[0] == 0xFF && bytes[1] == 0xD8 && bytes[2] == 0xFF;
+}
+
+Yimage::Image read_jpeg_parallel(const void* data, size_t size,
+                                 unsigned thread_count)
+{
+    if (thread_count == 0)
+        thread_count = get_default_thread_count();
+    if (thread_count < 2)
+        return {};
+
+    JpegStripeDecoder decoder(data, size, thread_count * STRIPES_PER_THREAD);
+    if (decoder.stripe_count() < 2)
+        return {};
+
+    auto img = decoder.make_image();
+    std::vector<size_t> indices(decoder.stripe_count());
+    std::iota(indices.begin(), indices.end(), 0);
+    decoder.decode_stripes(indices, img, thread_count);
+    return img;
+}
+
+struct JpegStripeDecoder::Data
+{
+    const uint8_t* bytes = nullptr;
+    JpegLayout layout;
+    std::vector<Stripe> row_starts;
+    std::vector<Stripe> stripes;
+};
+
+JpegStripeDecoder::JpegStripeDecoder(const void* data, size_t size,
+                                     unsigned max_stripes)
+    : data_(std::make_unique<Data>())
+{
+    data_->bytes = static_cast<const uint8_t*>(data);
+    if (auto layout = read_jpeg_layout(data_->bytes, size))
+    {
+        data_->layout = std::move(*layout);
+        data_->row_starts = find_row_starts(data_->layout);
+        data_->stripes = select_stripes(data_->row_starts, max_stripes);
+    }
+}
+
+JpegStripeDecoder::~JpegStripeDecoder() = default;
+
+size_t JpegStripeDecoder::stripe_count() const
+{
+    return data_->stripes.size();
+}
+
+size_t JpegStripeDecoder::stripe_first_row(size_t index) const
+{
+    return size_t(data_->stripes[index].first_mcu_row) * data_->layout.mcu_height;
+}
+
+size_t JpegStripeDecoder::stripe_row_count(size_t index) const
+{
+    auto end_row = index + 1 < data_->stripes.size()
+                   ? stripe_first_row(index + 1)
+                   : size_t(data_->layout.height);
+    return end_row - stripe_first_row(index);
+}
+
+Yimage::Image JpegStripeDecoder::make_image() const
+{
+    const auto& layout = data_->layout;
+    auto pixel_type = layout.components == 3 ? Yimage::PixelType::RGB_8
+                                             : Yimage::PixelType::MONO_8;
+    return {pixel_type, layout.width, layout.height};
+}
+
+void JpegStripeDecoder::decode_stripes(const std::vector<size_t>& indices,
+                                       Yimage::Image& img,
+                                       unsigned thread_count) const
+{
+    const auto& layout = data_->layout;
+    const auto& stripes = data_->stripes;
+    const auto& row_starts = data_->row_starts;
+    auto row_size = size_t(layout.width) * layout.components;
+    auto find_row_start = [&](unsigned interval)
+    {
+        return size_t(std::lower_bound(row_starts.begin(), row_starts.end(),
+                                       interval,
+                                       [](auto& s, unsigned i) {return s.first_interval < i;})
+                      - row_starts.begin());
+    };
+
+    parallel_for(indices.size(), [&](size_t i)
+    {
+        auto index = indices[i];
+        auto first = find_row_start(stripes[index].first_interval);
+        auto end = index + 1 < stripes.size()
+                   ? find_row_start(stripes[index + 1].first_interval)
+                   : row_starts.size() - 1;
+        // Subsampled components are upsampled with the rows of samples
+        // above and below each row, the stripe is therefore decoded with
+        // the MCU rows on either side of it to make its edges identical
+        // to those of a sequential decode.
+        auto decode_first = first;
+        auto decode_end = end;
+        if (layout.is_vertically_subsampled)
+        {
+            decode_first = first == 0 ? first : first - 1;
+            decode_end = std::min(end + 1, row_starts.size() - 1);
+        }
+
+        auto decode_y0 = row_starts[decode_first].first_mcu_row * layout.mcu_height;
+        auto decode_y1 = std::min(row_starts[decode_end].first_mcu_row * layout.mcu_height,
+                                  layout.height);
+        auto y0 = unsigned(stripe_first_row(index));
+        auto jpeg = make_stripe_jpeg(data_->bytes, layout,
+                                     row_starts[decode_first].first_interval,
+                                     row_starts[decode_end].first_interval,
+                                     decode_y1 - decode_y0);
+        std::vector<uint8_t> scratch_row(row_size);
+        JpegErrorManager err = {};
+        auto message = decode_stripe(jpeg, layout.components,
+                                     img.data() + y0 * row_size, row_size,
+                                     layout.width, decode_y1 - decode_y0,
+                                     y0 - decode_y0,
+                                     unsigned(stripe_row_count(index)),
+                                     scratch_row.data(), err);
+        if (message)
+        {
+            throw std::runtime_error(
+                std::string("Error while decoding JPEG stripe: ") + message);
+        }
+    }, thread_count);
+}
+
+struct JpegStreamDecoder::Data
+{
+    jpeg_decompress_struct cinfo = {};
+    JpegErrorManager err = {};
+    StreamSource source = {};
+    StreamState state = StreamState::HEADER;
+    Yimage::Image image;
+    size_t row_count = 0;
+};
+
+JpegStreamDecoder::JpegStreamDecoder()
+    : data_(std::make_unique<Data>())
+{
+    auto& cinfo = data_->cinfo;
+    cinfo.err = jpeg_std_error(&data_->err.pub);
+    data_->err.pub.error_exit = handle_jpeg_error;
+    jpeg_create_decompress(&cinfo);
+
+    auto& src = data_->source.pub;
+    src.init_source = init_stream_source;
+    src.fill_input_buffer = fill_stream_buffer;
+    src.skip_input_data = skip_stream_data;
+    src.resync_to_restart = jpeg_resync_to_restart;
+    src.term_source = term_stream_source;
+    cinfo.src = &src;
+}
+
+JpegStreamDecoder::~JpegStreamDecoder()
+{
+    jpeg_destroy_decompress(&data_->cinfo);
+}
+
+bool JpegStreamDecoder::add_data(const void* data, size_t size)
+{
+    if (data_->state == StreamState::UNSUPPORTED)
+        return false;
+
+    auto bytes = static_cast<const uint8_t*>(data);
+    auto& source = data_->source;
+    auto skip = std::min(source.skip_count, size);
+    source.skip_count -= skip;
+
+    // Only the bytes libjpeg hasn't consumed yet must be kept.
+    auto& buffer = source.buffer;
+    auto consumed = buffer.size() - source.pub.bytes_in_buffer;
+    buffer.erase(buffer.begin(), buffer.begin() + std::ptrdiff_t(consumed));
+    buffer.insert(buffer.end(), bytes + skip, bytes + size);
+    source.pub.next_input_byte = buffer.data();
+    source.pub.bytes_in_buffer = buffer.size();
+
+    auto message = decode_stream(data_->cinfo, data_->state, data_->image,
+                                 data_->row_count, data_->err);
+    if (message)
+        throw std::runtime_error(std::string("Error while decoding JPEG: ") + message);
+    return data_->state != StreamState::UNSUPPORTED;
+}
+
+void JpegStreamDecoder::finish()
+{
+    if (data_->state == StreamState::DONE)
+        return;
+
+    data_->source.is_finished = true;
+    auto message = decode_stream(data_->cinfo, data_->state, data_->image,
+                                 data_->row_count, data_->err);
+    if (message)
+        throw std::runtime_error(std::string("Error while decoding JPEG: ") + message);
+    if (data_->state != StreamState::DONE)
+        throw std::runtime_error("Unable to decode JPEG.");
+}
+
+const Yimage::Image& JpegStreamDecoder::image() const
+{
+    return data_->image;
+}
+
+size_t JpegStreamDecoder::row_count() const
+{
+    return data_->row_count;
+}
+
+Yimage::Image JpegStreamDecoder::release_image()
+{
+    data_->row_count = 0;
+    return std::move(data_->image);
+}
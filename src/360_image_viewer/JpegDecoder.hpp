@@ -0,0 +1,102 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include <vector>
+#include <Yimage/Yimage.hpp>
+
+[[nodiscard]]
+bool is_jpeg(const void* data, size_t size);
+
+// Decodes a baseline JPEG in parallel by splitting its entropy-coded data
+// on restart markers that coincide with the start of an MCU row. Each
+// stripe is decoded directly into its rows of the returned image.
+// Returns an empty image if the JPEG can not be split this way.
+[[nodiscard]]
+Yimage::Image read_jpeg_parallel(const void* data, size_t size,
+                                 unsigned thread_count = 0);
+
+// Splits a baseline JPEG into stripes the same way as read_jpeg_parallel
+// and decodes them in whatever order and batches the caller chooses.
+// The data must stay alive as long as the decoder.
+class JpegStripeDecoder
+{
+public:
+    // stripe_count() is 0 if the JPEG can not be split.
+    JpegStripeDecoder(const void* data, size_t size, unsigned max_stripes);
+
+    ~JpegStripeDecoder();
+
+    JpegStripeDecoder(const JpegStripeDecoder&) = delete;
+
+    JpegStripeDecoder& operator=(const JpegStripeDecoder&) = delete;
+
+    [[nodiscard]]
+    size_t stripe_count() const;
+
+    // The stripes are in top to bottom order, each one ends where the
+    // next one begins.
+    [[nodiscard]]
+    size_t stripe_first_row(size_t index) const;
+
+    [[nodiscard]]
+    size_t stripe_row_count(size_t index) const;
+
+    // Returns an uninitialized image with the JPEG's size and pixel type.
+    [[nodiscard]]
+    Yimage::Image make_image() const;
+
+    // Decodes the stripes with the given indices in parallel, directly
+    // into their rows of img, which must have been made by make_image.
+    // Other rows of img are not touched and can be read meanwhile.
+    void decode_stripes(const std::vector<size_t>& indices,
+                        Yimage::Image& img,
+                        unsigned thread_count = 0) const;
+private:
+    struct Data;
+    std::unique_ptr<Data> data_;
+};
+
+// Decodes a JPEG file as its data arrives, one chunk at a time. The
+// rows are written to image() as soon as they have been decoded.
+// Progressive JPEGs are only decoded when all data has arrived.
+class JpegStreamDecoder
+{
+public:
+    JpegStreamDecoder();
+
+    ~JpegStreamDecoder();
+
+    JpegStreamDecoder(const JpegStreamDecoder&) = delete;
+
+    JpegStreamDecoder& operator=(const JpegStreamDecoder&) = delete;
+
+    // Adds the next chunk of the file and decodes as many rows as
+    // possible. Returns false if the file uses a color space that isn't
+    // supported, the decoder must then be discarded.
+    bool add_data(const void* data, size_t size);
+
+    // Decodes the remaining rows, the file is assumed to be truncated
+    // if any of them haven't arrived yet.
+    void finish();
+
+    // Empty until the JPEG header has been read.
+    [[nodiscard]]
+    const Yimage::Image& image() const;
+
+    // Returns the number of rows at the top of image() that have been
+    // decoded.
+    [[nodiscard]]
+    size_t row_count() const;
+
+    [[nodiscard]]
+    Yimage::Image release_image();
+private:
+    struct Data;
+    std::unique_ptr<Data> data_;
+};
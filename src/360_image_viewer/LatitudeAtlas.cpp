@@ -0,0 +1,142 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "LatitudeAtlas.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "ImageResampler.hpp"
+#include "ImageUtilities.hpp"
+#include "Parallel.hpp"
+
+namespace
+{
+    constexpr size_t PADDING = LATITUDE_ATLAS_PADDING;
+    constexpr size_t MIN_BAND_WIDTH = 8;
+    // Don't start a new piece in less space than this at the end of a row.
+    constexpr size_t MIN_PIECE_WIDTH = 16;
+
+    [[nodiscard]]
+    std::vector<LatitudeBand> make_bands(size_t width, size_t height,
+                                         size_t band_count)
+    {
+        constexpr double PI = 3.14159265358979323846;
+        band_count = std::clamp<size_t>(band_count, 1, height);
+        std::vector<LatitudeBand> bands(band_count);
+        for (size_t i = 0; i < band_count; ++i)
+        {
+            auto& band = bands[i];
+            band.first_row = i * height / band_count;
+            band.row_count = (i + 1) * height / band_count - band.first_row;
+            // The latitude of the band's edge that is closest to the equator.
+            auto top = 0.5 - double(band.first_row) / double(height);
+            auto bottom = 0.5 - double(band.first_row + band.row_count)
+                                / double(height);
+            auto latitude = top * bottom <= 0
+                            ? 0.0
+                            : std::min(std::abs(top), std::abs(bottom)) * PI;
+            auto band_width = size_t(std::ceil(double(width) * std::cos(latitude)));
+            band.width = std::clamp(band_width, std::min(MIN_BAND_WIDTH, width), width);
+        }
+        return bands;
+    }
+
+    // Places the bands one after the other in rows as tall as the tallest
+    // band. Bands that reach the end of a row continue on the next one.
+    // Returns the height of the atlas.
+    size_t pack_bands(std::vector<LatitudeBand>& bands, size_t atlas_width)
+    {
+        size_t row_height = 0;
+        for (const auto& band: bands)
+            row_height = std::max(row_height, band.row_count + 2 * PADDING);
+
+        size_t x = 0, y = 0;
+        for (auto& band: bands)
+        {
+            size_t offset = 0;
+            while (offset < band.width)
+            {
+                if (x + 2 * PADDING + MIN_PIECE_WIDTH > atlas_width)
+                {
+                    x = 0;
+                    y += row_height;
+                }
+
+                auto width = std::min(band.width - offset,
+                                      atlas_width - x - 2 * PADDING);
+                band.pieces.push_back({offset, x + PADDING, y + PADDING, width});
+                offset += width;
+                x += width + 2 * PADDING;
+            }
+        }
+        return y + row_height;
+    }
+
+    // Resamples the band, with one extra row above and below it, and
+    // copies the pieces into the atlas. The padding around each piece
+    // contains the neighbouring pixels in the band, which wraps around
+    // horizontally.
+    void write_band(const Yimage::Image& img, const LatitudeBand& band,
+                    Yimage::Image& atlas, size_t pixel_size)
+    {
+        auto buffer_width = band.width + 2 * PADDING;
+        auto buffer_height = band.row_count + 2 * PADDING;
+        auto buffer_stride = buffer_width * pixel_size;
+        std::vector<unsigned char> buffer(buffer_height * buffer_stride);
+
+        auto band_start = buffer.data() + buffer_stride + PADDING * pixel_size;
+        auto above = band.first_row == 0 ? 0 : band.first_row - 1;
+        auto below = std::min(band.first_row + band.row_count, img.height() - 1);
+        resize_rows(img, above, 1, band.width, band_start - buffer_stride,
+                    buffer_stride);
+        resize_rows(img, band.first_row, band.row_count, band.width,
+                    band_start, buffer_stride);
+        resize_rows(img, below, 1, band.width,
+                    band_start + band.row_count * buffer_stride, buffer_stride);
+
+        for (size_t y = 0; y < buffer_height; ++y)
+        {
+            auto row = buffer.data() + y * buffer_stride + PADDING * pixel_size;
+            memcpy(row - pixel_size, row + (band.width - 1) * pixel_size, pixel_size);
+            memcpy(row + band.width * pixel_size, row, pixel_size);
+        }
+
+        auto atlas_stride = atlas.width() * pixel_size;
+        for (const auto& piece: band.pieces)
+        {
+            for (size_t y = 0; y < buffer_height; ++y)
+            {
+                auto src = buffer.data() + y * buffer_stride
+                           + piece.offset * pixel_size;
+                auto dst = atlas.data()
+                           + (piece.y - PADDING + y) * atlas_stride
+                           + (piece.x - PADDING) * pixel_size;
+                memcpy(dst, src, (piece.width + 2 * PADDING) * pixel_size);
+            }
+        }
+    }
+}
+
+LatitudeAtlas make_latitude_atlas(const Yimage::Image& img,
+                                  size_t band_count,
+                                  unsigned thread_count)
+{
+    LatitudeAtlas result;
+    result.bands = make_bands(img.width(), img.height(), band_count);
+    auto atlas_width = img.width() + 2 * PADDING;
+    auto atlas_height = pack_bands(result.bands, atlas_width);
+    result.image = Yimage::Image(img.pixel_type(), atlas_width, atlas_height);
+    memset(result.image.data(), 0, result.image.size());
+
+    auto pixel_size = get_channel_count(img.pixel_type());
+    parallel_for(result.bands.size(), [&](size_t i)
+    {
+        write_band(img, result.bands[i], result.image, pixel_size);
+    }, thread_count);
+    return result;
+}
@@ -0,0 +1,50 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <vector>
+#include <Yimage/Yimage.hpp>
+
+// The number of pixels added on each side of a piece of a band in the
+// atlas, so that linear filtering never reads pixels from other pieces.
+constexpr size_t LATITUDE_ATLAS_PADDING = 1;
+
+// A part of a band that is stored contiguously in the atlas.
+struct LatitudeBandPiece
+{
+    // The first column of the piece within the band.
+    size_t offset = 0;
+    // The position and width of the piece in the atlas, not including
+    // the padding.
+    size_t x = 0;
+    size_t y = 0;
+    size_t width = 0;
+};
+
+// A horizontal band of an equirectangular image. It is stored at a width
+// proportional to the cosine of its latitude closest to the equator, and
+// split into several pieces when it doesn't fit on one row of the atlas.
+struct LatitudeBand
+{
+    size_t first_row = 0;
+    size_t row_count = 0;
+    size_t width = 0;
+    std::vector<LatitudeBandPiece> pieces;
+};
+
+struct LatitudeAtlas
+{
+    Yimage::Image image;
+    std::vector<LatitudeBand> bands;
+};
+
+// Splits an equirectangular image into band_count bands of (nearly)
+// equal height and packs them into an atlas as wide as the image.
+[[nodiscard]]
+LatitudeAtlas make_latitude_atlas(const Yimage::Image& img,
+                                  size_t band_count,
+                                  unsigned thread_count = 0);
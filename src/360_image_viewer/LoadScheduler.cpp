@@ -0,0 +1,127 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "LoadScheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include "SpherePosCalculator.hpp"
+
+namespace
+{
+    constexpr auto PI = Xyz::Constants<double>::PI;
+
+    // The number of points sampled along each edge of the screen.
+    constexpr int EDGE_SAMPLES = 9;
+
+    // The polar angle of the top edge of row y in an image with the
+    // given height.
+    double get_row_polar(size_t y, size_t height)
+    {
+        return PI / 2 - PI * double(y) / double(height);
+    }
+
+    double get_distance(const ViewRegion& region, const RowRange& band,
+                        size_t height)
+    {
+        auto top = get_row_polar(band.first_row, height);
+        auto bottom = get_row_polar(band.first_row + band.row_count, height);
+        if (region.center_polar > top)
+            return region.center_polar - top;
+        if (region.center_polar < bottom)
+            return bottom - region.center_polar;
+        return 0;
+    }
+
+    bool is_visible(const ViewRegion& region, const RowRange& band,
+                    size_t height)
+    {
+        auto top = get_row_polar(band.first_row, height);
+        auto bottom = get_row_polar(band.first_row + band.row_count, height);
+        return bottom <= region.max_polar && top >= region.min_polar;
+    }
+}
+
+ViewRegion calc_view_region(const Xyz::Vector2D& screen_res,
+                            double view_angle,
+                            double azimuth, double polar)
+{
+    // The window's size is unknown until the first frame has been drawn.
+    SpherePosCalculator calculator;
+    calculator.set_screen_res(screen_res[0] > 0 && screen_res[1] > 0
+                              ? screen_res : Xyz::Vector2D(1, 1));
+    calculator.set_eye_dist(0.5);
+    calculator.set_view_angle(view_angle);
+    calculator.set_fixed_point({0, 0}, {1, azimuth, polar});
+
+    ViewRegion region{polar, polar, polar};
+    for (int i = 0; i < EDGE_SAMPLES; ++i)
+    {
+        auto t = 2.0 * i / (EDGE_SAMPLES - 1) - 1;
+        for (auto pos: {Xyz::Vector2D(t, -1), Xyz::Vector2D(t, 1),
+                        Xyz::Vector2D(-1, t), Xyz::Vector2D(1, t)})
+        {
+            auto p = calculator.calc_sphere_pos(pos);
+            region.min_polar = std::min(region.min_polar, p.polar);
+            region.max_polar = std::max(region.max_polar, p.polar);
+        }
+    }
+
+    // The edges don't reach a pole that is inside the view, but the
+    // view ray straight up or down passes it, and its azimuth flips.
+    for (auto y: {-1.0, 1.0})
+    {
+        auto p = calculator.calc_sphere_pos({0, y});
+        auto delta = std::remainder(p.azimuth - azimuth, 2 * PI);
+        if (std::abs(delta) > PI / 2)
+        {
+            if (y > 0)
+                region.max_polar = PI / 2;
+            else
+                region.min_polar = -PI / 2;
+        }
+    }
+    return region;
+}
+
+LoadOrder make_load_order(const ViewRegion& region,
+                          const std::vector<RowRange>& bands,
+                          size_t height)
+{
+    struct Entry
+    {
+        bool is_hidden;
+        double distance;
+        size_t index;
+    };
+
+    std::vector<Entry> entries;
+    entries.reserve(bands.size());
+    for (size_t i = 0; i < bands.size(); ++i)
+    {
+        entries.push_back({!is_visible(region, bands[i], height),
+                           get_distance(region, bands[i], height), i});
+    }
+    std::sort(entries.begin(), entries.end(), [](auto& a, auto& b)
+    {
+        if (a.is_hidden != b.is_hidden)
+            return b.is_hidden;
+        if (a.distance != b.distance)
+            return a.distance < b.distance;
+        return a.index < b.index;
+    });
+
+    LoadOrder order;
+    order.bands.reserve(entries.size());
+    for (auto& entry: entries)
+    {
+        order.bands.push_back(entry.index);
+        if (!entry.is_hidden)
+            ++order.visible_count;
+    }
+    return order;
+}
@@ -0,0 +1,51 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <Xyz/Xyz.hpp>
+
+// The range of polar angles, in radians, that is visible from a view.
+// Images are only decoded in bands of full rows, so the azimuth range
+// isn't needed.
+struct ViewRegion
+{
+    double min_polar = 0;
+    double max_polar = 0;
+    double center_polar = 0;
+};
+
+// Returns the part of the sphere that is visible when the center of the
+// screen is at azimuth and polar and the view angle is view_angle.
+[[nodiscard]]
+ViewRegion calc_view_region(const Xyz::Vector2D& screen_res,
+                            double view_angle,
+                            double azimuth, double polar);
+
+struct RowRange
+{
+    size_t first_row = 0;
+    size_t row_count = 0;
+};
+
+// The order in which the bands of an equirectangular image should be
+// loaded.
+struct LoadOrder
+{
+    // Indices into the bands, the visible ones first.
+    std::vector<size_t> bands;
+    size_t visible_count = 0;
+};
+
+// Orders bands, which are from an image with the given height, so that
+// those overlapping region come first, and the rest follow in order of
+// their angular distance from the region's center.
+[[nodiscard]]
+LoadOrder make_load_order(const ViewRegion& region,
+                          const std::vector<RowRange>& bands,
+                          size_t height);
@@ -0,0 +1,175 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "MarkerIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double PI = 3.14159265358979323846;
+    constexpr int GRID = MarkerIndex::GRID_SIZE;
+    constexpr size_t CELL_COUNT = 6 * GRID * GRID;
+
+    // The coordinates on a face are warped with atan so that the cells
+    // cover roughly the same area of the sphere.
+    double to_grid_coord(double t)
+    {
+        return std::atan(t) * 4 / PI;
+    }
+
+    double from_grid_coord(double g)
+    {
+        return std::tan(g * PI / 4);
+    }
+
+    // Face 0-2 are +X, +Y and +Z, face 3-5 are -X, -Y and -Z. u and v are
+    // the two other coordinates divided by the major one.
+    size_t get_cell(const Xyz::Vector3F& dir)
+    {
+        auto ax = std::abs(dir[0]), ay = std::abs(dir[1]), az = std::abs(dir[2]);
+        int axis = ax >= ay && ax >= az ? 0 : (ay >= az ? 1 : 2);
+        auto major = dir[axis];
+        auto face = size_t(axis + (major < 0 ? 3 : 0));
+        auto u = double(dir[(axis + 1) % 3]) / std::abs(major);
+        auto v = double(dir[(axis + 2) % 3]) / std::abs(major);
+        auto to_index = [](double t)
+        {
+            auto i = int((to_grid_coord(t) + 1) * 0.5 * GRID);
+            return size_t(std::clamp(i, 0, GRID - 1));
+        };
+        return (face * GRID + to_index(v)) * GRID + to_index(u);
+    }
+
+    Xyz::Vector3D get_face_point(size_t face, double gu, double gv)
+    {
+        auto axis = face % 3;
+        Xyz::Vector3D result;
+        result[axis] = face < 3 ? 1 : -1;
+        result[(axis + 1) % 3] = from_grid_coord(gu);
+        result[(axis + 2) % 3] = from_grid_coord(gv);
+        return Xyz::get_unit(result);
+    }
+
+    double get_angle(const Xyz::Vector3D& a, const Xyz::Vector3D& b)
+    {
+        return std::acos(std::clamp(Xyz::dot(a, b), -1.0, 1.0));
+    }
+}
+
+MarkerIndex::MarkerIndex()
+    : cell_starts_(CELL_COUNT + 1)
+{}
+
+MarkerIndex::MarkerIndex(const std::vector<Xyz::Vector3F>& directions)
+{
+    // Counting sort of the points by cell.
+    std::vector<uint32_t> cells(directions.size());
+    cell_starts_.assign(CELL_COUNT + 1, 0);
+    for (size_t i = 0; i < directions.size(); ++i)
+    {
+        cells[i] = uint32_t(get_cell(directions[i]));
+        ++cell_starts_[cells[i] + 1];
+    }
+    for (size_t i = 0; i < CELL_COUNT; ++i)
+        cell_starts_[i + 1] += cell_starts_[i];
+
+    positions_.resize(directions.size());
+    ids_.resize(directions.size());
+    auto next = cell_starts_;
+    for (size_t i = 0; i < directions.size(); ++i)
+    {
+        auto j = next[cells[i]]++;
+        positions_[j] = Xyz::get_unit(directions[i]);
+        ids_[j] = uint32_t(i);
+    }
+
+    cell_centers_.resize(CELL_COUNT);
+    for (size_t face = 0; face < 6; ++face)
+    {
+        for (int v = 0; v < GRID; ++v)
+        {
+            for (int u = 0; u < GRID; ++u)
+            {
+                auto to_grid = [](double i) {return 2 * i / GRID - 1;};
+                auto center = get_face_point(face, to_grid(u + 0.5),
+                                             to_grid(v + 0.5));
+                cell_centers_[(face * GRID + v) * GRID + u] = Xyz::vector_cast<float>(center);
+                for (auto [du, dv]: {std::pair(0, 0), {1, 0}, {0, 1}, {1, 1}})
+                {
+                    auto corner = get_face_point(face, to_grid(u + du),
+                                                 to_grid(v + dv));
+                    cell_radius_ = std::max(cell_radius_,
+                                            get_angle(center, corner));
+                }
+            }
+        }
+    }
+}
+
+size_t MarkerIndex::size() const
+{
+    return positions_.size();
+}
+
+const std::vector<Xyz::Vector3F>& MarkerIndex::positions() const
+{
+    return positions_;
+}
+
+const std::vector<uint32_t>& MarkerIndex::ids() const
+{
+    return ids_;
+}
+
+void MarkerIndex::find_ranges(const Xyz::Vector3D& direction, double angle,
+                              std::vector<Range>& ranges) const
+{
+    ranges.clear();
+    if (positions_.empty())
+        return;
+
+    auto dir = Xyz::vector_cast<float>(Xyz::get_unit(direction));
+    auto max_angle = angle + cell_radius_;
+    // Small margin for rounding errors in the float dot products.
+    auto min_dot = max_angle >= PI ? -2.0f : float(std::cos(max_angle)) - 1e-5f;
+    for (size_t i = 0; i < CELL_COUNT; ++i)
+    {
+        auto first = cell_starts_[i], end = cell_starts_[i + 1];
+        if (first == end || Xyz::dot(dir, cell_centers_[i]) < min_dot)
+            continue;
+        if (!ranges.empty() && ranges.back().second == first)
+            ranges.back().second = end;
+        else
+            ranges.emplace_back(first, end);
+    }
+}
+
+std::optional<size_t> MarkerIndex::find_nearest(const Xyz::Vector3D& direction,
+                                                double max_angle,
+                                                std::vector<Range>& ranges) const
+{
+    find_ranges(direction, max_angle, ranges);
+
+    auto dir = Xyz::vector_cast<float>(Xyz::get_unit(direction));
+    auto best_dot = float(std::cos(max_angle));
+    std::optional<size_t> result;
+    for (auto [first, end]: ranges)
+    {
+        for (auto i = first; i < end; ++i)
+        {
+            auto d = Xyz::dot(dir, positions_[i]);
+            if (d >= best_dot)
+            {
+                best_dot = d;
+                result = i;
+            }
+        }
+    }
+    return result;
+}
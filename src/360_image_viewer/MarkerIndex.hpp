@@ -0,0 +1,67 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <Xyz/Xyz.hpp>
+
+// A spatial index for points on the unit sphere. The sphere is divided
+// into the cells of a grid on each face of a cube, and the points are
+// sorted by cell. Cells that are next to each other on a row are
+// therefore also next to each other in positions(), which lets queries
+// return a few long ranges rather than one range per cell.
+class MarkerIndex
+{
+public:
+    // The number of cells along each edge of a cube face.
+    static constexpr int GRID_SIZE = 32;
+
+    using Range = std::pair<size_t, size_t>;
+
+    MarkerIndex();
+
+    // The directions need not be normalized.
+    explicit MarkerIndex(const std::vector<Xyz::Vector3F>& directions);
+
+    [[nodiscard]]
+    size_t size() const;
+
+    // The normalized directions sorted by cell.
+    [[nodiscard]]
+    const std::vector<Xyz::Vector3F>& positions() const;
+
+    // The index in the constructor's directions of each position.
+    [[nodiscard]]
+    const std::vector<uint32_t>& ids() const;
+
+    // Sets ranges to the ranges in positions() of the points in cells
+    // that are at least partially within angle radians of direction.
+    // The ranges can therefore include points that are further away.
+    void find_ranges(const Xyz::Vector3D& direction, double angle,
+                     std::vector<Range>& ranges) const;
+
+    // Returns the index in positions() of the point closest to
+    // direction, if any of them are within max_angle radians of it.
+    // ranges is only used as working memory, callers that keep it
+    // between calls avoid allocating memory.
+    [[nodiscard]]
+    std::optional<size_t> find_nearest(const Xyz::Vector3D& direction,
+                                       double max_angle,
+                                       std::vector<Range>& ranges) const;
+private:
+    std::vector<Xyz::Vector3F> positions_;
+    std::vector<uint32_t> ids_;
+    // cell_starts_[i] is the index in positions_ of the first point in
+    // cell i, the last entry is the number of points.
+    std::vector<uint32_t> cell_starts_;
+    std::vector<Xyz::Vector3F> cell_centers_;
+    // The largest angle between a cell center and its corners.
+    double cell_radius_ = 0;
+};
@@ -0,0 +1,28 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "MarkerShaderProgram.hpp"
+
+#include <Tungsten/ShaderProgramBuilder.hpp>
+#include "Marker-frag.glsl.hpp"
+#include "Marker-vert.glsl.hpp"
+
+void MarkerShaderProgram::setup()
+{
+    using namespace Tungsten;
+    program = ShaderProgramBuilder()
+        .add_shader(ShaderType::VERTEX, Marker_vert)
+        .add_shader(ShaderType::FRAGMENT, Marker_frag)
+        .build();
+
+    position = get_vertex_attribute(program, "a_position");
+
+    mv_matrix = get_uniform<Xyz::Matrix4F>(program, "u_mv_matrix");
+    p_matrix = get_uniform<Xyz::Matrix4F>(program, "u_p_matrix");
+    color = get_uniform<Xyz::Vector4F>(program, "u_color");
+    point_size = get_uniform<float>(program, "u_point_size");
+}
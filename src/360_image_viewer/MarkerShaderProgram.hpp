@@ -0,0 +1,24 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include "Tungsten/Tungsten.hpp"
+
+class MarkerShaderProgram
+{
+public:
+    void setup();
+
+    Tungsten::ProgramHandle program;
+
+    Tungsten::Uniform<Xyz::Matrix4F> mv_matrix;
+    Tungsten::Uniform<Xyz::Matrix4F> p_matrix;
+    Tungsten::Uniform<Xyz::Vector4F> color;
+    Tungsten::Uniform<float> point_size;
+
+    GLuint position;
+};
@@ -0,0 +1,81 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// WebAssembly builds only have threads if they are built with -pthread.
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    constexpr bool HAS_THREADS = false;
+#else
+    constexpr bool HAS_THREADS = true;
+#endif
+
+[[nodiscard]]
+inline unsigned get_default_thread_count()
+{
+    if constexpr (!HAS_THREADS)
+        return 1;
+    else
+        return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+// Calls func(i) for every i in [0, count) on up to thread_count threads,
+// including the calling thread. The first exception thrown by func is
+// rethrown after all threads have finished.
+template <typename Func>
+void parallel_for(size_t count, Func func, unsigned thread_count = 0)
+{
+    if (thread_count == 0)
+        thread_count = get_default_thread_count();
+    thread_count = unsigned(std::min<size_t>(thread_count, count));
+
+    if (thread_count <= 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+            func(i);
+        return;
+    }
+
+    std::atomic<size_t> next_index = 0;
+    std::exception_ptr exception;
+    std::mutex exception_mutex;
+
+    auto worker = [&]
+    {
+        for (auto i = next_index++; i < count; i = next_index++)
+        {
+            try
+            {
+                func(i);
+            }
+            catch (...)
+            {
+                std::lock_guard lock(exception_mutex);
+                if (!exception)
+                    exception = std::current_exception();
+                next_index = count;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (unsigned i = 1; i < thread_count; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for (auto& thread: threads)
+        thread.join();
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
@@ -0,0 +1,154 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "PixelKernels.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    void u8_to_f32_scalar(const uint8_t* src, float* dst, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = float(src[i]);
+    }
+
+    void f32_to_u8_scalar(const float* src, uint8_t* dst, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = uint8_t(std::clamp(src[i] + 0.5f, 0.0f, 255.0f));
+    }
+
+    void multiply_add_scalar(const float* src, float weight, float* dst,
+                             size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] += weight * src[i];
+    }
+
+    void rgb_to_rgba_scalar(const uint8_t* src, uint8_t* dst,
+                            size_t pixel_count)
+    {
+        for (size_t i = 0; i < pixel_count; ++i)
+        {
+            dst[4 * i] = src[3 * i];
+            dst[4 * i + 1] = src[3 * i + 1];
+            dst[4 * i + 2] = src[3 * i + 2];
+            dst[4 * i + 3] = 255;
+        }
+    }
+
+    void rgba_to_rgb_scalar(const uint8_t* src, uint8_t* dst,
+                            size_t pixel_count)
+    {
+        for (size_t i = 0; i < pixel_count; ++i)
+        {
+            dst[3 * i] = src[4 * i];
+            dst[3 * i + 1] = src[4 * i + 1];
+            dst[3 * i + 2] = src[4 * i + 2];
+        }
+    }
+
+    void mono_to_rgb_scalar(const uint8_t* src, uint8_t* dst,
+                            size_t pixel_count)
+    {
+        for (size_t i = 0; i < pixel_count; ++i)
+        {
+            dst[3 * i] = src[i];
+            dst[3 * i + 1] = src[i];
+            dst[3 * i + 2] = src[i];
+        }
+    }
+
+    void f32_to_f16_scalar(const float* src, uint16_t* dst, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint32_t bits;
+            memcpy(&bits, &src[i], sizeof(bits));
+            auto sign = uint16_t((bits >> 16u) & 0x8000u);
+            bits &= 0x7FFFFFFFu;
+            uint16_t half;
+            if (bits >= 0x47800000u)
+            {
+                // Too large, infinity or NaN.
+                half = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+            }
+            else if (bits < 0x38800000u)
+            {
+                // The result is subnormal or zero. Adding 0.5 moves the
+                // half float's mantissa to the lowest bits of the float's
+                // and lets the FPU do the rounding.
+                float f;
+                memcpy(&f, &bits, sizeof(f));
+                f += 0.5f;
+                memcpy(&bits, &f, sizeof(bits));
+                half = uint16_t(bits - 0x3F000000u);
+            }
+            else
+            {
+                // Rebias the exponent and round the mantissa, the carry
+                // propagates into the exponent where necessary.
+                auto is_odd = (bits >> 13u) & 1u;
+                half = uint16_t((bits + 0xC8000FFFu + is_odd) >> 13u);
+            }
+            dst[i] = half | sign;
+        }
+    }
+
+    constexpr PixelKernels SCALAR_KERNELS = {
+        "scalar",
+        u8_to_f32_scalar,
+        f32_to_u8_scalar,
+        multiply_add_scalar,
+        rgb_to_rgba_scalar,
+        rgba_to_rgb_scalar,
+        mono_to_rgb_scalar,
+        f32_to_f16_scalar
+    };
+
+    bool is_supported(const char* feature)
+    {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+        if (strcmp(feature, "sse4.2") == 0)
+            return __builtin_cpu_supports("sse4.2");
+        if (strcmp(feature, "avx2") == 0)
+            return __builtin_cpu_supports("avx2");
+        return false;
+#else
+        // The NEON and WebAssembly backends are only compiled in when
+        // the target is guaranteed to support them.
+        return true;
+#endif
+    }
+
+    std::vector<const PixelKernels*> find_available_kernels()
+    {
+        std::vector<const PixelKernels*> result{&SCALAR_KERNELS};
+        if (auto k = Detail::get_sse42_pixel_kernels(); k && is_supported("sse4.2"))
+            result.push_back(k);
+        if (auto k = Detail::get_avx2_pixel_kernels(); k && is_supported("avx2"))
+            result.push_back(k);
+        if (auto k = Detail::get_neon_pixel_kernels())
+            result.push_back(k);
+        if (auto k = Detail::get_wasm_pixel_kernels())
+            result.push_back(k);
+        return result;
+    }
+}
+
+const PixelKernels& get_pixel_kernels()
+{
+    static const PixelKernels* kernels = find_available_kernels().back();
+    return *kernels;
+}
+
+std::vector<const PixelKernels*> get_available_pixel_kernels()
+{
+    return find_available_kernels();
+}
@@ -0,0 +1,56 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// The inner loops of the CPU image processing. There is one set of
+// kernels per instruction set, get_pixel_kernels returns the best one
+// the CPU supports.
+//
+// The backends are compiled in separate files with their own compiler
+// flags. They must not use inline functions or templates from headers
+// they share with the rest of the program, as the linker might then pick
+// a version that requires instructions the CPU doesn't have.
+struct PixelKernels
+{
+    const char* name;
+    // dst[i] = src[i]
+    void (*u8_to_f32)(const uint8_t* src, float* dst, size_t count);
+    // dst[i] = src[i] + 0.5 clamped to [0, 255] and truncated.
+    void (*f32_to_u8)(const float* src, uint8_t* dst, size_t count);
+    // dst[i] += weight * src[i], rounding the product before the addition.
+    void (*multiply_add)(const float* src, float weight, float* dst,
+                         size_t count);
+    // Copies RGB pixels to RGBA pixels with alpha 255.
+    void (*rgb_to_rgba)(const uint8_t* src, uint8_t* dst, size_t pixel_count);
+    // Copies RGBA pixels to RGB pixels, dropping the alpha channel.
+    void (*rgba_to_rgb)(const uint8_t* src, uint8_t* dst, size_t pixel_count);
+    // Copies gray values to the red, green and blue channels of RGB pixels.
+    void (*mono_to_rgb)(const uint8_t* src, uint8_t* dst, size_t pixel_count);
+    // Converts to IEEE half floats, rounding to nearest even. Values too
+    // large for a half float become infinity.
+    void (*f32_to_f16)(const float* src, uint16_t* dst, size_t count);
+};
+
+[[nodiscard]]
+const PixelKernels& get_pixel_kernels();
+
+// Returns all kernels that can run on this CPU, the scalar ones first.
+[[nodiscard]]
+std::vector<const PixelKernels*> get_available_pixel_kernels();
+
+namespace Detail
+{
+    // Each of these returns nullptr if the backend isn't compiled in.
+    [[nodiscard]] const PixelKernels* get_sse42_pixel_kernels();
+    [[nodiscard]] const PixelKernels* get_avx2_pixel_kernels();
+    [[nodiscard]] const PixelKernels* get_neon_pixel_kernels();
+    [[nodiscard]] const PixelKernels* get_wasm_pixel_kernels();
+}
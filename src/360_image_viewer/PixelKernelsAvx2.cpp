@@ -0,0 +1,241 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "PixelKernels.hpp"
+
+#ifdef __AVX2__
+
+#include <cstring>
+#include <immintrin.h>
+
+namespace
+{
+    void u8_to_f32_avx2(const uint8_t* src, float* dst, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            auto bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+            auto v = _mm256_cvtepu8_epi32(bytes);
+            _mm256_storeu_ps(dst + i, _mm256_cvtepi32_ps(v));
+        }
+        for (; i < count; ++i)
+            dst[i] = float(src[i]);
+    }
+
+    void f32_to_u8_avx2(const float* src, uint8_t* dst, size_t count)
+    {
+        const auto half = _mm256_set1_ps(0.5f);
+        const auto zero = _mm256_setzero_ps();
+        const auto max = _mm256_set1_ps(255.0f);
+        auto convert = [&](const float* s)
+        {
+            auto v = _mm256_add_ps(_mm256_loadu_ps(s), half);
+            v = _mm256_min_ps(_mm256_max_ps(v, zero), max);
+            return _mm256_cvttps_epi32(v);
+        };
+
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32)
+        {
+            // The packs work within 128-bit lanes, the permutation
+            // restores the order of the bytes.
+            auto a = _mm256_packus_epi32(convert(src + i), convert(src + i + 8));
+            auto b = _mm256_packus_epi32(convert(src + i + 16), convert(src + i + 24));
+            auto v = _mm256_packus_epi16(a, b);
+            v = _mm256_permutevar8x32_epi32(
+                v, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+        }
+        for (; i < count; ++i)
+        {
+            float v = src[i] + 0.5f;
+            v = v < 0.0f ? 0.0f : (v > 255.0f ? 255.0f : v);
+            dst[i] = uint8_t(v);
+        }
+    }
+
+    void multiply_add_avx2(const float* src, float weight, float* dst,
+                           size_t count)
+    {
+        const auto w = _mm256_set1_ps(weight);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            auto v = _mm256_mul_ps(w, _mm256_loadu_ps(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), v));
+        }
+        for (; i < count; ++i)
+            dst[i] += weight * src[i];
+    }
+
+    void rgb_to_rgba_avx2(const uint8_t* src, uint8_t* dst,
+                          size_t pixel_count)
+    {
+        const auto shuffle = _mm256_setr_epi8(
+            0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+            0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const auto alpha = _mm256_set1_epi32(int32_t(0xFF000000));
+        size_t i = 0;
+        // Each iteration reads 28 bytes, but only uses 24 of them.
+        for (; i + 10 <= pixel_count; i += 8)
+        {
+            auto s = src + 3 * i;
+            auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 12));
+            auto v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+            v = _mm256_or_si256(_mm256_shuffle_epi8(v, shuffle), alpha);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), v);
+        }
+        for (; i < pixel_count; ++i)
+        {
+            dst[4 * i] = src[3 * i];
+            dst[4 * i + 1] = src[3 * i + 1];
+            dst[4 * i + 2] = src[3 * i + 2];
+            dst[4 * i + 3] = 255;
+        }
+    }
+
+    void rgba_to_rgb_avx2(const uint8_t* src, uint8_t* dst,
+                          size_t pixel_count)
+    {
+        const auto shuffle = _mm256_setr_epi8(
+            0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+            0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        // Moves the 12 bytes from the upper lane next to those from the
+        // lower one.
+        const auto permutation = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+        size_t i = 0;
+        // Each iteration writes 32 bytes, the last 8 of them are
+        // overwritten by the next iteration.
+        for (; i + 11 <= pixel_count; i += 8)
+        {
+            auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+            v = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, shuffle),
+                                            permutation);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 3 * i), v);
+        }
+        for (; i < pixel_count; ++i)
+        {
+            dst[3 * i] = src[4 * i];
+            dst[3 * i + 1] = src[4 * i + 1];
+            dst[3 * i + 2] = src[4 * i + 2];
+        }
+    }
+
+    void mono_to_rgb_avx2(const uint8_t* src, uint8_t* dst,
+                          size_t pixel_count)
+    {
+        // The shuffles only move bytes within 128-bit lanes, both lanes
+        // therefore get a copy of the 16 source bytes.
+        const auto shuffle01 = _mm256_setr_epi8(
+            0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4, 5,
+            5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10);
+        const auto shuffle2 = _mm_setr_epi8(10, 11, 11, 11, 12, 12, 12, 13,
+                                            13, 13, 14, 14, 14, 15, 15, 15);
+        size_t i = 0;
+        for (; i + 16 <= pixel_count; i += 16)
+        {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            auto v2 = _mm256_broadcastsi128_si256(v);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 3 * i),
+                                _mm256_shuffle_epi8(v2, shuffle01));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * i + 32),
+                             _mm_shuffle_epi8(v, shuffle2));
+        }
+        for (; i < pixel_count; ++i)
+        {
+            dst[3 * i] = src[i];
+            dst[3 * i + 1] = src[i];
+            dst[3 * i + 2] = src[i];
+        }
+    }
+
+    // The eight-lane version of to_f16_sse42. F16C's _mm256_cvtps_ph
+    // would be simpler, but -mavx2 doesn't enable it.
+    __m256i to_f16_avx2(__m256 f)
+    {
+        const auto sign_mask = _mm256_set1_ps(-0.0f);
+        const auto f16_max = _mm256_set1_epi32(0x47800000);
+        const auto min_normal = _mm256_set1_epi32(0x38800000);
+        const auto subnormal_magic = _mm256_set1_epi32(0x3F000000);
+        const auto normal_bias = _mm256_set1_epi32(int32_t(0xC8000FFFu));
+
+        auto sign = _mm256_and_ps(f, sign_mask);
+        auto abs_f = _mm256_xor_ps(f, sign);
+        auto abs_i = _mm256_castps_si256(abs_f);
+        auto is_nan = _mm256_castps_si256(_mm256_cmp_ps(abs_f, abs_f, _CMP_UNORD_Q));
+        auto special = _mm256_or_si256(
+            _mm256_and_si256(is_nan, _mm256_set1_epi32(0x200)),
+            _mm256_set1_epi32(0x7C00));
+        auto is_regular = _mm256_cmpgt_epi32(f16_max, abs_i);
+        auto is_subnormal = _mm256_cmpgt_epi32(min_normal, abs_i);
+
+        auto subnormal = _mm256_sub_epi32(
+            _mm256_castps_si256(_mm256_add_ps(abs_f, _mm256_castsi256_ps(subnormal_magic))),
+            subnormal_magic);
+        auto is_odd = _mm256_srai_epi32(_mm256_slli_epi32(abs_i, 18), 31);
+        auto normal = _mm256_srli_epi32(
+            _mm256_sub_epi32(_mm256_add_epi32(abs_i, normal_bias), is_odd), 13);
+
+        auto result = _mm256_blendv_epi8(normal, subnormal, is_subnormal);
+        result = _mm256_blendv_epi8(special, result, is_regular);
+        return _mm256_or_si256(result,
+                               _mm256_srai_epi32(_mm256_castps_si256(sign), 16));
+    }
+
+    // The pack works within 128-bit lanes, the permutation restores the
+    // order of the values.
+    __m256i pack_f16_avx2(const float* src)
+    {
+        auto v = _mm256_packs_epi32(to_f16_avx2(_mm256_loadu_ps(src)),
+                                    to_f16_avx2(_mm256_loadu_ps(src + 8)));
+        return _mm256_permute4x64_epi64(v, 0xD8);
+    }
+
+    void f32_to_f16_avx2(const float* src, uint16_t* dst, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                                pack_f16_avx2(src + i));
+        if (i < count)
+        {
+            float tail[16] = {};
+            uint16_t result[16];
+            memcpy(tail, src + i, (count - i) * sizeof(float));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(result),
+                                pack_f16_avx2(tail));
+            memcpy(dst + i, result, (count - i) * sizeof(uint16_t));
+        }
+    }
+
+    constexpr PixelKernels AVX2_KERNELS = {
+        "avx2",
+        u8_to_f32_avx2,
+        f32_to_u8_avx2,
+        multiply_add_avx2,
+        rgb_to_rgba_avx2,
+        rgba_to_rgb_avx2,
+        mono_to_rgb_avx2,
+        f32_to_f16_avx2
+    };
+}
+
+const PixelKernels* Detail::get_avx2_pixel_kernels()
+{
+    return &AVX2_KERNELS;
+}
+
+#else
+
+const PixelKernels* Detail::get_avx2_pixel_kernels()
+{
+    return nullptr;
+}
+
+#endif
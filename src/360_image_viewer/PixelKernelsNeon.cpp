@@ -0,0 +1,164 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "PixelKernels.hpp"
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+
+#include <cstring>
+#include <arm_neon.h>
+
+namespace
+{
+    void u8_to_f32_neon(const uint8_t* src, float* dst, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            auto v = vmovl_u8(vld1_u8(src + i));
+            vst1q_f32(dst + i, vcvtq_f32_u32(vmovl_u16(vget_low_u16(v))));
+            vst1q_f32(dst + i + 4, vcvtq_f32_u32(vmovl_u16(vget_high_u16(v))));
+        }
+        for (; i < count; ++i)
+            dst[i] = float(src[i]);
+    }
+
+    void f32_to_u8_neon(const float* src, uint8_t* dst, size_t count)
+    {
+        const auto half = vdupq_n_f32(0.5f);
+        const auto zero = vdupq_n_f32(0.0f);
+        const auto max = vdupq_n_f32(255.0f);
+        auto convert = [&](const float* s)
+        {
+            auto v = vaddq_f32(vld1q_f32(s), half);
+            v = vminq_f32(vmaxq_f32(v, zero), max);
+            return vmovn_u32(vcvtq_u32_f32(v));
+        };
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            auto v = vcombine_u16(convert(src + i), convert(src + i + 4));
+            vst1_u8(dst + i, vmovn_u16(v));
+        }
+        for (; i < count; ++i)
+        {
+            float v = src[i] + 0.5f;
+            v = v < 0.0f ? 0.0f : (v > 255.0f ? 255.0f : v);
+            dst[i] = uint8_t(v);
+        }
+    }
+
+    void multiply_add_neon(const float* src, float weight, float* dst,
+                           size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            auto v = vmulq_n_f32(vld1q_f32(src + i), weight);
+            vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), v));
+        }
+        for (; i < count; ++i)
+            dst[i] += weight * src[i];
+    }
+
+    void rgb_to_rgba_neon(const uint8_t* src, uint8_t* dst,
+                          size_t pixel_count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= pixel_count; i += 16)
+        {
+            auto rgb = vld3q_u8(src + 3 * i);
+            uint8x16x4_t rgba = {{rgb.val[0], rgb.val[1], rgb.val[2],
+                                  vdupq_n_u8(255)}};
+            vst4q_u8(dst + 4 * i, rgba);
+        }
+        for (; i < pixel_count; ++i)
+        {
+            dst[4 * i] = src[3 * i];
+            dst[4 * i + 1] = src[3 * i + 1];
+            dst[4 * i + 2] = src[3 * i + 2];
+            dst[4 * i + 3] = 255;
+        }
+    }
+
+    void rgba_to_rgb_neon(const uint8_t* src, uint8_t* dst,
+                          size_t pixel_count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= pixel_count; i += 16)
+        {
+            auto rgba = vld4q_u8(src + 4 * i);
+            uint8x16x3_t rgb = {{rgba.val[0], rgba.val[1], rgba.val[2]}};
+            vst3q_u8(dst + 3 * i, rgb);
+        }
+        for (; i < pixel_count; ++i)
+        {
+            dst[3 * i] = src[4 * i];
+            dst[3 * i + 1] = src[4 * i + 1];
+            dst[3 * i + 2] = src[4 * i + 2];
+        }
+    }
+
+    void mono_to_rgb_neon(const uint8_t* src, uint8_t* dst,
+                          size_t pixel_count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= pixel_count; i += 16)
+        {
+            auto gray = vld1q_u8(src + i);
+            uint8x16x3_t rgb = {{gray, gray, gray}};
+            vst3q_u8(dst + 3 * i, rgb);
+        }
+        for (; i < pixel_count; ++i)
+        {
+            dst[3 * i] = src[i];
+            dst[3 * i + 1] = src[i];
+            dst[3 * i + 2] = src[i];
+        }
+    }
+
+    void f32_to_f16_neon(const float* src, uint16_t* dst, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+        if (i < count)
+        {
+            float tail[4] = {};
+            uint16_t result[4];
+            memcpy(tail, src + i, (count - i) * sizeof(float));
+            vst1_u16(result, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(tail))));
+            memcpy(dst + i, result, (count - i) * sizeof(uint16_t));
+        }
+    }
+
+    constexpr PixelKernels NEON_KERNELS = {
+        "neon",
+        u8_to_f32_neon,
+        f32_to_u8_neon,
+        multiply_add_neon,
+        rgb_to_rgba_neon,
+        rgba_to_rgb_neon,
+        mono_to_rgb_neon,
+        f32_to_f16_neon
+    };
+}
+
+const PixelKernels* Detail::get_neon_pixel_kernels()
+{
+    return &NEON_KERNELS;
+}
+
+#else
+
+const PixelKernels* Detail::get_neon_pixel_kernels()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,223 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "PixelKernels.hpp"
+
+#ifdef __SSE4_2__
+
+#include <cstring>
+#include <nmmintrin.h>
+
+namespace
+{
+    void u8_to_f32_sse42(const uint8_t* src, float* dst, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            int32_t bytes;
+            __builtin_memcpy(&bytes, src + i, 4);
+            auto v = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes));
+            _mm_storeu_ps(dst + i, _mm_cvtepi32_ps(v));
+        }
+        for (; i < count; ++i)
+            dst[i] = float(src[i]);
+    }
+
+    void f32_to_u8_sse42(const float* src, uint8_t* dst, size_t count)
+    {
+        const auto half = _mm_set1_ps(0.5f);
+        const auto zero = _mm_setzero_ps();
+        const auto max = _mm_set1_ps(255.0f);
+        auto convert = [&](const float* s)
+        {
+            auto v = _mm_add_ps(_mm_loadu_ps(s), half);
+            v = _mm_min_ps(_mm_max_ps(v, zero), max);
+            return _mm_cvttps_epi32(v);
+        };
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            auto a = _mm_packus_epi32(convert(src + i), convert(src + i + 4));
+            auto b = _mm_packus_epi32(convert(src + i + 8), convert(src + i + 12));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                             _mm_packus_epi16(a, b));
+        }
+        for (; i < count; ++i)
+        {
+            float v = src[i] + 0.5f;
+            v = v < 0.0f ? 0.0f : (v > 255.0f ? 255.0f : v);
+            dst[i] = uint8_t(v);
+        }
+    }
+
+    void multiply_add_sse42(const float* src, float weight, float* dst,
+                            size_t count)
+    {
+        const auto w = _mm_set1_ps(weight);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            auto v = _mm_mul_ps(w, _mm_loadu_ps(src + i));
+            _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), v));
+        }
+        for (; i < count; ++i)
+            dst[i] += weight * src[i];
+    }
+
+    void rgb_to_rgba_sse42(const uint8_t* src, uint8_t* dst,
+                           size_t pixel_count)
+    {
+        const auto shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1,
+                                           6, 7, 8, -1, 9, 10, 11, -1);
+        const auto alpha = _mm_set1_epi32(int32_t(0xFF000000));
+        size_t i = 0;
+        // Each iteration reads 16 bytes, but only uses 12 of them.
+        for (; i + 6 <= pixel_count; i += 4)
+        {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * i));
+            v = _mm_or_si128(_mm_shuffle_epi8(v, shuffle), alpha);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), v);
+        }
+        for (; i < pixel_count; ++i)
+        {
+            dst[4 * i] = src[3 * i];
+            dst[4 * i + 1] = src[3 * i + 1];
+            dst[4 * i + 2] = src[3 * i + 2];
+            dst[4 * i + 3] = 255;
+        }
+    }
+
+    void rgba_to_rgb_sse42(const uint8_t* src, uint8_t* dst,
+                           size_t pixel_count)
+    {
+        const auto shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9,
+                                           10, 12, 13, 14, -1, -1, -1, -1);
+        size_t i = 0;
+        // Each iteration writes 16 bytes, the last 4 of them are
+        // overwritten by the next iteration.
+        for (; i + 6 <= pixel_count; i += 4)
+        {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * i),
+                             _mm_shuffle_epi8(v, shuffle));
+        }
+        for (; i < pixel_count; ++i)
+        {
+            dst[3 * i] = src[4 * i];
+            dst[3 * i + 1] = src[4 * i + 1];
+            dst[3 * i + 2] = src[4 * i + 2];
+        }
+    }
+
+    void mono_to_rgb_sse42(const uint8_t* src, uint8_t* dst,
+                           size_t pixel_count)
+    {
+        const auto shuffle0 = _mm_setr_epi8(0, 0, 0, 1, 1, 1, 2, 2,
+                                            2, 3, 3, 3, 4, 4, 4, 5);
+        const auto shuffle1 = _mm_setr_epi8(5, 5, 6, 6, 6, 7, 7, 7,
+                                            8, 8, 8, 9, 9, 9, 10, 10);
+        const auto shuffle2 = _mm_setr_epi8(10, 11, 11, 11, 12, 12, 12, 13,
+                                            13, 13, 14, 14, 14, 15, 15, 15);
+        size_t i = 0;
+        for (; i + 16 <= pixel_count; i += 16)
+        {
+            auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            auto d = reinterpret_cast<__m128i*>(dst + 3 * i);
+            _mm_storeu_si128(d, _mm_shuffle_epi8(v, shuffle0));
+            _mm_storeu_si128(d + 1, _mm_shuffle_epi8(v, shuffle1));
+            _mm_storeu_si128(d + 2, _mm_shuffle_epi8(v, shuffle2));
+        }
+        for (; i < pixel_count; ++i)
+        {
+            dst[3 * i] = src[i];
+            dst[3 * i + 1] = src[i];
+            dst[3 * i + 2] = src[i];
+        }
+    }
+
+    // Converts four floats to half floats in the low 16 bits of each
+    // 32-bit lane. The upper bits are copies of the sign bit, which lets
+    // the signed pack instructions narrow the lanes without saturating.
+    __m128i to_f16_sse42(__m128 f)
+    {
+        const auto sign_mask = _mm_set1_ps(-0.0f);
+        const auto f16_max = _mm_set1_epi32(0x47800000);
+        const auto min_normal = _mm_set1_epi32(0x38800000);
+        const auto subnormal_magic = _mm_set1_epi32(0x3F000000);
+        const auto normal_bias = _mm_set1_epi32(int32_t(0xC8000FFFu));
+
+        auto sign = _mm_and_ps(f, sign_mask);
+        auto abs_f = _mm_xor_ps(f, sign);
+        auto abs_i = _mm_castps_si128(abs_f);
+        auto is_nan = _mm_castps_si128(_mm_cmpunord_ps(abs_f, abs_f));
+        auto special = _mm_or_si128(_mm_and_si128(is_nan, _mm_set1_epi32(0x200)),
+                                    _mm_set1_epi32(0x7C00));
+        auto is_regular = _mm_cmpgt_epi32(f16_max, abs_i);
+        auto is_subnormal = _mm_cmpgt_epi32(min_normal, abs_i);
+
+        auto subnormal = _mm_sub_epi32(
+            _mm_castps_si128(_mm_add_ps(abs_f, _mm_castsi128_ps(subnormal_magic))),
+            subnormal_magic);
+        auto is_odd = _mm_srai_epi32(_mm_slli_epi32(abs_i, 18), 31);
+        auto normal = _mm_srli_epi32(
+            _mm_sub_epi32(_mm_add_epi32(abs_i, normal_bias), is_odd), 13);
+
+        auto result = _mm_blendv_epi8(normal, subnormal, is_subnormal);
+        result = _mm_blendv_epi8(special, result, is_regular);
+        return _mm_or_si128(result, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+    }
+
+    void f32_to_f16_sse42(const float* src, uint16_t* dst, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            auto v = _mm_packs_epi32(to_f16_sse42(_mm_loadu_ps(src + i)),
+                                     to_f16_sse42(_mm_loadu_ps(src + i + 4)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+        }
+        // Convert the tail via a padded buffer rather than duplicating the
+        // scalar code.
+        if (i < count)
+        {
+            float tail[8] = {};
+            uint16_t result[8];
+            memcpy(tail, src + i, (count - i) * sizeof(float));
+            auto v = _mm_packs_epi32(to_f16_sse42(_mm_loadu_ps(tail)),
+                                     to_f16_sse42(_mm_loadu_ps(tail + 4)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(result), v);
+            memcpy(dst + i, result, (count - i) * sizeof(uint16_t));
+        }
+    }
+
+    constexpr PixelKernels SSE42_KERNELS = {
+        "sse4.2",
+        u8_to_f32_sse42,
+        f32_to_u8_sse42,
+        multiply_add_sse42,
+        rgb_to_rgba_sse42,
+        rgba_to_rgb_sse42,
+        mono_to_rgb_sse42,
+        f32_to_f16_sse42
+    };
+}
+
+const PixelKernels* Detail::get_sse42_pixel_kernels()
+{
+    return &SSE42_KERNELS;
+}
+
+#else
+
+const PixelKernels* Detail::get_sse42_pixel_kernels()
+{
+    return nullptr;
+}
+
+#endif
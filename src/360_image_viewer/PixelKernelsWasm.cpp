@@ -0,0 +1,219 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "PixelKernels.hpp"
+
+#ifdef __wasm_simd128__
+
+#include <cstring>
+#include <wasm_simd128.h>
+
+namespace
+{
+    void u8_to_f32_wasm(const uint8_t* src, float* dst, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            auto v = wasm_u16x8_load8x8(src + i);
+            wasm_v128_store(dst + i, wasm_f32x4_convert_u32x4(
+                wasm_u32x4_extend_low_u16x8(v)));
+            wasm_v128_store(dst + i + 4, wasm_f32x4_convert_u32x4(
+                wasm_u32x4_extend_high_u16x8(v)));
+        }
+        for (; i < count; ++i)
+            dst[i] = float(src[i]);
+    }
+
+    void f32_to_u8_wasm(const float* src, uint8_t* dst, size_t count)
+    {
+        const auto half = wasm_f32x4_splat(0.5f);
+        const auto zero = wasm_f32x4_splat(0.0f);
+        const auto max = wasm_f32x4_splat(255.0f);
+        auto convert = [&](const float* s)
+        {
+            auto v = wasm_f32x4_add(wasm_v128_load(s), half);
+            v = wasm_f32x4_pmin(wasm_f32x4_pmax(v, zero), max);
+            return wasm_i32x4_trunc_sat_f32x4(v);
+        };
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            auto a = wasm_u16x8_narrow_i32x4(convert(src + i),
+                                             convert(src + i + 4));
+            auto b = wasm_u16x8_narrow_i32x4(convert(src + i + 8),
+                                             convert(src + i + 12));
+            wasm_v128_store(dst + i, wasm_u8x16_narrow_i16x8(a, b));
+        }
+        for (; i < count; ++i)
+        {
+            float v = src[i] + 0.5f;
+            v = v < 0.0f ? 0.0f : (v > 255.0f ? 255.0f : v);
+            dst[i] = uint8_t(v);
+        }
+    }
+
+    void multiply_add_wasm(const float* src, float weight, float* dst,
+                           size_t count)
+    {
+        const auto w = wasm_f32x4_splat(weight);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            auto v = wasm_f32x4_mul(w, wasm_v128_load(src + i));
+            wasm_v128_store(dst + i, wasm_f32x4_add(wasm_v128_load(dst + i), v));
+        }
+        for (; i < count; ++i)
+            dst[i] += weight * src[i];
+    }
+
+    void rgb_to_rgba_wasm(const uint8_t* src, uint8_t* dst,
+                          size_t pixel_count)
+    {
+        // Indices outside [0, 15] make the swizzle return 0.
+        const auto shuffle = wasm_i8x16_make(0, 1, 2, -1, 3, 4, 5, -1,
+                                             6, 7, 8, -1, 9, 10, 11, -1);
+        const auto alpha = wasm_i32x4_splat(int32_t(0xFF000000));
+        size_t i = 0;
+        // Each iteration reads 16 bytes, but only uses 12 of them.
+        for (; i + 6 <= pixel_count; i += 4)
+        {
+            auto v = wasm_i8x16_swizzle(wasm_v128_load(src + 3 * i), shuffle);
+            wasm_v128_store(dst + 4 * i, wasm_v128_or(v, alpha));
+        }
+        for (; i < pixel_count; ++i)
+        {
+            dst[4 * i] = src[3 * i];
+            dst[4 * i + 1] = src[3 * i + 1];
+            dst[4 * i + 2] = src[3 * i + 2];
+            dst[4 * i + 3] = 255;
+        }
+    }
+
+    void rgba_to_rgb_wasm(const uint8_t* src, uint8_t* dst,
+                          size_t pixel_count)
+    {
+        const auto shuffle = wasm_i8x16_make(0, 1, 2, 4, 5, 6, 8, 9,
+                                             10, 12, 13, 14, -1, -1, -1, -1);
+        size_t i = 0;
+        // Each iteration writes 16 bytes, the last 4 of them are
+        // overwritten by the next iteration.
+        for (; i + 6 <= pixel_count; i += 4)
+        {
+            auto v = wasm_i8x16_swizzle(wasm_v128_load(src + 4 * i), shuffle);
+            wasm_v128_store(dst + 3 * i, v);
+        }
+        for (; i < pixel_count; ++i)
+        {
+            dst[3 * i] = src[4 * i];
+            dst[3 * i + 1] = src[4 * i + 1];
+            dst[3 * i + 2] = src[4 * i + 2];
+        }
+    }
+
+    void mono_to_rgb_wasm(const uint8_t* src, uint8_t* dst,
+                          size_t pixel_count)
+    {
+        const auto shuffle0 = wasm_i8x16_make(0, 0, 0, 1, 1, 1, 2, 2,
+                                              2, 3, 3, 3, 4, 4, 4, 5);
+        const auto shuffle1 = wasm_i8x16_make(5, 5, 6, 6, 6, 7, 7, 7,
+                                              8, 8, 8, 9, 9, 9, 10, 10);
+        const auto shuffle2 = wasm_i8x16_make(10, 11, 11, 11, 12, 12, 12, 13,
+                                              13, 13, 14, 14, 14, 15, 15, 15);
+        size_t i = 0;
+        for (; i + 16 <= pixel_count; i += 16)
+        {
+            auto v = wasm_v128_load(src + i);
+            auto d = dst + 3 * i;
+            wasm_v128_store(d, wasm_i8x16_swizzle(v, shuffle0));
+            wasm_v128_store(d + 16, wasm_i8x16_swizzle(v, shuffle1));
+            wasm_v128_store(d + 32, wasm_i8x16_swizzle(v, shuffle2));
+        }
+        for (; i < pixel_count; ++i)
+        {
+            dst[3 * i] = src[i];
+            dst[3 * i + 1] = src[i];
+            dst[3 * i + 2] = src[i];
+        }
+    }
+
+    // WebAssembly has no half-float conversion, this does the same bit
+    // manipulation as to_f16_sse42.
+    v128_t to_f16_wasm(v128_t f)
+    {
+        const auto sign_mask = wasm_i32x4_splat(int32_t(0x80000000u));
+        const auto f16_max = wasm_i32x4_splat(0x47800000);
+        const auto min_normal = wasm_i32x4_splat(0x38800000);
+        const auto subnormal_magic = wasm_i32x4_splat(0x3F000000);
+        const auto normal_bias = wasm_i32x4_splat(int32_t(0xC8000FFFu));
+
+        auto sign = wasm_v128_and(f, sign_mask);
+        auto abs_f = wasm_v128_xor(f, sign);
+        auto is_nan = wasm_f32x4_ne(abs_f, abs_f);
+        auto special = wasm_v128_or(wasm_v128_and(is_nan, wasm_i32x4_splat(0x200)),
+                                    wasm_i32x4_splat(0x7C00));
+        auto is_regular = wasm_i32x4_gt(f16_max, abs_f);
+        auto is_subnormal = wasm_i32x4_gt(min_normal, abs_f);
+
+        auto subnormal = wasm_i32x4_sub(wasm_f32x4_add(abs_f, subnormal_magic),
+                                        subnormal_magic);
+        auto is_odd = wasm_i32x4_shr(wasm_i32x4_shl(abs_f, 18), 31);
+        auto normal = wasm_u32x4_shr(
+            wasm_i32x4_sub(wasm_i32x4_add(abs_f, normal_bias), is_odd), 13);
+
+        auto result = wasm_v128_bitselect(subnormal, normal, is_subnormal);
+        result = wasm_v128_bitselect(result, special, is_regular);
+        return wasm_v128_or(result, wasm_i32x4_shr(sign, 16));
+    }
+
+    void f32_to_f16_wasm(const float* src, uint16_t* dst, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            auto v = wasm_i16x8_narrow_i32x4(to_f16_wasm(wasm_v128_load(src + i)),
+                                             to_f16_wasm(wasm_v128_load(src + i + 4)));
+            wasm_v128_store(dst + i, v);
+        }
+        if (i < count)
+        {
+            float tail[8] = {};
+            uint16_t result[8];
+            memcpy(tail, src + i, (count - i) * sizeof(float));
+            auto v = wasm_i16x8_narrow_i32x4(to_f16_wasm(wasm_v128_load(tail)),
+                                             to_f16_wasm(wasm_v128_load(tail + 4)));
+            wasm_v128_store(result, v);
+            memcpy(dst + i, result, (count - i) * sizeof(uint16_t));
+        }
+    }
+
+    constexpr PixelKernels WASM_KERNELS = {
+        "wasm-simd",
+        u8_to_f32_wasm,
+        f32_to_u8_wasm,
+        multiply_add_wasm,
+        rgb_to_rgba_wasm,
+        rgba_to_rgb_wasm,
+        mono_to_rgb_wasm,
+        f32_to_f16_wasm
+    };
+}
+
+const PixelKernels* Detail::get_wasm_pixel_kernels()
+{
+    return &WASM_KERNELS;
+}
+
+#else
+
+const PixelKernels* Detail::get_wasm_pixel_kernels()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,216 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include "SpherePosCalculator.hpp"
+
+// The output projections of reproject(). Each one maps a screen position,
+// with both coordinates in [-1, 1] and y pointing up, to a direction from
+// the sphere's center. The directions aren't necessarily normalized.
+//
+// Everything a projection needs per pixel is computed in its constructor,
+// and calc_direction is defined here so it can be inlined in the loop
+// that renders the image.
+
+struct ProjectionView
+{
+    // The direction at the center of the image, in radians.
+    double azimuth = 0;
+    double polar = 0;
+    // The angle covered by the longer side of the image, in radians.
+    double view_angle = 1.5707963267948966;
+};
+
+// Returns the factors that make the pixels square when the longer side
+// of the image is in [-1, 1].
+[[nodiscard]]
+inline Xyz::Vector2D get_aspect_factors(size_t width, size_t height)
+{
+    if (width >= height)
+        return {1.0, double(height) / double(width)};
+    return {double(width) / double(height), 1.0};
+}
+
+// The projection used by the viewer.
+class PerspectiveProjection
+{
+public:
+    static constexpr const char* NAME = "perspective";
+    // The eye distance used by the viewer.
+    static constexpr double EYE_DIST = 0.5;
+
+    PerspectiveProjection(const ProjectionView& view,
+                          size_t width, size_t height)
+    {
+        auto factors = calc_screen_factors({double(width), double(height)},
+                                           view.view_angle, EYE_DIST);
+        auto vectors = calc_view_vectors({1.0, view.azimuth, view.polar});
+        right_ = factors[0] * vectors.right;
+        up_ = factors[1] * vectors.up;
+        eye_ = -EYE_DIST * vectors.forward;
+    }
+
+    [[nodiscard]]
+    std::optional<Xyz::Vector3D>
+    calc_direction(const Xyz::Vector2D& screen_pos) const
+    {
+        auto scr = screen_pos[0] * right_ + screen_pos[1] * up_;
+        return calc_sphere_exit_point(eye_, scr - eye_);
+    }
+private:
+    Xyz::Vector3D right_;
+    Xyz::Vector3D up_;
+    Xyz::Vector3D eye_;
+};
+
+// Equidistant fisheye: the angle from the center of the image is
+// proportional to the distance from it. The view angle can be up to
+// 360 degrees; directions beyond 180 degrees from the center are outside.
+class FisheyeProjection
+{
+public:
+    static constexpr const char* NAME = "fisheye";
+
+    FisheyeProjection(const ProjectionView& view,
+                      size_t width, size_t height)
+        : vectors_(calc_view_vectors({1.0, view.azimuth, view.polar})),
+          scale_(view.view_angle / 2 * get_aspect_factors(width, height))
+    {}
+
+    [[nodiscard]]
+    std::optional<Xyz::Vector3D>
+    calc_direction(const Xyz::Vector2D& screen_pos) const
+    {
+        constexpr auto PI = Xyz::Constants<double>::PI;
+        auto x = screen_pos[0] * scale_[0];
+        auto y = screen_pos[1] * scale_[1];
+        auto angle = std::sqrt(x * x + y * y);
+        if (angle > PI)
+            return {};
+        if (angle == 0)
+            return vectors_.forward;
+        auto s = std::sin(angle) / angle;
+        return std::cos(angle) * vectors_.forward
+               + (s * x) * vectors_.right + (s * y) * vectors_.up;
+    }
+private:
+    ViewVectors vectors_;
+    Xyz::Vector2D scale_;
+};
+
+// Stereographic projection from the point opposite the center of the
+// image. Looking straight down with a view angle around 300 degrees
+// gives the "little planet" look. The view angle must be less than
+// 360 degrees.
+class StereographicProjection
+{
+public:
+    static constexpr const char* NAME = "stereographic";
+
+    StereographicProjection(const ProjectionView& view,
+                            size_t width, size_t height)
+        : vectors_(calc_view_vectors({1.0, view.azimuth, view.polar})),
+          scale_(2 * std::tan(view.view_angle / 4)
+                 * get_aspect_factors(width, height))
+    {}
+
+    [[nodiscard]]
+    std::optional<Xyz::Vector3D>
+    calc_direction(const Xyz::Vector2D& screen_pos) const
+    {
+        // A point at distance r from the center of the plane is at the
+        // angle 2 * atan(r / 2) from the center of the view, which
+        // needs neither sine nor cosine.
+        auto x = screen_pos[0] * scale_[0];
+        auto y = screen_pos[1] * scale_[1];
+        auto r2 = x * x + y * y;
+        return (4 - r2) * vectors_.forward
+               + (4 * x) * vectors_.right + (4 * y) * vectors_.up;
+    }
+private:
+    ViewVectors vectors_;
+    Xyz::Vector2D scale_;
+};
+
+// Mercator projection with the equator as the standard parallel. The
+// view angle is the horizontal one, whichever side is longer, and the
+// polar angle of the view is the latitude at the center of the image.
+class MercatorProjection
+{
+public:
+    static constexpr const char* NAME = "mercator";
+
+    MercatorProjection(const ProjectionView& view,
+                       size_t width, size_t height)
+        : azimuth_(view.azimuth),
+          scale_(view.view_angle / 2,
+                 view.view_angle / 2 * double(height) / double(width))
+    {
+        // The poles are infinitely far away.
+        constexpr auto MAX_POLAR = 89 * Xyz::Constants<double>::PI / 180;
+        center_y_ = std::asinh(std::tan(std::clamp(view.polar, -MAX_POLAR,
+                                                   MAX_POLAR)));
+    }
+
+    [[nodiscard]]
+    std::optional<Xyz::Vector3D>
+    calc_direction(const Xyz::Vector2D& screen_pos) const
+    {
+        // The polar angle is atan(sinh(y)), whose cosine and sine are
+        // 1 / cosh(y) and tanh(y).
+        auto azimuth = azimuth_ - screen_pos[0] * scale_[0];
+        auto y = center_y_ + screen_pos[1] * scale_[1];
+        auto cos_polar = 1 / std::cosh(y);
+        return Xyz::Vector3D(cos_polar * std::cos(azimuth),
+                             cos_polar * std::sin(azimuth),
+                             std::tanh(y));
+    }
+private:
+    double azimuth_;
+    Xyz::Vector2D scale_;
+    double center_y_ = 0;
+};
+
+// Central cylindrical projection: the azimuth is linear in x and the
+// tangent of the polar angle is linear in y, as when the sphere is
+// projected from its center onto a cylinder that touches the equator.
+// The view angle is the horizontal one, and vertical lines stay vertical
+// even when the view is tilted.
+class CylindricalProjection
+{
+public:
+    static constexpr const char* NAME = "cylindrical";
+
+    CylindricalProjection(const ProjectionView& view,
+                          size_t width, size_t height)
+        : azimuth_(view.azimuth),
+          scale_(view.view_angle / 2,
+                 view.view_angle / 2 * double(height) / double(width))
+    {
+        // The poles are infinitely far away.
+        constexpr auto MAX_POLAR = 89 * Xyz::Constants<double>::PI / 180;
+        center_y_ = std::tan(std::clamp(view.polar, -MAX_POLAR, MAX_POLAR));
+    }
+
+    [[nodiscard]]
+    std::optional<Xyz::Vector3D>
+    calc_direction(const Xyz::Vector2D& screen_pos) const
+    {
+        // The point on the cylinder of radius 1 is itself a direction
+        // with the right polar angle.
+        auto azimuth = azimuth_ - screen_pos[0] * scale_[0];
+        return Xyz::Vector3D(std::cos(azimuth), std::sin(azimuth),
+                             center_y_ + screen_pos[1] * scale_[1]);
+    }
+private:
+    double azimuth_;
+    Xyz::Vector2D scale_;
+    double center_y_ = 0;
+};
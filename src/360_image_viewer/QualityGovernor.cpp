@@ -0,0 +1,138 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "QualityGovernor.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    constexpr size_t WINDOW_FRAMES = 20;
+    // Longer intervals are time the viewer spent waiting for events.
+    constexpr auto IDLE_INTERVAL = 200ms;
+
+    // The thresholds differ so that a frame rate just around the target
+    // doesn't make the level go up and down.
+    constexpr double LOWER_FACTOR = 1.25;
+    constexpr double RAISE_FACTOR = 1.05;
+
+    constexpr QualityGovernor::Clock::duration MIN_RAISE_DELAY = 2s;
+    constexpr QualityGovernor::Clock::duration MAX_RAISE_DELAY = 64s;
+    // A raise that isn't followed by a lowering within this time holds.
+    constexpr auto RAISE_TRIAL = 3s;
+}
+
+QualityGovernor::QualityGovernor(double target_fps, size_t level)
+    : target_ms_(1000.0 / target_fps),
+      level_(level),
+      raise_delay_(MIN_RAISE_DELAY)
+{
+    if (target_fps <= 0)
+        throw std::runtime_error("The target frame rate must be greater than 0.");
+    if (level >= QUALITY_LEVEL_COUNT)
+        throw std::runtime_error("Invalid quality level: " + std::to_string(level));
+}
+
+std::optional<QualityChange> QualityGovernor::add_frame(Clock::time_point time,
+                                                       Clock::duration draw_time)
+{
+    auto prev = prev_frame_;
+    prev_frame_ = time;
+    if (prev == Clock::time_point())
+        return {};
+
+    auto interval = time - prev;
+    if (interval > IDLE_INTERVAL)
+    {
+        window_frames_ = 0;
+        window_time_ = {};
+        window_draw_time_ = {};
+        return {};
+    }
+
+    window_time_ += interval;
+    window_draw_time_ += draw_time;
+    if (++window_frames_ < WINDOW_FRAMES)
+        return {};
+    return evaluate(time);
+}
+
+size_t QualityGovernor::level() const
+{
+    return level_;
+}
+
+const QualityLevel& QualityGovernor::quality() const
+{
+    return QUALITY_LEVELS[level_];
+}
+
+double QualityGovernor::target_ms() const
+{
+    return target_ms_;
+}
+
+std::optional<QualityChange> QualityGovernor::evaluate(Clock::time_point time)
+{
+    using namespace std::chrono;
+    average_ms_ = duration<double, std::milli>(window_draw_time_).count()
+                  / double(window_frames_);
+    auto window_time = window_time_;
+    window_frames_ = 0;
+    window_time_ = {};
+    window_draw_time_ = {};
+
+    if (!is_raise_confirmed_ && time - raise_time_ >= RAISE_TRIAL)
+    {
+        is_raise_confirmed_ = true;
+        raise_delay_ = MIN_RAISE_DELAY;
+    }
+
+    if (average_ms_ > target_ms_ * LOWER_FACTOR)
+    {
+        good_time_ = {};
+        if (!is_raise_confirmed_)
+        {
+            raise_delay_ = std::min(raise_delay_ * 2, MAX_RAISE_DELAY);
+            is_raise_confirmed_ = true;
+        }
+        if (level_ + 1 < QUALITY_LEVEL_COUNT)
+            return change_level(level_ + 1);
+        return {};
+    }
+
+    if (average_ms_ > target_ms_ * RAISE_FACTOR)
+    {
+        good_time_ = {};
+        return {};
+    }
+
+    good_time_ += window_time;
+    if (good_time_ < raise_delay_ || level_ == 0)
+        return {};
+
+    good_time_ = {};
+    raise_time_ = time;
+    is_raise_confirmed_ = false;
+    return change_level(level_ - 1);
+}
+
+std::optional<QualityChange> QualityGovernor::change_level(size_t level)
+{
+    QualityChange change;
+    change.old_level = level_;
+    change.new_level = level;
+    change.draw_ms = average_ms_;
+    level_ = level;
+    // The first frame at the new level includes the cost of changing it.
+    prev_frame_ = {};
+    return change;
+}
@@ -0,0 +1,102 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+
+// The settings the quality governor chooses between.
+struct QualityLevel
+{
+    // The tessellation of the sphere mesh.
+    int circles;
+    int points;
+    // Added to the level of detail when the sphere's texture is sampled.
+    float mip_bias;
+    // The size of the image the sphere is drawn to relative to the
+    // window, it is scaled up to the window's size afterwards.
+    float render_scale;
+};
+
+// The levels from the highest quality to the lowest.
+inline constexpr QualityLevel QUALITY_LEVELS[] = {
+    {32, 120, 0.f, 1.f},
+    {16, 60, 0.f, 1.f},
+    {16, 60, 1.f, 1.f},
+    {12, 48, 1.f, 0.75f},
+    {8, 36, 1.5f, 0.6f},
+    {8, 36, 2.f, 0.5f}
+};
+
+inline constexpr size_t QUALITY_LEVEL_COUNT = std::size(QUALITY_LEVELS);
+
+// The level with the settings the viewer uses without a governor.
+inline constexpr size_t DEFAULT_QUALITY_LEVEL = 1;
+
+struct QualityChange
+{
+    size_t old_level = 0;
+    size_t new_level = 0;
+    // The average draw time that caused the change.
+    double draw_ms = 0;
+};
+
+// Chooses a quality level that lets the viewer hold a target frame rate.
+//
+// The time it takes to draw each frame is averaged over a few frames at
+// a time. The interval between frames is no use, the viewer only draws
+// when something changes and the interval is often just the time between
+// input events. The quality is lowered one level when the average is
+// clearly above the target, and raised one level when it has been at the
+// target for a while. If the frame rate drops right after the quality
+// was raised, the governor waits twice as long before raising it again.
+// Intervals between frames that are long enough that the viewer must
+// have been idle start a new average.
+class QualityGovernor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit QualityGovernor(double target_fps,
+                             size_t level = DEFAULT_QUALITY_LEVEL);
+
+    // Registers that drawing a frame started at time and took draw_time,
+    // including the time the GPU spent on it. Returns the change if the
+    // governor changed the quality level.
+    std::optional<QualityChange> add_frame(Clock::time_point time,
+                                           Clock::duration draw_time);
+
+    [[nodiscard]]
+    size_t level() const;
+
+    [[nodiscard]]
+    const QualityLevel& quality() const;
+
+    [[nodiscard]]
+    double target_ms() const;
+private:
+    std::optional<QualityChange> evaluate(Clock::time_point time);
+
+    std::optional<QualityChange> change_level(size_t level);
+
+    double target_ms_;
+    size_t level_;
+    Clock::time_point prev_frame_ = {};
+    size_t window_frames_ = 0;
+    // The wall-clock time covered by the window and the total draw time
+    // of its frames.
+    Clock::duration window_time_ = {};
+    Clock::duration window_draw_time_ = {};
+    double average_ms_ = 0;
+    // The time the frame rate has been at the target.
+    Clock::duration good_time_ = {};
+    Clock::duration raise_delay_;
+    Clock::time_point raise_time_ = {};
+    bool is_raise_confirmed_ = true;
+};
@@ -0,0 +1,114 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cmath>
+#include <Xyz/Xyz.hpp>
+
+// A rotation quaternion with the real part w and the imaginary part v.
+struct Quaternion
+{
+    double w = 1;
+    Xyz::Vector3D v;
+};
+
+[[nodiscard]]
+inline Quaternion operator*(const Quaternion& a, const Quaternion& b)
+{
+    return {a.w * b.w - dot(a.v, b.v),
+            a.w * b.v + b.w * a.v + cross(a.v, b.v)};
+}
+
+[[nodiscard]]
+inline Quaternion get_conjugate(const Quaternion& q)
+{
+    return {q.w, -q.v};
+}
+
+[[nodiscard]]
+inline double get_norm(const Quaternion& q)
+{
+    return std::sqrt(q.w * q.w + get_length_squared(q.v));
+}
+
+[[nodiscard]]
+inline Quaternion get_unit(const Quaternion& q)
+{
+    auto norm = get_norm(q);
+    return {q.w / norm, q.v / norm};
+}
+
+// Returns the angle of the rotation in the range [0, pi].
+[[nodiscard]]
+inline double get_angle(const Quaternion& q)
+{
+    return 2 * std::atan2(get_length(q.v), std::abs(q.w));
+}
+
+// Rotates p by the unit quaternion q.
+[[nodiscard]]
+inline Xyz::Vector3D rotate(const Quaternion& q, const Xyz::Vector3D& p)
+{
+    auto t = 2.0 * cross(q.v, p);
+    return p + q.w * t + cross(q.v, t);
+}
+
+// Returns the rotation by angle radians counter-clockwise around the
+// unit vector axis.
+[[nodiscard]]
+inline Quaternion make_rotation(const Xyz::Vector3D& axis, double angle)
+{
+    return {std::cos(angle / 2), std::sin(angle / 2) * axis};
+}
+
+// Returns the shortest rotation that turns the unit vector from into
+// the unit vector to.
+[[nodiscard]]
+inline Quaternion make_rotation(const Xyz::Vector3D& from,
+                                const Xyz::Vector3D& to)
+{
+    auto d = dot(from, to);
+    if (d > -1 + 1e-12)
+        return get_unit(Quaternion{1 + d, cross(from, to)});
+
+    // The vectors are opposite, rotate half a turn around any axis
+    // that is perpendicular to them.
+    auto axis = std::abs(from[0]) < 0.9
+                ? cross(from, Xyz::Vector3D(1, 0, 0))
+                : cross(from, Xyz::Vector3D(0, 1, 0));
+    return {0, Xyz::get_unit(axis)};
+}
+
+// Interpolates along the shortest arc between the unit quaternions a
+// and b, t goes from 0 to 1.
+[[nodiscard]]
+inline Quaternion slerp(const Quaternion& a, Quaternion b, double t)
+{
+    auto d = a.w * b.w + dot(a.v, b.v);
+    if (d < 0)
+    {
+        b = {-b.w, -b.v};
+        d = -d;
+    }
+
+    double wa, wb;
+    if (d > 0.9995)
+    {
+        // The quaternions are so close that sin(angle) would lose
+        // precision, interpolate linearly and normalize instead.
+        wa = 1 - t;
+        wb = t;
+    }
+    else
+    {
+        auto angle = std::acos(d);
+        auto sin_angle = std::sin(angle);
+        wa = std::sin((1 - t) * angle) / sin_angle;
+        wb = std::sin(t * angle) / sin_angle;
+    }
+    return get_unit(Quaternion{wa * a.w + wb * b.w, wa * a.v + wb * b.v});
+}
@@ -0,0 +1,198 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "QuaternionCamera.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include "SpherePosCalculator.hpp"
+
+namespace
+{
+    const Xyz::Vector3D FORWARD(1, 0, 0);
+    const Xyz::Vector3D UP(0, 0, 1);
+}
+
+Xyz::Vector3D QuaternionCamera::calc_center_pos()
+{
+    return rotate(orientation_, FORWARD);
+}
+
+Xyz::Vector3D QuaternionCamera::calc_eye_pos()
+{
+    return eye_dist_ * -calc_center_pos();
+}
+
+Xyz::Vector3D QuaternionCamera::calc_up_vector()
+{
+    return rotate(orientation_, UP);
+}
+
+Xyz::SphericalPointD
+QuaternionCamera::calc_sphere_pos(const Xyz::Vector2D& screen_pos)
+{
+    auto pos = rotate(orientation_, calc_local_sphere_pos(screen_pos));
+    return Xyz::to_spherical(pos);
+}
+
+void QuaternionCamera::set_direction(double azimuth, double polar)
+{
+    orientation_ = make_rotation(UP, azimuth)
+                   * make_rotation(Xyz::Vector3D(0, 1, 0), -polar);
+}
+
+void QuaternionCamera::begin_drag(const Xyz::Vector2D& screen_pos,
+                                  Clock::time_point time)
+{
+    grabbed_pos_ = rotate(orientation_, calc_local_sphere_pos(screen_pos));
+    prev_orientations_.clear();
+    prev_orientations_.push_back({time, orientation_});
+    motion_ = {};
+}
+
+void QuaternionCamera::drag(const Xyz::Vector2D& screen_pos,
+                            Clock::time_point time)
+{
+    // The whole view turns with the camera, so rotating the point that
+    // is currently under the cursor onto the grabbed point also moves
+    // the grabbed point under the cursor.
+    auto pos = rotate(orientation_, calc_local_sphere_pos(screen_pos));
+    orientation_ = get_unit(make_rotation(pos, grabbed_pos_) * orientation_);
+    prev_orientations_.push_back({time, orientation_});
+}
+
+bool QuaternionCamera::end_drag(Clock::time_point time)
+{
+    using namespace std::chrono;
+    motion_ = {};
+
+    auto it = std::find_if(prev_orientations_.begin(),
+                           prev_orientations_.end(),
+                           [&](const auto& p)
+                           {
+                               return duration<double>(time - p.first).count()
+                                      < MAX_CENTER_POINT_AGE;
+                           });
+
+    if (it == prev_orientations_.end())
+        return false;
+
+    const auto& [time0, orientation0] = *it;
+    const auto& orientation1 = prev_orientations_.back().second;
+    auto rotation = orientation1 * get_conjugate(orientation0);
+    auto angle = get_angle(rotation);
+    auto secs = duration<double>(time - time0).count();
+    if (angle < 1e-9 || secs <= 0)
+        return false;
+
+    // The rotation's axis, with the sign that makes the angle positive.
+    auto axis = Xyz::get_unit(rotation.w < 0 ? -rotation.v : rotation.v);
+    auto speed = std::min(angle / secs, MAX_SPEED);
+    auto length = get_inertia_duration(speed);
+    auto end_time = time + duration_cast<Clock::duration>(
+        duration<double>(length));
+    auto target_angle = speed * get_inertia_factor(speed, length);
+    motion_ = Motion{time, end_time, speed, orientation1,
+                     make_rotation(axis, target_angle) * orientation1};
+    return true;
+}
+
+bool QuaternionCamera::update_motion(Clock::time_point time)
+{
+    using namespace std::chrono;
+    if (!motion_)
+        return false;
+
+    if (time >= motion_->end_time)
+    {
+        orientation_ = motion_->target;
+        motion_.reset();
+        return false;
+    }
+
+    auto secs = duration<double>(time - motion_->start_time).count();
+    auto length = duration<double>(motion_->end_time - motion_->start_time).count();
+    auto t = get_inertia_factor(motion_->speed, secs)
+             / get_inertia_factor(motion_->speed, length);
+    orientation_ = slerp(motion_->origin, motion_->target, t);
+    return true;
+}
+
+bool QuaternionCamera::is_moving() const
+{
+    return motion_.has_value();
+}
+
+double QuaternionCamera::eye_dist() const
+{
+    return eye_dist_;
+}
+
+void QuaternionCamera::set_eye_dist(double eye_dist)
+{
+    eye_dist_ = eye_dist;
+    update_screen_factors();
+}
+
+double QuaternionCamera::view_angle() const
+{
+    return view_angle_;
+}
+
+void QuaternionCamera::set_view_angle(double view_angle)
+{
+    view_angle_ = view_angle;
+    update_screen_factors();
+}
+
+Xyz::Vector2D QuaternionCamera::screen_res() const
+{
+    return screen_res_;
+}
+
+void QuaternionCamera::set_screen_res(const Xyz::Vector2D& screen_res)
+{
+    if (screen_res_ != screen_res)
+    {
+        screen_res_ = screen_res;
+        update_screen_factors();
+    }
+}
+
+const Quaternion& QuaternionCamera::orientation() const
+{
+    return orientation_;
+}
+
+Xyz::Vector3D
+QuaternionCamera::calc_local_sphere_pos(const Xyz::Vector2D& screen_pos) const
+{
+    // The intersection between the sphere and the ray from the eye
+    // through the screen position. The eye is inside the sphere, so
+    // there is always one solution in front of it.
+    Xyz::Vector3D eye(-eye_dist_, 0, 0);
+    Xyz::Vector3D delta(eye_dist_,
+                        -screen_pos[0] * screen_factors_[0],
+                        screen_pos[1] * screen_factors_[1]);
+    auto a = get_length_squared(delta);
+    auto b = 2 * dot(eye, delta);
+    auto c = get_length_squared(eye) - 1;
+    auto discriminant = b * b - 4 * a * c;
+    if (a == 0 || discriminant < 0)
+        throw std::runtime_error("Can not find a point on the sphere.");
+
+    auto t = (-b + std::sqrt(discriminant)) / (2 * a);
+    return eye + t * delta;
+}
+
+void QuaternionCamera::update_screen_factors()
+{
+    if (screen_res_[0] > 0 && screen_res_[1] > 0)
+        screen_factors_ = calc_screen_factors(screen_res_, view_angle_, eye_dist_);
+    else
+        screen_factors_ = {};
+}
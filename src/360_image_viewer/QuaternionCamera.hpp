@@ -0,0 +1,97 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <optional>
+#include "Camera.hpp"
+#include "Quaternion.hpp"
+#include "RingBuffer.hpp"
+
+// A camera whose orientation is a quaternion. Dragging is an
+// incremental arcball: every mouse motion rotates the camera by the
+// shortest rotation that brings the point under the cursor back to the
+// grabbed point. The orientation is never derived from angles, so
+// nothing special happens at the poles. The camera rolls when it is dragged along a
+// curve, set_direction levels the horizon again. The inertia motion
+// interpolates between two orientations with slerp.
+class QuaternionCamera : public Camera
+{
+public:
+    [[nodiscard]]
+    Xyz::Vector3D calc_center_pos() override;
+
+    [[nodiscard]]
+    Xyz::Vector3D calc_eye_pos() override;
+
+    [[nodiscard]]
+    Xyz::Vector3D calc_up_vector() override;
+
+    [[nodiscard]]
+    Xyz::SphericalPointD calc_sphere_pos(const Xyz::Vector2D& screen_pos) override;
+
+    void set_direction(double azimuth, double polar) override;
+
+    void begin_drag(const Xyz::Vector2D& screen_pos,
+                    Clock::time_point time) override;
+
+    void drag(const Xyz::Vector2D& screen_pos,
+              Clock::time_point time) override;
+
+    bool end_drag(Clock::time_point time) override;
+
+    bool update_motion(Clock::time_point time) override;
+
+    [[nodiscard]]
+    bool is_moving() const override;
+
+    [[nodiscard]]
+    double eye_dist() const override;
+
+    void set_eye_dist(double eye_dist) override;
+
+    [[nodiscard]]
+    double view_angle() const override;
+
+    void set_view_angle(double view_angle) override;
+
+    [[nodiscard]]
+    Xyz::Vector2D screen_res() const override;
+
+    void set_screen_res(const Xyz::Vector2D& screen_res) override;
+
+    [[nodiscard]]
+    const Quaternion& orientation() const;
+private:
+    using PrevOrientationList = Chorasmia::RingBuffer<
+        std::pair<Clock::time_point, Quaternion>, 4>;
+
+    struct Motion
+    {
+        Clock::time_point start_time = {};
+        Clock::time_point end_time = {};
+        double speed = 0;
+        Quaternion origin;
+        Quaternion target;
+    };
+
+    // Returns the point on the sphere at screen_pos in the camera's
+    // coordinate system, where the camera looks along the x-axis and
+    // the z-axis is up.
+    [[nodiscard]]
+    Xyz::Vector3D calc_local_sphere_pos(const Xyz::Vector2D& screen_pos) const;
+
+    void update_screen_factors();
+
+    Quaternion orientation_;
+    double eye_dist_ = {};
+    double view_angle_ = {};
+    Xyz::Vector2D screen_res_;
+    Xyz::Vector2D screen_factors_;
+    Xyz::Vector3D grabbed_pos_;
+    PrevOrientationList prev_orientations_;
+    std::optional<Motion> motion_;
+};
@@ -0,0 +1,33 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "RayCastShaderProgram.hpp"
+
+#include <Tungsten/ShaderProgramBuilder.hpp>
+#include "RayCast-frag.glsl.hpp"
+#include "RayCast-vert.glsl.hpp"
+
+void RayCastShaderProgram::setup()
+{
+    using namespace Tungsten;
+    program = ShaderProgramBuilder()
+        .add_shader(ShaderType::VERTEX, RayCast_vert)
+        .add_shader(ShaderType::FRAGMENT, RayCast_frag)
+        .build();
+
+    position = get_vertex_attribute(program, "a_position");
+
+    inv_mv_matrix = get_uniform<Xyz::Matrix4F>(program, "u_inv_mv_matrix");
+    inv_p_matrix = get_uniform<Xyz::Matrix4F>(program, "u_inv_p_matrix");
+    texture = get_uniform<GLint>(program, "u_texture");
+    exposure = get_uniform<float>(program, "u_exposure");
+    tone_map = get_uniform<GLint>(program, "u_tone_map");
+    texture_transform = get_uniform<Xyz::Vector2F>(program, "u_texture_transform");
+    texture_v_range = get_uniform<Xyz::Vector2F>(program, "u_texture_v_range");
+    grid_size = get_uniform<Xyz::Vector2F>(program, "u_grid_size");
+    pixel_angle = get_uniform<float>(program, "u_pixel_angle");
+}
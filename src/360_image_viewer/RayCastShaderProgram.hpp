@@ -0,0 +1,29 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include "Tungsten/Tungsten.hpp"
+
+class RayCastShaderProgram
+{
+public:
+    void setup();
+
+    Tungsten::ProgramHandle program;
+
+    Tungsten::Uniform<Xyz::Matrix4F> inv_mv_matrix;
+    Tungsten::Uniform<Xyz::Matrix4F> inv_p_matrix;
+    Tungsten::Uniform<GLint> texture;
+    Tungsten::Uniform<float> exposure;
+    Tungsten::Uniform<GLint> tone_map;
+    Tungsten::Uniform<Xyz::Vector2F> texture_transform;
+    Tungsten::Uniform<Xyz::Vector2F> texture_v_range;
+    Tungsten::Uniform<Xyz::Vector2F> grid_size;
+    Tungsten::Uniform<float> pixel_angle;
+
+    GLuint position;
+};
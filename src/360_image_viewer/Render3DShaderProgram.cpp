@@ -26,4 +26,9 @@ void Render3DShaderProgram::setup()
     p_matrix = get_uniform<Xyz::Matrix4F>(program, "u_p_matrix");
 
     texture = get_uniform<GLint>(program, "u_texture");
+    exposure = get_uniform<float>(program, "u_exposure");
+    tone_map = get_uniform<GLint>(program, "u_tone_map");
+    texture_transform = get_uniform<Xyz::Vector2F>(program, "u_texture_transform");
+    texture_v_range = get_uniform<Xyz::Vector2F>(program, "u_texture_v_range");
+    mip_bias = get_uniform<float>(program, "u_mip_bias");
 }
@@ -18,6 +18,11 @@ public:
     Tungsten::Uniform<Xyz::Matrix4F> mv_matrix;
     Tungsten::Uniform<Xyz::Matrix4F> p_matrix;
     Tungsten::Uniform<GLint> texture;
+    Tungsten::Uniform<float> exposure;
+    Tungsten::Uniform<GLint> tone_map;
+    Tungsten::Uniform<Xyz::Vector2F> texture_transform;
+    Tungsten::Uniform<Xyz::Vector2F> texture_v_range;
+    Tungsten::Uniform<float> mip_bias;
 
     GLuint position;
     GLuint texture_coord;
@@ -0,0 +1,63 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Reprojection.hpp"
+
+const char* get_projection_name(ProjectionType type)
+{
+    switch (type)
+    {
+    case ProjectionType::PERSPECTIVE:
+        return PerspectiveProjection::NAME;
+    case ProjectionType::FISHEYE:
+        return FisheyeProjection::NAME;
+    case ProjectionType::STEREOGRAPHIC:
+        return StereographicProjection::NAME;
+    case ProjectionType::MERCATOR:
+        return MercatorProjection::NAME;
+    case ProjectionType::CYLINDRICAL:
+        return CylindricalProjection::NAME;
+    }
+    return "unknown";
+}
+
+ProjectionType get_projection_type(const std::string& name)
+{
+    for (auto type: ALL_PROJECTION_TYPES)
+    {
+        if (name == get_projection_name(type))
+            return type;
+    }
+    throw std::runtime_error("Unknown projection: " + name);
+}
+
+Yimage::Image reproject(const Yimage::Image& panorama,
+                        ProjectionType type,
+                        const ProjectionView& view,
+                        size_t width, size_t height,
+                        unsigned thread_count)
+{
+    switch (type)
+    {
+    case ProjectionType::PERSPECTIVE:
+        return reproject<PerspectiveProjection>(panorama, view, width, height,
+                                                thread_count);
+    case ProjectionType::FISHEYE:
+        return reproject<FisheyeProjection>(panorama, view, width, height,
+                                            thread_count);
+    case ProjectionType::STEREOGRAPHIC:
+        return reproject<StereographicProjection>(panorama, view, width, height,
+                                                  thread_count);
+    case ProjectionType::MERCATOR:
+        return reproject<MercatorProjection>(panorama, view, width, height,
+                                             thread_count);
+    case ProjectionType::CYLINDRICAL:
+        return reproject<CylindricalProjection>(panorama, view, width, height,
+                                                thread_count);
+    }
+    throw std::runtime_error("Unknown projection.");
+}
@@ -0,0 +1,126 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <Yimage/Yimage.hpp>
+#include "EquirectangularMapping.hpp"
+#include "ImageUtilities.hpp"
+#include "Parallel.hpp"
+#include "Projections.hpp"
+
+enum class ProjectionType
+{
+    PERSPECTIVE,
+    FISHEYE,
+    STEREOGRAPHIC,
+    MERCATOR,
+    CYLINDRICAL
+};
+
+constexpr ProjectionType ALL_PROJECTION_TYPES[] = {
+    ProjectionType::PERSPECTIVE,
+    ProjectionType::FISHEYE,
+    ProjectionType::STEREOGRAPHIC,
+    ProjectionType::MERCATOR,
+    ProjectionType::CYLINDRICAL
+};
+
+[[nodiscard]]
+const char* get_projection_name(ProjectionType type);
+
+// Throws std::runtime_error if name isn't the name of a projection.
+[[nodiscard]]
+ProjectionType get_projection_type(const std::string& name);
+
+namespace Detail
+{
+    // Tiles keep the rows a thread reads from the panorama close
+    // together, and give the threads similar amounts of work even when
+    // parts of the image are outside the projection.
+    constexpr size_t REPROJECTION_TILE_SIZE = 64;
+    constexpr unsigned char REPROJECTION_BACKGROUND = 0;
+
+    template <typename Projection>
+    void reproject_tile(const Yimage::Image& panorama, size_t channels,
+                        const Projection& projection,
+                        Yimage::Image& result,
+                        size_t x0, size_t y0, size_t x1, size_t y1)
+    {
+        auto width = double(result.width()), height = double(result.height());
+        Xyz::Vector2D tex_pos[REPROJECTION_TILE_SIZE];
+        bool inside[REPROJECTION_TILE_SIZE];
+        for (size_t y = y0; y < y1; ++y)
+        {
+            // Computing a row's texture positions before sampling it keeps
+            // the projection's math in a tight loop that the compiler can
+            // unroll, and vectorize where the math library allows it.
+            auto screen_y = 1 - 2 * (double(y) + 0.5) / height;
+            for (size_t x = x0; x < x1; ++x)
+            {
+                Xyz::Vector2D screen_pos(2 * (double(x) + 0.5) / width - 1,
+                                         screen_y);
+                auto dir = projection.calc_direction(screen_pos);
+                inside[x - x0] = dir.has_value();
+                if (dir)
+                    tex_pos[x - x0] = get_texture_pos(*dir);
+            }
+
+            auto row = result.data() + y * result.row_size();
+            for (size_t x = x0; x < x1; ++x)
+            {
+                if (inside[x - x0])
+                    sample_panorama(panorama, channels, tex_pos[x - x0], row + 3 * x);
+                else
+                    memset(row + 3 * x, REPROJECTION_BACKGROUND, 3);
+            }
+        }
+    }
+}
+
+// Renders an equirectangular panorama with the given projection. The
+// result is always RGB_8, and pixels outside the projection are black.
+// The image is divided into tiles that are rendered on up to
+// thread_count threads.
+template <typename Projection>
+[[nodiscard]]
+Yimage::Image reproject(const Yimage::Image& panorama,
+                        const ProjectionView& view,
+                        size_t width, size_t height,
+                        unsigned thread_count = 0)
+{
+    using Detail::REPROJECTION_TILE_SIZE;
+    if (panorama.width() == 0 || panorama.height() == 0)
+        throw std::runtime_error("Can not reproject an empty image.");
+
+    Projection projection(view, width, height);
+    auto channels = get_channel_count(panorama.pixel_type());
+    Yimage::Image result(Yimage::PixelType::RGB_8, width, height);
+    auto columns = (width + REPROJECTION_TILE_SIZE - 1) / REPROJECTION_TILE_SIZE;
+    auto rows = (height + REPROJECTION_TILE_SIZE - 1) / REPROJECTION_TILE_SIZE;
+    parallel_for(columns * rows, [&](size_t i)
+    {
+        auto x0 = (i % columns) * REPROJECTION_TILE_SIZE;
+        auto y0 = (i / columns) * REPROJECTION_TILE_SIZE;
+        Detail::reproject_tile(panorama, channels, projection, result,
+                               x0, y0,
+                               std::min(x0 + REPROJECTION_TILE_SIZE, width),
+                               std::min(y0 + REPROJECTION_TILE_SIZE, height));
+    }, thread_count);
+    return result;
+}
+
+// Calls reproject() with the projection of the given type.
+[[nodiscard]]
+Yimage::Image reproject(const Yimage::Image& panorama,
+                        ProjectionType type,
+                        const ProjectionView& view,
+                        size_t width, size_t height,
+                        unsigned thread_count = 0);
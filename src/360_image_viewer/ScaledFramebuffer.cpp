@@ -0,0 +1,104 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ScaledFramebuffer.hpp"
+
+#include <algorithm>
+
+ScaledFramebuffer::~ScaledFramebuffer()
+{
+    if (is_setup_)
+    {
+        glDeleteFramebuffers(1, &framebuffer_);
+        glDeleteTextures(1, &texture_);
+    }
+}
+
+bool ScaledFramebuffer::begin(float scale)
+{
+    if (scale >= 1)
+        return false;
+
+    if (!is_setup_)
+        setup();
+
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prev_framebuffer_);
+    glGetIntegerv(GL_VIEWPORT, viewport_);
+    auto width = std::max(int(float(viewport_[2]) * scale), 1);
+    auto height = std::max(int(float(viewport_[3]) * scale), 1);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+    if (width != width_ || height != height_)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture_);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                               GL_TEXTURE_2D, texture_, 0);
+        width_ = width;
+        height_ = height;
+    }
+    glViewport(0, 0, width, height);
+    glClear(GL_COLOR_BUFFER_BIT);
+    return true;
+}
+
+void ScaledFramebuffer::end()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, GLuint(prev_framebuffer_));
+    glViewport(viewport_[0], viewport_[1], viewport_[2], viewport_[3]);
+
+    Tungsten::bind_vertex_array(quad_array_);
+    Tungsten::use_program(quad_program_.program);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
+
+size_t ScaledFramebuffer::gpu_bytes() const
+{
+    return size_t(width_) * size_t(height_) * 4;
+}
+
+void ScaledFramebuffer::setup()
+{
+    glGenFramebuffers(1, &framebuffer_);
+    glGenTextures(1, &texture_);
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    float quad[] = {-1, -1, 0, 0, 0,
+                    1, -1, 0, 1, 0,
+                    -1, 1, 0, 0, 1,
+                    1, 1, 0, 1, 1};
+    quad_array_ = Tungsten::generate_vertex_array();
+    Tungsten::bind_vertex_array(quad_array_);
+    quad_buffer_ = Tungsten::generate_buffer();
+    Tungsten::bind_buffer(GL_ARRAY_BUFFER, quad_buffer_);
+    Tungsten::set_buffer_data(GL_ARRAY_BUFFER, sizeof(quad), quad,
+                              GL_STATIC_DRAW);
+    quad_program_.setup();
+    Tungsten::use_program(quad_program_.program);
+    quad_program_.mv_matrix.set(Xyz::make_identity_matrix<float, 4>());
+    quad_program_.p_matrix.set(Xyz::make_identity_matrix<float, 4>());
+    quad_program_.texture.set(0);
+    quad_program_.exposure.set(1);
+    quad_program_.tone_map.set(0);
+    quad_program_.mip_bias.set(0);
+    quad_program_.texture_transform.set({1, 0});
+    Tungsten::define_vertex_attribute_float_pointer(
+        quad_program_.position, 3, 5 * sizeof(float), 0);
+    Tungsten::enable_vertex_attribute(quad_program_.position);
+    Tungsten::define_vertex_attribute_float_pointer(
+        quad_program_.texture_coord, 2, 5 * sizeof(float), 3 * sizeof(float));
+    Tungsten::enable_vertex_attribute(quad_program_.texture_coord);
+
+    is_setup_ = true;
+}
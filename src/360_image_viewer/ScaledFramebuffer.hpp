@@ -0,0 +1,54 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <Tungsten/Tungsten.hpp>
+#include "Render3DShaderProgram.hpp"
+
+// Lets the scene be drawn at a lower resolution than the window's and
+// then scaled up to fill the window with linear filtering.
+//
+// The GL objects are created the first time begin is called with a
+// scale below 1, and the texture is resized when the viewport changes.
+class ScaledFramebuffer
+{
+public:
+    ScaledFramebuffer() = default;
+
+    ~ScaledFramebuffer();
+
+    ScaledFramebuffer(const ScaledFramebuffer&) = delete;
+
+    ScaledFramebuffer& operator=(const ScaledFramebuffer&) = delete;
+
+    // Makes the following draw calls go to a cleared texture that is
+    // scale times the size of the current viewport. Does nothing and
+    // returns false if scale is 1 or more.
+    bool begin(float scale);
+
+    // Restores the framebuffer and viewport that were current when begin
+    // was called, and draws the texture to the whole viewport.
+    void end();
+
+    // The size of the texture, it is 0 until a scale below 1 has been
+    // used.
+    [[nodiscard]]
+    size_t gpu_bytes() const;
+private:
+    void setup();
+
+    bool is_setup_ = false;
+    GLuint framebuffer_ = 0;
+    GLuint texture_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    GLint prev_framebuffer_ = 0;
+    GLint viewport_[4] = {};
+    Tungsten::BufferHandle quad_buffer_;
+    Tungsten::VertexArrayHandle quad_array_;
+    Render3DShaderProgram quad_program_;
+};
@@ -6,8 +6,24 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #include "Sphere.hpp"
+#include <chrono>
+#include <cmath>
+#include "ImageResampler.hpp"
 #include "ObjFileWriter.hpp"
 
+#ifndef GL_COMPRESSED_RGB8_ETC2
+    #define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
+#ifndef GL_RGB16F
+    #define GL_RGB16F 0x881B
+#endif
+#ifndef GL_HALF_FLOAT
+    #define GL_HALF_FLOAT 0x140B
+#endif
+#ifndef GL_MAJOR_VERSION
+    #define GL_MAJOR_VERSION 0x821B
+#endif
+
 namespace
 {
     Tungsten::ArrayBuffer<Detail::Vertex> make_sphere(int circles, int points)
@@ -79,6 +95,77 @@ namespace
         return result;
     }
 
+    // Makes a sphere where every band of the atlas is a ring of quads.
+    // A band that is split in several pieces gets an extra column of
+    // vertexes where it is split.
+    Tungsten::ArrayBuffer<Detail::Vertex>
+    make_atlas_sphere(const std::vector<LatitudeBand>& bands,
+                      size_t atlas_width, size_t atlas_height,
+                      size_t src_height, int points)
+    {
+        Tungsten::ArrayBuffer<Detail::Vertex> result;
+        Tungsten::ArrayBufferBuilder builder(result);
+
+        constexpr auto PI = Xyz::Constants<float>::PI;
+
+        uint16_t n = 0;
+        for (const auto& band: bands)
+        {
+            const float top_angle = (0.5f - float(band.first_row) / float(src_height)) * PI;
+            const float bottom_angle = (0.5f - float(band.first_row + band.row_count)
+                                               / float(src_height)) * PI;
+            const float top_z = sin(top_angle), top_factor = cos(top_angle);
+            const float bottom_z = sin(bottom_angle), bottom_factor = cos(bottom_angle);
+            const auto band_width = float(band.width);
+
+            for (const auto& piece: band.pieces)
+            {
+                const float t0 = float(piece.offset) / band_width;
+                const float t1 = float(piece.offset + piece.width) / band_width;
+                std::vector<float> ts{t0};
+                for (int i = 1; i < points; ++i)
+                {
+                    const float t = float(i) / float(points);
+                    if (t0 < t && t < t1)
+                        ts.push_back(t);
+                }
+                ts.push_back(t1);
+
+                const float tex_top = float(piece.y) / float(atlas_height);
+                const float tex_bottom = float(piece.y + band.row_count)
+                                         / float(atlas_height);
+                for (const auto t: ts)
+                {
+                    // Same mapping from texture to angle as in make_sphere.
+                    const float angle = ((1.f - t) * 2.f - 0.5f) * PI;
+                    const float pos_x = cos(angle);
+                    const float pos_y = sin(angle);
+                    const float tex_x = (float(piece.x) + (t * band_width
+                                                           - float(piece.offset)))
+                                        / float(atlas_width);
+                    builder.add_vertex({.pos = {pos_x * top_factor,
+                                                pos_y * top_factor,
+                                                top_z},
+                                        .tex = {tex_x, tex_top}});
+                    builder.add_vertex({.pos = {pos_x * bottom_factor,
+                                                pos_y * bottom_factor,
+                                                bottom_z},
+                                        .tex = {tex_x, tex_bottom}});
+                }
+
+                for (size_t i = 0; i + 1 < ts.size(); ++i)
+                {
+                    const auto m = uint16_t(n + 2 * i);
+                    builder.add_indexes(m, m + 1, m + 3);
+                    builder.add_indexes(m, m + 3, m + 2);
+                }
+                n = uint16_t(n + 2 * ts.size());
+            }
+        }
+
+        return result;
+    }
+
     void write(std::ostream& os, Tungsten::ArrayBuffer<Detail::Vertex>& buffer)
     {
         ObjFileWriter writer(os);
@@ -143,35 +230,217 @@ namespace
                            {0x88, 0xDD, 0x33, 0xFF});
         return img;
     }
+
+    // More bands save more memory, but also add more triangles.
+    constexpr size_t ATLAS_BANDS = 32;
+
+    int get_max_texture_size(const TextureOptions& options,
+                             const TextureLimits& limits)
+    {
+        if (options.max_size > 0)
+            return std::min(limits.max_size, options.max_size);
+        return limits.max_size;
+    }
+
+    // Returns the angle between the view rays through the two pixels
+    // closest to the center of a viewport that is width pixels wide.
+    float get_pixel_angle(const Xyz::Matrix4F& inv_p_matrix, int width)
+    {
+        auto get_direction = [&](float x)
+        {
+            auto p = inv_p_matrix * Xyz::Vector4F(x, 0, 1, 1);
+            return Xyz::Vector3F(p[0], p[1], p[2]) / p[3];
+        };
+        auto a = get_direction(0);
+        auto b = get_direction(2.f / float(std::max(width, 1)));
+        return std::atan2(get_length(cross(a, b)), dot(a, b));
+    }
+
+    void set_texture_parameters()
+    {
+        Tungsten::set_texture_min_filter(GL_TEXTURE_2D, GL_LINEAR);
+        Tungsten::set_texture_mag_filter(GL_TEXTURE_2D, GL_LINEAR);
+        Tungsten::set_texture_parameter(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        Tungsten::set_texture_parameter(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    bool is_compressed_format_supported(GLenum format)
+    {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+        std::vector<GLint> formats(size_t(std::max(count, 0)));
+        glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+        return std::find(formats.begin(), formats.end(), GLint(format))
+               != formats.end();
+    }
+
+    // Half-float textures are part of OpenGL ES 3 and WebGL 2. Older
+    // versions don't know GL_MAJOR_VERSION and leave major at 0.
+    bool is_half_float_supported()
+    {
+        GLint major = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        while (glGetError() != GL_NO_ERROR)
+        {}
+        return major >= 3;
+    }
+
+    // Returns the scale and offset that map the vertical texture
+    // coordinates of a mono image to eye's part of the texture.
+    Xyz::Vector2F get_texture_transform(StereoLayout layout, StereoEye eye)
+    {
+        if (layout == StereoLayout::MONO)
+            return {1, 0};
+        return {0.5f, eye == StereoEye::LEFT ? 0.f : 0.5f};
+    }
+
+    // Returns the range of vertical texture coordinates that stays at
+    // least half a pixel inside eye's part of the texture, so that the
+    // linear filter never reaches the other eye's rows.
+    Xyz::Vector2F get_texture_v_range(StereoLayout layout, StereoEye eye,
+                                      size_t texture_height)
+    {
+        if (layout == StereoLayout::MONO || texture_height == 0)
+            return {0, 1};
+        auto margin = 0.5f / float(texture_height);
+        if (eye == StereoEye::LEFT)
+            return {margin, 0.5f - margin};
+        return {0.5f + margin, 1 - margin};
+    }
+
+    size_t get_texture_height(const SphereTexture& texture)
+    {
+        if (!texture.half_float_image.pixels.empty())
+            return texture.half_float_image.height;
+        if (!texture.etc2_image.blocks.empty())
+            return texture.etc2_image.height;
+        return texture.image.height();
+    }
+
+    // The shaders only tone map half-float textures, 8-bit textures are
+    // shown as they are.
+    GLint get_tone_map_mode(bool is_half_float, ToneMapping tone_mapping)
+    {
+        return is_half_float ? GLint(tone_mapping) + 1 : 0;
+    }
 }
 
-Sphere::Sphere(int circles, int points)
-    : Sphere(Yimage::Image(), circles, points)
-{}
+SphereTexture prepare_sphere_texture(Yimage::Image img,
+                                     const TextureOptions& options,
+                                     const TextureLimits& limits)
+{
+    using namespace std::chrono;
+
+    auto max_size = get_max_texture_size(options, limits);
+
+    if (is_16_bit(img.pixel_type()))
+    {
+        auto start = steady_clock::now();
+        // ETC2 and the latitude atlas only support 8-bit images.
+        if (limits.supports_half_float && !options.use_etc2
+            && !options.latitude_atlas)
+        {
+            SphereTexture result;
+            result.half_float_image = make_half_float_image(img, size_t(max_size));
+            const auto& half_img = result.half_float_image;
+            auto msecs = duration<double, std::milli>(steady_clock::now() - start).count();
+            SDL_Log("Converted %zux%zu 16-bit image to a %zux%zu half-float"
+                    " texture in %.1f ms.", img.width(), img.height(),
+                    half_img.width, half_img.height, msecs);
+            return result;
+        }
+
+        img = convert_to_8_bit(img);
+        auto msecs = duration<double, std::milli>(steady_clock::now() - start).count();
+        SDL_Log("Converted 16-bit image to 8 bits in %.1f ms.", msecs);
+    }
+
+    // The atlas is wider than the image because of the padding.
+    const bool use_atlas = options.latitude_atlas && img.height() > 1;
+    auto size_limit = size_t(max_size);
+    if (use_atlas)
+        size_limit -= 2 * LATITUDE_ATLAS_PADDING;
+
+    auto [width, height] = get_size_to_fit(img.width(), img.height(),
+                                           size_limit);
+    if (width != img.width() || height != img.height())
+    {
+        auto start = steady_clock::now();
+        auto scaled_img = resize_image(img, width, height);
+        auto msecs = duration<double, std::milli>(steady_clock::now() - start).count();
+        SDL_Log("Scaled image from %zux%zu to %zux%zu in %.1f ms to fit the"
+                " texture size limit %d.", img.width(), img.height(),
+                width, height, msecs, max_size);
+        img = std::move(scaled_img);
+    }
+
+    SphereTexture result;
+    if (use_atlas)
+    {
+        auto start = steady_clock::now();
+        auto atlas = make_latitude_atlas(img, ATLAS_BANDS);
+        auto msecs = duration<double, std::milli>(steady_clock::now() - start).count();
+        auto ratio = double(atlas.image.width() * atlas.image.height())
+                     / double(img.width() * img.height());
+        SDL_Log("Made %zux%zu latitude atlas in %.1f ms, %.0f%% of the image size.",
+                atlas.image.width(), atlas.image.height(), msecs, ratio * 100);
+        result.atlas_bands = std::move(atlas.bands);
+        result.atlas_source_height = img.height();
+        img = std::move(atlas.image);
+    }
+
+    if (options.use_etc2 && limits.supports_etc2)
+    {
+        auto start = steady_clock::now();
+        result.etc2_image = get_etc2_image(img, options.cache_dir);
+        auto msecs = duration<double, std::milli>(steady_clock::now() - start).count();
+        SDL_Log("Prepared %zux%zu ETC2 texture in %.1f ms.",
+                result.etc2_image.width, result.etc2_image.height, msecs);
+        if (result.etc2_image.psnr != 0)
+            SDL_Log("ETC2 texture PSNR: %.2f dB.", result.etc2_image.psnr);
+    }
+    else
+    {
+        result.image = std::move(img);
+    }
+    return result;
+}
 
-Sphere::Sphere(const Yimage::Image& img, int circles, int points)
+size_t get_host_bytes(const SphereTexture& texture)
 {
-    auto array = make_sphere(circles, points);
-    auto count = int(array.indexes.size());
+    return texture.image.row_size() * texture.image.height()
+           + texture.etc2_image.blocks.size()
+           + texture.half_float_image.pixels.size() * sizeof(uint16_t);
+}
 
-    triangle_indexes_to_lines(array.indexes.data(),
-                              array.indexes.size(),
-                              array.indexes);
+bool can_upload_partially(size_t width, size_t height,
+                          Yimage::PixelType pixel_type,
+                          const TextureOptions& options,
+                          const TextureLimits& limits)
+{
+    if (options.use_etc2 || options.latitude_atlas || !is_stageable(pixel_type))
+        return false;
 
-    line_count_ = int(array.indexes.size()) - count;
+    auto max_size = size_t(get_max_texture_size(options, limits));
+    return width <= max_size && height <= max_size;
+}
 
-    Tungsten::set_buffers(vertex_array_, array);
+Sphere::Sphere(int circles, int points)
+    : Sphere(Yimage::Image(), circles, points)
+{}
+
+Sphere::Sphere(Yimage::Image img, int circles, int points)
+    : circles_(circles),
+      points_(points)
+{
+    set_mesh(make_sphere(circles, points));
 
     texture_ = Tungsten::generate_texture();
     Tungsten::bind_texture(GL_TEXTURE_2D, texture_);
-
-    Tungsten::set_texture_min_filter(GL_TEXTURE_2D, GL_LINEAR);
-    Tungsten::set_texture_mag_filter(GL_TEXTURE_2D, GL_LINEAR);
-    Tungsten::set_texture_parameter(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    Tungsten::set_texture_parameter(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    set_texture_parameters();
 
     if (img)
-        set_image(img);
+        set_image(std::move(img));
     else
         set_image(make_dummy_image());
 
@@ -182,39 +451,391 @@ Sphere::Sphere(const Yimage::Image& img, int circles, int points)
     vertex_array_.define_float_pointer(
         program_.texture_coord, 2, 3 * sizeof(float));
     Tungsten::enable_vertex_attribute(program_.texture_coord);
+}
+
+void Sphere::set_image(Yimage::Image img)
+{
+    set_texture(prepare_sphere_texture(std::move(img), texture_options,
+                                       texture_limits()));
+}
 
+void Sphere::set_texture(SphereTexture texture)
+{
+    start_upload(std::move(texture), {});
+    continue_upload();
+}
+
+void Sphere::start_upload(SphereTexture texture, const UploadBudget& budget)
+{
+    auto pending = std::make_unique<PendingTexture>();
+    pending->texture = std::move(texture);
+    pending->handle = Tungsten::generate_texture();
+    Tungsten::bind_texture(GL_TEXTURE_2D, pending->handle);
+    set_texture_parameters();
+
+    const auto& tex = pending->texture;
+    if (!tex.half_float_image.pixels.empty())
+    {
+        const auto& img = tex.half_float_image;
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F,
+                     GLsizei(img.width), GLsizei(img.height), 0,
+                     GL_RGB, GL_HALF_FLOAT, nullptr);
+        auto row_size = img.width * 3 * sizeof(uint16_t);
+        pending->memory = img.height * row_size;
+        pending->upload = IncrementalUpload(
+            img.height, row_size,
+            [&img](size_t first_row, size_t row_count)
+            {
+                glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+                glTexSubImage2D(GL_TEXTURE_2D, 0, 0, GLint(first_row),
+                                GLsizei(img.width), GLsizei(row_count),
+                                GL_RGB, GL_HALF_FLOAT,
+                                img.pixels.data() + first_row * img.width * 3);
+            },
+            budget);
+    }
+    else if (!tex.etc2_image.blocks.empty())
+    {
+        // ETC2 textures are a sixth of the size of RGB textures, and
+        // WebGL can't allocate compressed textures without their data.
+        // They are uploaded as a single stripe.
+        const auto& img = tex.etc2_image;
+        pending->memory = img.blocks.size();
+        pending->upload = IncrementalUpload(
+            1, img.blocks.size(),
+            [&img](size_t, size_t)
+            {
+                glCompressedTexImage2D(GL_TEXTURE_2D, 0, GL_COMPRESSED_RGB8_ETC2,
+                                       GLsizei(img.width), GLsizei(img.height),
+                                       0, GLsizei(img.blocks.size()),
+                                       img.blocks.data());
+            },
+            budget);
+    }
+    else
+    {
+        const auto& img = tex.image;
+        auto format = texture_options.upload_format;
+        auto gl_format = get_gl_format(format);
+        Tungsten::set_texture_image_2d(GL_TEXTURE_2D, 0, GLint(gl_format),
+                                       int(img.width()), int(img.height()),
+                                       gl_format, GL_UNSIGNED_BYTE, nullptr);
+        auto row_size = img.width() * get_pixel_size(format);
+        pending->memory = img.height() * row_size;
+        pending->upload = IncrementalUpload(
+            img.height(), row_size,
+            [this, &img, format](size_t first_row, size_t row_count)
+            {
+                staging_.set_rows(img, format, first_row, row_count);
+            },
+            budget);
+    }
+    pending_ = std::move(pending);
+}
+
+bool Sphere::continue_upload()
+{
+    if (!pending_)
+        return false;
+
+    Tungsten::bind_texture(GL_TEXTURE_2D, pending_->handle);
+    if (!pending_->upload.upload_next_stripes())
+        return false;
+
+    finish_upload();
+    return true;
+}
+
+bool Sphere::is_uploading() const
+{
+    return pending_ != nullptr;
+}
+
+void Sphere::finish_upload()
+{
+    const auto& texture = pending_->texture;
+    if (texture.atlas_bands.empty())
+    {
+        use_standard_mesh();
+    }
+    else
+    {
+        auto [width, height] = texture.etc2_image.blocks.empty()
+                               ? std::pair(texture.image.width(), texture.image.height())
+                               : std::pair(texture.etc2_image.width, texture.etc2_image.height);
+        set_mesh(make_atlas_sphere(texture.atlas_bands, width, height,
+                                   texture.atlas_source_height, points_));
+        has_atlas_mesh_ = true;
+    }
+
+    const auto& upload = pending_->upload;
+    texture_ = std::move(pending_->handle);
+    is_half_float_ = !texture.half_float_image.pixels.empty();
+    texture_memory_ = pending_->memory;
+    texture_height_ = get_texture_height(texture);
+    has_mipmaps_ = false;
+    is_mipmap_filter_ = false;
+    if (texture_options.mipmaps && texture.atlas_bands.empty()
+        && texture.etc2_image.blocks.empty() && !is_half_float_)
+    {
+        generate_mipmaps();
+    }
+    upload_time_ms_ = upload.upload_ms();
+    upload_frame_count_ = upload.frame_count();
+    if (upload_frame_count_ > 1)
+    {
+        SDL_Log("Uploaded texture over %d frames in %.1f ms, %.1f ms of"
+                " which were spent uploading.", upload_frame_count_,
+                upload.elapsed_ms(), upload_time_ms_);
+    }
+    pending_.reset();
+}
+
+TextureLimits Sphere::texture_limits() const
+{
+    GLint size = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &size);
+    return {size, is_compressed_format_supported(GL_COMPRESSED_RGB8_ETC2),
+            is_half_float_supported()};
+}
+
+bool Sphere::begin_partial_image(size_t width, size_t height,
+                                 Yimage::PixelType pixel_type)
+{
+    if (!can_upload_partially(width, height, pixel_type, texture_options,
+                              texture_limits()))
+    {
+        return false;
+    }
+
+    pending_.reset();
+    use_standard_mesh();
+    is_half_float_ = false;
+    partial_format_ = texture_options.upload_format;
+    Tungsten::bind_texture(GL_TEXTURE_2D, texture_);
+    // The previous image's mipmaps don't match the new size.
+    set_texture_parameters();
+    has_mipmaps_ = false;
+    is_mipmap_filter_ = false;
+    auto gl_format = get_gl_format(partial_format_);
+    Tungsten::set_texture_image_2d(GL_TEXTURE_2D, 0, GLint(gl_format),
+                                   int(width), int(height),
+                                   gl_format, GL_UNSIGNED_BYTE, nullptr);
+    texture_memory_ = width * height * get_pixel_size(partial_format_);
+    texture_height_ = height;
+    return true;
+}
+
+void Sphere::update_partial_image(const Yimage::Image& img,
+                                  size_t first_row, size_t row_count)
+{
+    Tungsten::bind_texture(GL_TEXTURE_2D, texture_);
+    staging_.set_rows(img, partial_format_, first_row, row_count);
+}
+
+void Sphere::end_partial_image()
+{
+    if (texture_options.mipmaps && !has_mipmaps_)
+        generate_mipmaps();
+}
+
+void Sphere::set_tessellation(int circles, int points)
+{
+    if (circles == circles_ && points == points_)
+        return;
+
+    circles_ = circles;
+    points_ = points;
+    if (!has_atlas_mesh_)
+        set_mesh(make_sphere(circles_, points_));
+}
+
+size_t Sphere::texture_memory() const
+{
+    return texture_memory_;
+}
+
+double Sphere::upload_time_ms() const
+{
+    return upload_time_ms_;
+}
+
+int Sphere::upload_frame_count() const
+{
+    return upload_frame_count_;
+}
+
+size_t Sphere::triangle_count() const
+{
+    if (is_ray_casting())
+        return 1;
+    return (vertex_array_.indexes.size() - size_t(line_count_)) / 3;
+}
+
+std::vector<AssetMemory> Sphere::asset_memory() const
+{
+    std::vector<AssetMemory> result{{"texture", 0, texture_memory_}};
+    if (pending_)
+    {
+        result.push_back({"pending texture", get_host_bytes(pending_->texture),
+                          pending_->memory});
+    }
+    result.push_back({"staging buffer", staging_.buffer_size(), 0});
+    return result;
+}
+
+void Sphere::set_mesh(Tungsten::ArrayBuffer<Detail::Vertex> array)
+{
+    auto count = int(array.indexes.size());
+
+    triangle_indexes_to_lines(array.indexes.data(),
+                              array.indexes.size(),
+                              array.indexes);
+
+    line_count_ = int(array.indexes.size()) - count;
+
+    Tungsten::set_buffers(vertex_array_, array);
+}
+
+void Sphere::use_standard_mesh()
+{
+    if (has_atlas_mesh_)
+    {
+        set_mesh(make_sphere(circles_, points_));
+        has_atlas_mesh_ = false;
+    }
+}
+
+// The mesh is rarely shown, so its shader program isn't compiled until
+// it is needed. The vertex array must be bound.
+void Sphere::setup_line_program()
+{
     line_program_.setup();
     Tungsten::use_program(line_program_.program);
     line_program_.color.set({1.f, 0.f, 0.f, 1.f});
     vertex_array_.define_float_pointer(line_program_.position, 3, 0);
     Tungsten::enable_vertex_attribute(line_program_.position);
+    has_line_program_ = true;
 }
 
-void Sphere::set_image(const Yimage::Image& img)
+void Sphere::generate_mipmaps()
 {
     Tungsten::bind_texture(GL_TEXTURE_2D, texture_);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    has_mipmaps_ = true;
+    set_mipmap_filter(true);
+    texture_memory_ += texture_memory_ / 3;
+}
 
-    auto [format, type] = Tungsten::get_ogl_pixel_type(img.pixel_type());
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    Tungsten::set_texture_image_2d(GL_TEXTURE_2D, 0, GL_RGB,
-                                   int(img.width()), int(img.height()),
-                                   format, type,
-                                   img.data());
+// The texture must be bound.
+void Sphere::set_mipmap_filter(bool enabled)
+{
+    enabled = enabled && has_mipmaps_;
+    if (enabled == is_mipmap_filter_)
+        return;
+    Tungsten::set_texture_min_filter(GL_TEXTURE_2D, enabled
+                                                    ? GL_LINEAR_MIPMAP_LINEAR
+                                                    : GL_LINEAR);
+    is_mipmap_filter_ = enabled;
+}
+
+bool Sphere::is_ray_casting() const
+{
+    return render_mode == SphereRenderMode::RAY_CAST && !has_atlas_mesh_;
+}
+
+void Sphere::setup_ray_cast()
+{
+    // One triangle that covers the screen, its corners outside the
+    // screen are clipped away.
+    float triangle[] = {-1, -1,
+                        3, -1,
+                        -1, 3};
+    ray_cast_array_ = Tungsten::generate_vertex_array();
+    Tungsten::bind_vertex_array(ray_cast_array_);
+    ray_cast_buffer_ = Tungsten::generate_buffer();
+    Tungsten::bind_buffer(GL_ARRAY_BUFFER, ray_cast_buffer_);
+    Tungsten::set_buffer_data(GL_ARRAY_BUFFER, sizeof(triangle), triangle,
+                              GL_STATIC_DRAW);
+    ray_cast_program_.setup();
+    Tungsten::use_program(ray_cast_program_.program);
+    ray_cast_program_.texture.set(0);
+    Tungsten::define_vertex_attribute_float_pointer(
+        ray_cast_program_.position, 2, 2 * sizeof(float), 0);
+    Tungsten::enable_vertex_attribute(ray_cast_program_.position);
+    has_ray_cast_ = true;
+}
+
+void Sphere::draw_ray_cast(const Xyz::Matrix4F& mv_matrix,
+                           const Xyz::Matrix4F& p_matrix,
+                           StereoEye eye)
+{
+    if (!has_ray_cast_)
+        setup_ray_cast();
+
+    Tungsten::bind_texture(GL_TEXTURE_2D, texture_);
+    // The texture coordinates jump at the seam behind the viewer, which
+    // would make the GPU pick the smallest mipmap along it.
+    set_mipmap_filter(false);
+    Tungsten::bind_vertex_array(ray_cast_array_);
+    Tungsten::use_program(ray_cast_program_.program);
+    auto inv_p_matrix = Xyz::invert(p_matrix);
+    ray_cast_program_.inv_mv_matrix.set(Xyz::invert(mv_matrix));
+    ray_cast_program_.inv_p_matrix.set(inv_p_matrix);
+    ray_cast_program_.exposure.set(std::exp2(exposure));
+    ray_cast_program_.tone_map.set(get_tone_map_mode(is_half_float_,
+                                                     tone_mapping));
+    ray_cast_program_.texture_transform.set(
+        get_texture_transform(stereo_layout, eye));
+    ray_cast_program_.texture_v_range.set(
+        get_texture_v_range(stereo_layout, eye, texture_height_));
+    if (show_mesh)
+    {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        ray_cast_program_.grid_size.set({float(points_), float(circles_)});
+        ray_cast_program_.pixel_angle.set(get_pixel_angle(inv_p_matrix,
+                                                          viewport[2]));
+    }
+    else
+    {
+        ray_cast_program_.grid_size.set({0, 0});
+    }
+    glDrawArrays(GL_TRIANGLES, 0, 3);
 }
 
 void Sphere::draw(const Xyz::Matrix4F& mv_matrix,
-                  const Xyz::Matrix4F& p_matrix)
+                  const Xyz::Matrix4F& p_matrix,
+                  StereoEye eye)
 {
+    if (is_ray_casting())
+    {
+        draw_ray_cast(mv_matrix, p_matrix, eye);
+        return;
+    }
+
     Tungsten::bind_texture(GL_TEXTURE_2D, texture_);
+    // The smaller mipmaps blend the rows on both sides of the border
+    // between the eyes of a stereo image, however the coordinates are
+    // clamped.
+    set_mipmap_filter(stereo_layout == StereoLayout::MONO);
     vertex_array_.bind();
     Tungsten::use_program(program_.program);
     program_.mv_matrix.set(mv_matrix);
     program_.p_matrix.set(p_matrix);
+    program_.mip_bias.set(mip_bias);
+    program_.texture_transform.set(get_texture_transform(stereo_layout, eye));
+    program_.texture_v_range.set(get_texture_v_range(stereo_layout, eye,
+                                                     texture_height_));
+    program_.exposure.set(std::exp2(exposure));
+    program_.tone_map.set(get_tone_map_mode(is_half_float_, tone_mapping));
     auto triangle_count = int(vertex_array_.indexes.size() - line_count_);
     Tungsten::draw_triangle_elements_16(0, triangle_count);
 
     if (show_mesh)
     {
+        if (!has_line_program_)
+            setup_line_program();
         Tungsten::use_program(line_program_.program);
         line_program_.mv_matrix.set(mv_matrix);
         line_program_.p_matrix.set(p_matrix);
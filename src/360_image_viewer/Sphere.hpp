@@ -6,11 +6,117 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <memory>
 #include <Tungsten/Tungsten.hpp>
 #include <Yimage/Yimage.hpp>
+#include "AssetMemory.hpp"
+#include "Etc2Codec.hpp"
+#include "HalfFloatImage.hpp"
+#include "IncrementalUpload.hpp"
+#include "LatitudeAtlas.hpp"
+#include "RayCastShaderProgram.hpp"
 #include "Render3DShaderProgram.hpp"
+#include "TextureStaging.hpp"
 #include "Unicolor3DShaderProgram.hpp"
 
+struct TextureOptions
+{
+    // Images larger than this, or than GL_MAX_TEXTURE_SIZE, are scaled
+    // down before they are uploaded. 0 means no limit besides the driver's.
+    int max_size = 0;
+    // Upload textures as ETC2 if the driver supports it.
+    bool use_etc2 = false;
+    // Where encoded ETC2 textures are cached. Empty means no caching.
+    std::string cache_dir;
+    // Store the image as bands whose widths decrease towards the poles.
+    bool latitude_atlas = false;
+    // The format of textures that are neither ETC2 nor half floats.
+    UploadFormat upload_format = UploadFormat::RGB;
+    // Generate mipmaps for 8-bit textures that are neither ETC2 nor
+    // latitude atlases. They use a third more memory.
+    bool mipmaps = false;
+};
+
+// The properties of the graphics driver that decide how an image must
+// be prepared before it can be used as a texture.
+struct TextureLimits
+{
+    int max_size = 0;
+    bool supports_etc2 = false;
+    bool supports_half_float = false;
+};
+
+// An image that has been scaled, compressed and rearranged as required
+// by the texture options.
+struct SphereTexture
+{
+    Yimage::Image image;
+    // Used instead of image if use_etc2 is set and the driver supports it.
+    Etc2Image etc2_image;
+    // Used instead of image for 16-bit images if the driver supports
+    // half-float textures.
+    HalfFloatImage half_float_image;
+    // Not empty if the texture is a latitude atlas.
+    std::vector<LatitudeBand> atlas_bands;
+    size_t atlas_source_height = 0;
+};
+
+// Returns the number of bytes in the texture's pixels or compressed
+// blocks.
+[[nodiscard]]
+size_t get_host_bytes(const SphereTexture& texture);
+
+// Does all the CPU work needed before img can be uploaded. Unlike the
+// rest of Sphere, this function can be called from any thread.
+[[nodiscard]]
+SphereTexture prepare_sphere_texture(Yimage::Image img,
+                                     const TextureOptions& options,
+                                     const TextureLimits& limits);
+
+// Returns true if an image with the given size and pixel type can be
+// uploaded a band of rows at a time with Sphere::begin_partial_image.
+// Can be called from any thread.
+[[nodiscard]]
+bool can_upload_partially(size_t width, size_t height,
+                          Yimage::PixelType pixel_type,
+                          const TextureOptions& options,
+                          const TextureLimits& limits);
+
+enum class SphereRenderMode
+{
+    // Draws the textured sphere mesh.
+    MESH,
+    // Draws a single triangle that covers the screen and computes the
+    // texture coordinates of each pixel from its view ray. Latitude
+    // atlases are still drawn with the mesh.
+    RAY_CAST
+};
+
+// How the views of the two eyes are stored in a stereo panorama.
+enum class StereoLayout
+{
+    MONO,
+    // The left eye's equirectangular image is above the right eye's,
+    // both are uploaded as a single texture.
+    OVER_UNDER
+};
+
+enum class StereoEye
+{
+    LEFT,
+    RIGHT
+};
+
+// How half-float textures are mapped to the screen's range after the
+// exposure has been applied.
+enum class ToneMapping
+{
+    CLIP,
+    REINHARD,
+    // Krzysztof Narkowicz's fit of the ACES filmic curve.
+    ACES
+};
+
 namespace Detail
 {
     struct Vertex
@@ -25,18 +131,137 @@ class Sphere
 public:
     Sphere(int circles, int points);
 
-    Sphere(const Yimage::Image& img, int circles, int points);
+    Sphere(Yimage::Image img, int circles, int points);
+
+    void set_image(Yimage::Image img);
 
-    void set_image(const Yimage::Image& img);
+    // Uploads texture and starts drawing it right away.
+    void set_texture(SphereTexture texture);
 
-    void draw(const Xyz::Matrix4F& mv_matrix, const Xyz::Matrix4F& p_matrix);
+    // Starts uploading texture to a new OpenGL texture, one stripe of
+    // rows at a time. The current texture is drawn until continue_upload
+    // has uploaded the last stripe.
+    void start_upload(SphereTexture texture, const UploadBudget& budget);
+
+    // Uploads as many stripes as the budget allows. Returns true if the
+    // upload finished and the new texture is now drawn.
+    bool continue_upload();
+
+    [[nodiscard]]
+    bool is_uploading() const;
+
+    [[nodiscard]]
+    TextureLimits texture_limits() const;
+
+    // Allocates the texture for an image that is uploaded a band of rows
+    // at a time with update_partial_image. Returns false if the image
+    // must be set with set_image instead, because it needs to be scaled,
+    // compressed or rearranged.
+    bool begin_partial_image(size_t width, size_t height,
+                             Yimage::PixelType pixel_type);
+
+    void update_partial_image(const Yimage::Image& img,
+                              size_t first_row, size_t row_count);
+
+    // Must be called when the last rows of a partial image have been
+    // uploaded.
+    void end_partial_image();
+
+    // Replaces the sphere mesh with one with the given number of
+    // circles and points. A latitude atlas keeps its mesh until the next
+    // image is set.
+    void set_tessellation(int circles, int points);
+
+    // Draws the sphere with the half of the texture that belongs to eye
+    // if the image is a stereo panorama.
+    void draw(const Xyz::Matrix4F& mv_matrix, const Xyz::Matrix4F& p_matrix,
+              StereoEye eye = StereoEye::LEFT);
+
+    // The number of bytes in the texture's pixels or compressed blocks.
+    [[nodiscard]]
+    size_t texture_memory() const;
+
+    // The time spent converting and uploading the current texture.
+    [[nodiscard]]
+    double upload_time_ms() const;
+
+    // The number of frames the current texture's upload was spread over.
+    [[nodiscard]]
+    int upload_frame_count() const;
+
+    [[nodiscard]]
+    size_t triangle_count() const;
+
+    // Returns the memory used by the current texture, the texture that
+    // is being uploaded, if any, and the staging buffer. The host copy
+    // of an image is released as soon as it has been uploaded.
+    [[nodiscard]]
+    std::vector<AssetMemory> asset_memory() const;
 
     bool show_mesh = false;
+    SphereRenderMode render_mode = SphereRenderMode::MESH;
+    StereoLayout stereo_layout = StereoLayout::MONO;
+    // In stops. The exposure and tone mapping only apply to half-float
+    // textures.
+    float exposure = 0;
+    ToneMapping tone_mapping = ToneMapping::CLIP;
+    // Added to the texture's level of detail, positive values make the
+    // image blurrier and faster to draw. It only applies to mono
+    // textures with mipmaps drawn with the mesh.
+    float mip_bias = 0;
+    TextureOptions texture_options;
 private:
+    struct PendingTexture
+    {
+        SphereTexture texture;
+        Tungsten::TextureHandle handle;
+        IncrementalUpload upload;
+        size_t memory = 0;
+    };
+
+    void finish_upload();
+
+    void generate_mipmaps();
+
+    void set_mipmap_filter(bool enabled);
+
+    void set_mesh(Tungsten::ArrayBuffer<Detail::Vertex> array);
+
+    void use_standard_mesh();
+
+    void setup_line_program();
+
+    [[nodiscard]]
+    bool is_ray_casting() const;
+
+    void setup_ray_cast();
+
+    void draw_ray_cast(const Xyz::Matrix4F& mv_matrix,
+                       const Xyz::Matrix4F& p_matrix,
+                       StereoEye eye);
+
+    int circles_ = 0;
+    int points_ = 0;
+    bool has_atlas_mesh_ = false;
+    bool has_line_program_ = false;
+    bool has_ray_cast_ = false;
+    bool is_half_float_ = false;
+    bool has_mipmaps_ = false;
+    bool is_mipmap_filter_ = false;
+    UploadFormat partial_format_ = UploadFormat::RGB;
     int line_count_ = 0;
+    size_t texture_memory_ = 0;
+    size_t texture_height_ = 0;
+    double upload_time_ms_ = 0;
+    int upload_frame_count_ = 0;
     std::vector<Tungsten::BufferHandle> buffers_;
     Tungsten::VertexArray<Detail::Vertex> vertex_array_;
     Tungsten::TextureHandle texture_;
+    TextureStaging staging_;
+    std::unique_ptr<PendingTexture> pending_;
     Render3DShaderProgram program_;
     Unicolor3DShaderProgram line_program_;
+    Tungsten::BufferHandle ray_cast_buffer_;
+    Tungsten::VertexArrayHandle ray_cast_array_;
+    RayCastShaderProgram ray_cast_program_;
 };
@@ -22,26 +22,8 @@ namespace
     [[nodiscard]]
     Xyz::Vector2D calc_screen_factors(const ViewParams& vp)
     {
-        auto [hor_res, ver_res] = vp.screen_res;
-        double hor_view_angle, ver_view_angle;
-        if (hor_res >= ver_res)
-        {
-            hor_view_angle = vp.view_angle;
-            ver_view_angle = ver_res * vp.view_angle / hor_res;
-        }
-        else
-        {
-            hor_view_angle = hor_res * vp.view_angle / ver_res;
-            ver_view_angle = vp.view_angle;
-        }
-
-        auto calc_size = [&vp](double angle)
-        {
-            return sin(angle / 2) * vp.eye_dist
-                   / (vp.eye_dist + cos(angle / 2));
-        };
-
-        return {calc_size(hor_view_angle), calc_size(ver_view_angle)};
+        return ::calc_screen_factors(vp.screen_res, vp.view_angle,
+                                     vp.eye_dist);
     }
 
     [[nodiscard]]
@@ -49,11 +31,9 @@ namespace
     calc_screen_vectors(const ViewParams& vp,
                         const Xyz::SphericalPointD& cp)
     {
-        auto up = to_cartesian(Xyz::SphericalPoint(1.0, cp.azimuth, cp.polar + PI / 2));
-        auto fwd = to_cartesian(Xyz::SphericalPoint(1.0, cp.azimuth, cp.polar));
-        auto right = cross(fwd, up);
+        auto vectors = calc_view_vectors(cp);
         auto factors = calc_screen_factors(vp);
-        return {factors[0] * right, factors[1] * up};
+        return {factors[0] * vectors.right, factors[1] * vectors.up};
     }
 
     [[nodiscard]]
@@ -65,16 +45,7 @@ namespace
         auto [right, up] = calc_screen_vectors(vp, screen_center);
         auto scr = screen_pos[0] * right + screen_pos[1] * up;
         auto eye = -vp.eye_dist * to_cartesian(screen_center);
-        auto delta = scr - eye;
-        auto a = get_length_squared(delta);
-        auto b = 2 * dot(eye, delta);
-        auto c = get_length_squared(eye) - 1;
-        auto solutions = Xyz::solve_real_quadratic_equation(a, b, c);
-        if (!solutions)
-            throw std::runtime_error("Can not find a point on the sphere.");
-
-        auto t = std::max(solutions->first, solutions->second);
-        return eye + t * delta;
+        return calc_sphere_exit_point(eye, scr - eye);
     }
 
     [[nodiscard]]
@@ -103,6 +74,28 @@ namespace
     }
 }
 
+Xyz::Vector2D calc_screen_factors(const Xyz::Vector2D& screen_res,
+                                  double view_angle, double eye_dist)
+{
+    // The view angle applies to the longer side of the screen. The
+    // other side is scaled linearly to keep the pixels square, as a
+    // perspective projection does.
+    auto [hor_res, ver_res] = screen_res;
+    auto size = sin(view_angle / 2) * eye_dist
+                / (eye_dist + cos(view_angle / 2));
+    if (hor_res >= ver_res)
+        return {size, size * ver_res / hor_res};
+    else
+        return {size * hor_res / ver_res, size};
+}
+
+ViewVectors calc_view_vectors(const Xyz::SphericalPointD& center)
+{
+    auto up = to_cartesian(Xyz::SphericalPoint(1.0, center.azimuth, center.polar + PI / 2));
+    auto fwd = to_cartesian(Xyz::SphericalPoint(1.0, center.azimuth, center.polar));
+    return {fwd, cross(fwd, up), up};
+}
+
 Xyz::Vector3D SpherePosCalculator::calc_center_pos()
 {
     ensure_valid_center_pos();
@@ -6,8 +6,45 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <algorithm>
 #include <optional>
-#include <Xyz/SphericalPoint.hpp>
+#include <stdexcept>
+#include <Xyz/Xyz.hpp>
+
+// Returns the distances from the center of the screen to its right and
+// top edges, measured in the plane through the sphere's center.
+[[nodiscard]]
+Xyz::Vector2D calc_screen_factors(const Xyz::Vector2D& screen_res,
+                                  double view_angle, double eye_dist);
+
+// Unit vectors pointing forward, right and up for an observer at the
+// sphere's center looking at a given point on the sphere.
+struct ViewVectors
+{
+    Xyz::Vector3D forward;
+    Xyz::Vector3D right;
+    Xyz::Vector3D up;
+};
+
+[[nodiscard]]
+ViewVectors calc_view_vectors(const Xyz::SphericalPointD& center);
+
+// Returns the point where the ray from origin in the direction of delta
+// leaves the unit sphere. origin must be inside the sphere.
+[[nodiscard]]
+inline Xyz::Vector3D calc_sphere_exit_point(const Xyz::Vector3D& origin,
+                                            const Xyz::Vector3D& delta)
+{
+    auto a = get_length_squared(delta);
+    auto b = 2 * dot(origin, delta);
+    auto c = get_length_squared(origin) - 1;
+    auto solutions = Xyz::solve_real_quadratic_equation(a, b, c);
+    if (!solutions)
+        throw std::runtime_error("Can not find a point on the sphere.");
+
+    auto t = std::max(solutions->first, solutions->second);
+    return origin + t * delta;
+}
 
 class SpherePosCalculator
 {
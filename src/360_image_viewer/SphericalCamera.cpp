@@ -0,0 +1,158 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "SphericalCamera.hpp"
+
+#include <algorithm>
+#include <Xyz/Xyz.hpp>
+
+Xyz::Vector3D SphericalCamera::calc_center_pos()
+{
+    return calculator_.calc_center_pos();
+}
+
+Xyz::Vector3D SphericalCamera::calc_eye_pos()
+{
+    return calculator_.calc_eye_pos();
+}
+
+Xyz::Vector3D SphericalCamera::calc_up_vector()
+{
+    return calculator_.calc_up_vector();
+}
+
+Xyz::SphericalPointD
+SphericalCamera::calc_sphere_pos(const Xyz::Vector2D& screen_pos)
+{
+    return calculator_.calc_sphere_pos(screen_pos);
+}
+
+void SphericalCamera::set_direction(double azimuth, double polar)
+{
+    calculator_.set_fixed_point({0, 0}, {1.0, azimuth, polar});
+}
+
+void SphericalCamera::begin_drag(const Xyz::Vector2D& screen_pos,
+                                 Clock::time_point time)
+{
+    prev_center_points_.clear();
+    prev_center_points_.push_back({
+        time,
+        Xyz::to_spherical(calculator_.calc_center_pos())
+    });
+    calculator_.set_fixed_point(screen_pos,
+                                calculator_.calc_sphere_pos(screen_pos));
+    motion_ = {};
+}
+
+void SphericalCamera::drag(const Xyz::Vector2D& screen_pos,
+                           Clock::time_point time)
+{
+    calculator_.set_fixed_point(screen_pos,
+                                calculator_.fixed_point().second);
+    prev_center_points_.push_back({
+        time,
+        Xyz::to_spherical(calculator_.calc_center_pos())
+    });
+}
+
+bool SphericalCamera::end_drag(Clock::time_point time)
+{
+    using namespace std::chrono;
+    calculator_.clear_fixed_point();
+    motion_ = {};
+
+    auto it = std::find_if(prev_center_points_.begin(),
+                           prev_center_points_.end(),
+                           [&](const auto& p)
+                           {
+                               return duration<double>(time - p.first).count()
+                                      < MAX_CENTER_POINT_AGE;
+                           });
+
+    if (it == prev_center_points_.end())
+        return false;
+
+    const auto& [time0, pos0] = *it;
+    const auto& [time1, pos1] = prev_center_points_.back();
+    auto secs = duration<double>(time - time0).count();
+    auto azimuth_speed = Xyz::clamp((pos1.azimuth - pos0.azimuth) / secs,
+                                    -MAX_SPEED, MAX_SPEED);
+    auto polar_speed = Xyz::clamp((pos1.polar - pos0.polar) / secs,
+                                  -MAX_SPEED, MAX_SPEED);
+    auto max_speed = std::max(std::abs(azimuth_speed),
+                              std::abs(polar_speed));
+
+    auto length = duration<double>(get_inertia_duration(max_speed));
+    auto end_time = time + duration_cast<Clock::duration>(length);
+    motion_ = ScreenMotion{time, end_time, pos1, azimuth_speed, polar_speed};
+    return true;
+}
+
+bool SphericalCamera::update_motion(Clock::time_point time)
+{
+    using namespace std::chrono;
+    if (!motion_)
+        return false;
+
+    if (time >= motion_->end_time)
+    {
+        motion_.reset();
+        return false;
+    }
+
+    constexpr auto pi = Xyz::Constants<double>::PI;
+    auto secs = duration<double>(time - motion_->start_time).count();
+    auto max_speed = std::max(std::abs(motion_->azimuth_speed),
+                              std::abs(motion_->polar_speed));
+    auto factor = get_inertia_factor(max_speed, secs);
+    auto az = motion_->origin.azimuth + motion_->azimuth_speed * factor;
+    if (az < -pi)
+        az += 2 * pi;
+    else if (az > pi)
+        az -= 2 * pi;
+    auto po = Xyz::clamp(motion_->origin.polar + motion_->polar_speed * factor,
+                         -pi / 2, pi / 2);
+
+    calculator_.set_fixed_point({0, 0}, {1.0, az, po});
+    return true;
+}
+
+bool SphericalCamera::is_moving() const
+{
+    return motion_.has_value();
+}
+
+double SphericalCamera::eye_dist() const
+{
+    return calculator_.eye_dist();
+}
+
+void SphericalCamera::set_eye_dist(double eye_dist)
+{
+    calculator_.set_eye_dist(eye_dist);
+}
+
+double SphericalCamera::view_angle() const
+{
+    return calculator_.view_angle();
+}
+
+void SphericalCamera::set_view_angle(double view_angle)
+{
+    calculator_.set_view_angle(view_angle);
+}
+
+Xyz::Vector2D SphericalCamera::screen_res() const
+{
+    return calculator_.screen_res();
+}
+
+void SphericalCamera::set_screen_res(const Xyz::Vector2D& screen_res)
+{
+    calculator_.set_screen_res(screen_res);
+}
@@ -0,0 +1,77 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <optional>
+#include "Camera.hpp"
+#include "RingBuffer.hpp"
+#include "SpherePosCalculator.hpp"
+
+// A camera whose direction is an azimuth and a polar angle. The up
+// vector always points towards the north pole, which means the camera
+// can't roll and that it stops at the poles.
+class SphericalCamera : public Camera
+{
+public:
+    [[nodiscard]]
+    Xyz::Vector3D calc_center_pos() override;
+
+    [[nodiscard]]
+    Xyz::Vector3D calc_eye_pos() override;
+
+    [[nodiscard]]
+    Xyz::Vector3D calc_up_vector() override;
+
+    [[nodiscard]]
+    Xyz::SphericalPointD calc_sphere_pos(const Xyz::Vector2D& screen_pos) override;
+
+    void set_direction(double azimuth, double polar) override;
+
+    void begin_drag(const Xyz::Vector2D& screen_pos,
+                    Clock::time_point time) override;
+
+    void drag(const Xyz::Vector2D& screen_pos,
+              Clock::time_point time) override;
+
+    bool end_drag(Clock::time_point time) override;
+
+    bool update_motion(Clock::time_point time) override;
+
+    [[nodiscard]]
+    bool is_moving() const override;
+
+    [[nodiscard]]
+    double eye_dist() const override;
+
+    void set_eye_dist(double eye_dist) override;
+
+    [[nodiscard]]
+    double view_angle() const override;
+
+    void set_view_angle(double view_angle) override;
+
+    [[nodiscard]]
+    Xyz::Vector2D screen_res() const override;
+
+    void set_screen_res(const Xyz::Vector2D& screen_res) override;
+private:
+    using PrevPositionList = Chorasmia::RingBuffer<
+        std::pair<Clock::time_point, Xyz::SphericalPointD>, 4>;
+
+    struct ScreenMotion
+    {
+        Clock::time_point start_time = {};
+        Clock::time_point end_time = {};
+        Xyz::SphericalPointD origin;
+        double azimuth_speed = 0;
+        double polar_speed = 0;
+    };
+
+    SpherePosCalculator calculator_;
+    PrevPositionList prev_center_points_;
+    std::optional<ScreenMotion> motion_;
+};
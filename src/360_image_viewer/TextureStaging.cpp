@@ -0,0 +1,187 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "TextureStaging.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "PixelKernels.hpp"
+
+namespace
+{
+    // Images that must be converted are uploaded in bands of at most
+    // this many bytes.
+    constexpr size_t MAX_BUFFER_SIZE = 4 * 1024 * 1024;
+
+    size_t get_aligned_row_size(size_t width, UploadFormat format)
+    {
+        return (width * get_pixel_size(format) + 3) & ~size_t(3);
+    }
+
+    bool is_upload_ready(const Yimage::Image& img, UploadFormat format)
+    {
+        auto type = format == UploadFormat::RGB ? Yimage::PixelType::RGB_8
+                                                : Yimage::PixelType::RGBA_8;
+        return img.pixel_type() == type
+               && img.row_size() == get_aligned_row_size(img.width(), format)
+               && reinterpret_cast<uintptr_t>(img.data()) % 4 == 0;
+    }
+
+    size_t get_band_rows(const Yimage::Image& img, UploadFormat format)
+    {
+        if (is_upload_ready(img, format))
+            return img.height();
+        auto row_size = get_aligned_row_size(img.width(), format);
+        return std::max<size_t>(MAX_BUFFER_SIZE / row_size, 1);
+    }
+
+    // rgb_row is only used when mono pixels are converted to RGBA.
+    void convert_row(const uint8_t* src, Yimage::PixelType type,
+                     uint8_t* dst, UploadFormat format, size_t width,
+                     std::vector<uint8_t>& rgb_row)
+    {
+        const auto& kernels = get_pixel_kernels();
+        const bool is_rgba = format == UploadFormat::RGBA;
+        switch (type)
+        {
+        case Yimage::PixelType::MONO_8:
+            if (!is_rgba)
+            {
+                kernels.mono_to_rgb(src, dst, width);
+                break;
+            }
+            rgb_row.resize(width * 3);
+            kernels.mono_to_rgb(src, rgb_row.data(), width);
+            kernels.rgb_to_rgba(rgb_row.data(), dst, width);
+            break;
+        case Yimage::PixelType::MONO_ALPHA_8:
+            for (size_t x = 0; x < width; ++x, src += 2)
+            {
+                *dst++ = src[0];
+                *dst++ = src[0];
+                *dst++ = src[0];
+                if (is_rgba)
+                    *dst++ = src[1];
+            }
+            break;
+        case Yimage::PixelType::RGB_8:
+            if (is_rgba)
+                kernels.rgb_to_rgba(src, dst, width);
+            else
+                memcpy(dst, src, width * 3);
+            break;
+        case Yimage::PixelType::RGBA_8:
+            if (is_rgba)
+                memcpy(dst, src, width * 4);
+            else
+                kernels.rgba_to_rgb(src, dst, width);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+GLenum get_gl_format(UploadFormat format)
+{
+    return format == UploadFormat::RGBA ? GL_RGBA : GL_RGB;
+}
+
+size_t get_pixel_size(UploadFormat format)
+{
+    return format == UploadFormat::RGBA ? 4 : 3;
+}
+
+bool is_stageable(Yimage::PixelType type)
+{
+    switch (type)
+    {
+    case Yimage::PixelType::MONO_8:
+    case Yimage::PixelType::MONO_ALPHA_8:
+    case Yimage::PixelType::RGB_8:
+    case Yimage::PixelType::RGBA_8:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void TextureStaging::set_image(const Yimage::Image& img, UploadFormat format)
+{
+    auto gl_format = get_gl_format(format);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (is_upload_ready(img, format))
+    {
+        Tungsten::set_texture_image_2d(GL_TEXTURE_2D, 0, GLint(gl_format),
+                                       int(img.width()), int(img.height()),
+                                       gl_format, GL_UNSIGNED_BYTE,
+                                       img.data());
+        return;
+    }
+
+    Tungsten::set_texture_image_2d(GL_TEXTURE_2D, 0, GLint(gl_format),
+                                   int(img.width()), int(img.height()),
+                                   gl_format, GL_UNSIGNED_BYTE, nullptr);
+    set_rows(img, format, 0, img.height());
+}
+
+void TextureStaging::set_rows(const Yimage::Image& img, UploadFormat format,
+                              size_t first_row, size_t row_count)
+{
+    auto band_rows = get_band_rows(img, format);
+    auto end_row = first_row + row_count;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    for (auto row = first_row; row < end_row; row += band_rows)
+    {
+        auto staged = stage(img, format, row, std::min(band_rows, end_row - row));
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, GLint(row),
+                        GLsizei(staged.width), GLsizei(staged.row_count),
+                        staged.format, GL_UNSIGNED_BYTE, staged.data);
+    }
+}
+
+StagedPixels TextureStaging::stage(const Yimage::Image& img,
+                                   UploadFormat format,
+                                   size_t first_row, size_t row_count)
+{
+    if (!is_stageable(img.pixel_type()))
+    {
+        throw std::runtime_error("Can't use images with pixel type "
+                                 + std::to_string(int(img.pixel_type()))
+                                 + " as textures.");
+    }
+    if (first_row + row_count > img.height())
+        throw std::runtime_error("The rows to stage are outside the image.");
+
+    if (is_upload_ready(img, format))
+    {
+        return {img.data() + first_row * img.row_size(), img.width(),
+                row_count, get_gl_format(format)};
+    }
+
+    auto row_size = get_aligned_row_size(img.width(), format);
+    if (buffer_.size() < row_size * row_count)
+        buffer_.resize(row_size * row_count);
+
+    // The conversion is memory-bound and runs on the GL thread, where
+    // starting threads for every band costs more than it saves, and can
+    // block the browser's main thread in WebAssembly builds.
+    for (size_t i = 0; i < row_count; ++i)
+    {
+        convert_row(img.data() + (first_row + i) * img.row_size(),
+                    img.pixel_type(), buffer_.data() + i * row_size,
+                    format, img.width(), rgb_row_);
+    }
+    return {buffer_.data(), img.width(), row_count, get_gl_format(format)};
+}
+
+size_t TextureStaging::buffer_size() const
+{
+    return buffer_.size() + rgb_row_.size();
+}
@@ -0,0 +1,79 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <Tungsten/Tungsten.hpp>
+#include <Yimage/Yimage.hpp>
+
+// The pixel formats of 8-bit textures. The texture's internal format is
+// always the same as the format of the uploaded pixels.
+enum class UploadFormat
+{
+    RGB,
+    // Uses a third more texture memory than RGB, but some drivers only
+    // have fast upload paths for four-byte pixels.
+    RGBA
+};
+
+[[nodiscard]]
+GLenum get_gl_format(UploadFormat format);
+
+[[nodiscard]]
+size_t get_pixel_size(UploadFormat format);
+
+// Returns true for the pixel types TextureStaging can convert, that is
+// 8-bit mono, mono with alpha, RGB and RGBA.
+[[nodiscard]]
+bool is_stageable(Yimage::PixelType type);
+
+// A band of rows in the upload format. Each row starts at a multiple of
+// four bytes, as required by GL_UNPACK_ALIGNMENT 4.
+struct StagedPixels
+{
+    const uint8_t* data = nullptr;
+    size_t width = 0;
+    size_t row_count = 0;
+    GLenum format = GL_RGB;
+};
+
+// Converts 8-bit images to the upload format and uploads them to the
+// texture bound to GL_TEXTURE_2D.
+//
+// Images that already are in the upload format with aligned rows are
+// uploaded directly. Other images are converted on the calling thread
+// with the SIMD pixel kernels, one band of rows at a time, into a staging
+// buffer that is kept between calls. Uploading an image in bands as it
+// is decoded therefore doesn't allocate memory for each band.
+class TextureStaging
+{
+public:
+    // Defines the bound texture's image as img.
+    void set_image(const Yimage::Image& img, UploadFormat format);
+
+    // Replaces rows [first_row, first_row + row_count) of the bound
+    // texture, which must be as large as img, with those in img.
+    void set_rows(const Yimage::Image& img, UploadFormat format,
+                  size_t first_row, size_t row_count);
+
+    // Returns rows [first_row, first_row + row_count) of img in the
+    // upload format. The result either points into img or into the
+    // staging buffer, and is valid until the next call or until img
+    // changes. Throws std::runtime_error if img isn't stageable.
+    [[nodiscard]]
+    StagedPixels stage(const Yimage::Image& img, UploadFormat format,
+                       size_t first_row, size_t row_count);
+
+    // The size of the staging buffers in bytes.
+    [[nodiscard]]
+    size_t buffer_size() const;
+private:
+    std::vector<uint8_t> buffer_;
+    // A row of RGB pixels when mono images are converted to RGBA.
+    std::vector<uint8_t> rgb_row_;
+};
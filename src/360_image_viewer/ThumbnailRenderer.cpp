@@ -0,0 +1,76 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "ThumbnailRenderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <Xyz/Xyz.hpp>
+#include "ImageResampler.hpp"
+
+namespace
+{
+    constexpr unsigned char BACKGROUND = 0x20;
+}
+
+Yimage::Image shrink_panorama(const Yimage::Image& panorama,
+                              size_t thumbnail_width,
+                              double view_angle,
+                              unsigned thread_count)
+{
+    constexpr auto PI = Xyz::Constants<double>::PI;
+    auto width = size_t(std::ceil(double(thumbnail_width) * 2 * PI / view_angle));
+    if (width >= panorama.width())
+        return {};
+    auto height = std::max<size_t>(panorama.height() * width / panorama.width(), 1);
+    return resize_image(panorama, width, height, thread_count);
+}
+
+ContactSheet::ContactSheet(size_t cell_count, size_t columns,
+                           size_t cell_width, size_t cell_height,
+                           size_t spacing)
+    : columns_(std::max<size_t>(columns, 1)),
+      cell_width_(cell_width),
+      cell_height_(cell_height),
+      spacing_(spacing)
+{
+    auto rows = (cell_count + columns_ - 1) / columns_;
+    auto cols = std::min(columns_, std::max<size_t>(cell_count, 1));
+    image_ = Yimage::Image(Yimage::PixelType::RGB_8,
+                           cols * (cell_width_ + spacing_) + spacing_,
+                           rows * (cell_height_ + spacing_) + spacing_);
+    memset(image_.data(), BACKGROUND, image_.size());
+}
+
+void ContactSheet::set_cell(size_t index, const Yimage::Image& img)
+{
+    if (img.pixel_type() != Yimage::PixelType::RGB_8
+        || img.width() != cell_width_ || img.height() != cell_height_)
+    {
+        throw std::runtime_error("Contact sheet cells must be RGB_8 images of"
+                                 " the same size.");
+    }
+
+    auto x = spacing_ + (index % columns_) * (cell_width_ + spacing_);
+    auto y = spacing_ + (index / columns_) * (cell_height_ + spacing_);
+    if (y + cell_height_ > image_.height())
+        throw std::runtime_error("Contact sheet cell index is out of range.");
+
+    for (size_t i = 0; i < cell_height_; ++i)
+    {
+        memcpy(image_.data() + (y + i) * image_.row_size() + 3 * x,
+               img.data() + i * img.row_size(),
+               3 * cell_width_);
+    }
+}
+
+const Yimage::Image& ContactSheet::image() const
+{
+    return image_;
+}
@@ -0,0 +1,40 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <vector>
+#include <Yimage/Yimage.hpp>
+
+// Returns a scaled down version of panorama that has roughly the same
+// resolution as a perspective thumbnail of the given width, or an empty
+// image if panorama doesn't need to be scaled down.
+[[nodiscard]]
+Yimage::Image shrink_panorama(const Yimage::Image& panorama,
+                              size_t thumbnail_width,
+                              double view_angle,
+                              unsigned thread_count = 0);
+
+class ContactSheet
+{
+public:
+    ContactSheet(size_t cell_count, size_t columns,
+                 size_t cell_width, size_t cell_height,
+                 size_t spacing = 4);
+
+    // Copies img into the cell with the given index. Different threads
+    // can set different cells at the same time.
+    void set_cell(size_t index, const Yimage::Image& img);
+
+    [[nodiscard]]
+    const Yimage::Image& image() const;
+private:
+    size_t columns_;
+    size_t cell_width_;
+    size_t cell_height_;
+    size_t spacing_;
+    Yimage::Image image_;
+};
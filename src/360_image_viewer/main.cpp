@@ -5,35 +5,37 @@
 // This file is distributed under the BSD License.
 // License text is included with the source distribution.
 //****************************************************************************
+#include <cstdlib>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
 #include <Argos/Argos.hpp>
 #include <Tungsten/Tungsten.hpp>
 #include <Yimage/Yimage.hpp>
+#include "AllocationTracker.hpp"
+#include "AnnotationLayer.hpp"
+#include "AsyncImageLoader.hpp"
 #include "Cross.hpp"
+#include "DecodedImageCache.hpp"
 #include "Hud.hpp"
-#include "RingBuffer.hpp"
+#include "ImageLoader.hpp"
+#include "Parallel.hpp"
+#include "QualityGovernor.hpp"
+#include "QuaternionCamera.hpp"
+#include "ScaledFramebuffer.hpp"
 #include "Sphere.hpp"
-#include "SpherePosCalculator.hpp"
+#include "SphericalCamera.hpp"
 #include "Debug.hpp"
 
-constexpr double MAX_CENTER_POINT_AGE = 0.05;
-constexpr double MAX_SPEED = 4;
 constexpr int MAX_ZOOM_LEVEL = 33;
 
-using time_point = std::chrono::high_resolution_clock::time_point;
-using PrevPositionList = Chorasmia::RingBuffer<std::pair<time_point, Xyz::SphericalPointD>, 4>;
+constexpr auto ALLOCATION_LOG_INTERVAL = std::chrono::seconds(2);
 
 void load_image(const char* file_path);
 
-struct ScreenMotion
-{
-    time_point start_time = {};
-    time_point end_time = {};
-    Xyz::SphericalPointD origin;
-    double azimuth_speed = 0;
-    double polar_speed = 0;
-};
-
 double get_view_angle(int zoom_level)
 {
     int angle;
@@ -52,41 +54,273 @@ double get_view_angle(int zoom_level)
     return Xyz::to_radians(angle);
 }
 
+// Null unless --image-cache is given. Declared before image_loader,
+// whose worker thread uses it, so that it is destroyed after it.
+std::unique_ptr<DecodedImageCache> image_cache;
+AsyncImageLoader image_loader;
+
+// Logs when each startup phase began and ended, relative to when the
+// program started, if --startup-trace is given. Phases may overlap and
+// can be logged from any thread.
+class StartupTrace
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    bool enabled = false;
+
+    void log_phase(const char* name, Clock::time_point begin) const
+    {
+        if (!enabled)
+            return;
+        using namespace std::chrono;
+        auto end = Clock::now();
+        SDL_Log("Startup: %-24s %8.1f ms - %8.1f ms (%.1f ms)", name,
+                duration<double, std::milli>(begin - start_).count(),
+                duration<double, std::milli>(end - start_).count(),
+                duration<double, std::milli>(end - begin).count());
+    }
+
+    [[nodiscard]]
+    Clock::time_point start_time() const
+    {
+        return start_;
+    }
+private:
+    Clock::time_point start_ = Clock::now();
+};
+
+StartupTrace startup_trace;
+
+struct DecodedImage
+{
+    Yimage::Image image;
+    double decode_ms = 0;
+};
+
+const char* get_tone_mapping_name(ToneMapping tone_mapping)
+{
+    switch (tone_mapping)
+    {
+    case ToneMapping::CLIP:
+        return "clip";
+    case ToneMapping::REINHARD:
+        return "reinhard";
+    case ToneMapping::ACES:
+        return "aces";
+    }
+    return "unknown";
+}
+
+// How the two eyes' views of a stereo panorama are shown.
+enum class StereoOutput
+{
+    // The left eye's view in the left half of the window and the right
+    // eye's in the right half.
+    SIDE_BY_SIDE,
+    // The left eye's view in the red channel and the right eye's in
+    // green and blue, for red-cyan glasses.
+    ANAGLYPH
+};
+
+// A loaded image whose texture is still being uploaded.
+struct PendingImage
+{
+    ImageRequest request;
+    double decode_ms = 0;
+};
+
 class ImageViewer : public Tungsten::EventLoop
 {
 public:
-    explicit ImageViewer(Yimage::Image img)
-        : img_(std::move(img))
+    // The startup image is decoded while the window and the OpenGL
+    // objects are being created, it is empty if no image was given.
+    ImageViewer(std::future<DecodedImage> startup_image,
+                std::unique_ptr<Camera> camera)
+        : startup_image_(std::move(startup_image)),
+          camera_(std::move(camera))
     {
-        pos_calculator_.set_view_angle(get_view_angle(zoom_level_));
-        pos_calculator_.set_eye_dist(0.5);
+        camera_->set_view_angle(get_view_angle(zoom_level_));
+        camera_->set_eye_dist(0.5);
     }
 
     void set_image(Yimage::Image img)
     {
-        img_ = std::move(img);
         if (sphere_)
-            sphere_->set_image(img_);
+        {
+            sphere_->set_image(std::move(img));
+            update_texture_stats();
+        }
+        else
+        {
+            img_ = std::move(img);
+        }
+    }
+
+    // Returns a request for the image loader, or nothing if the sphere
+    // hasn't been created yet.
+    [[nodiscard]]
+    std::optional<ImageRequest>
+    make_image_request(int azimuth, int polar, int zoom_level) const
+    {
+        if (!sphere_)
+            return {};
+        ImageRequest request{azimuth, polar, zoom_level,
+                             sphere_->texture_options,
+                             sphere_->texture_limits(), {}};
+        // The load order only covers mono images.
+        if (load_visible_first_ && stereo_layout_ == StereoLayout::MONO)
+        {
+            request.view_region = calc_view_region(
+                camera_->screen_res(), get_view_angle(zoom_level),
+                Xyz::to_radians(azimuth), Xyz::to_radians(polar));
+        }
+        return request;
+    }
+
+    // Prepares the viewer for an image that arrives a band of rows at a
+    // time. Returns false if the image must be set with set_image when
+    // it is complete.
+    bool begin_partial_image(size_t width, size_t height,
+                             Yimage::PixelType pixel_type)
+    {
+        img_ = {};
+        if (!sphere_ || !sphere_->begin_partial_image(width, height, pixel_type))
+            return false;
+        pending_image_.reset();
+        update_texture_stats();
+        return true;
+    }
+
+    void update_partial_image(const Yimage::Image& img,
+                              size_t first_row, size_t row_count)
+    {
+        sphere_->update_partial_image(img, first_row, row_count);
+        redraw();
+    }
+
+    // Must be called when the last rows of a partial image have been
+    // uploaded.
+    void end_partial_image()
+    {
+        sphere_->end_partial_image();
+        update_texture_stats();
+        redraw();
+    }
+
+    void set_texture_options(TextureOptions options)
+    {
+        texture_options_ = std::move(options);
+    }
+
+    // The positions are in radians.
+    void set_markers(std::vector<Xyz::SphericalPointD> markers)
+    {
+        markers_ = std::move(markers);
+    }
+
+    void set_render_mode(SphereRenderMode mode)
+    {
+        render_mode_ = mode;
+    }
+
+    // Makes the viewer treat images as stereo panoramas with the given
+    // layout.
+    void set_stereo(StereoLayout layout, StereoOutput output)
+    {
+        stereo_layout_ = layout;
+        stereo_output_ = output;
+    }
+
+    // Makes the viewer record the call stack of every interval'th
+    // allocation once the first frame has been drawn.
+    void set_allocation_sample_interval(unsigned interval)
+    {
+        allocation_sample_interval_ = interval;
+    }
+
+    // Makes the viewer load the part of new images that is visible from
+    // their initial view first, if the image format allows it.
+    void set_load_visible_first(bool enabled)
+    {
+        load_visible_first_ = enabled;
+    }
+
+    // Limits how much of a new image's texture is uploaded per frame.
+    void set_upload_budget(const UploadBudget& budget)
+    {
+        upload_budget_ = budget;
+    }
+
+    // Makes the viewer adjust its quality while running to hold the
+    // given frame rate.
+    void set_target_fps(double fps)
+    {
+        quality_governor_.emplace(fps);
+    }
+
+    void set_tone_mapping(float exposure, ToneMapping tone_mapping)
+    {
+        exposure_ = exposure;
+        tone_mapping_ = tone_mapping;
+    }
+
+    // Marks the time the application started creating the window.
+    void set_run_time(StartupTrace::Clock::time_point time)
+    {
+        run_time_ = time;
     }
 
     void set_view_direction(double azimuth, double polar)
     {
-        pos_calculator_.set_fixed_point({0, 0},
-                                        {1.0, azimuth, polar});
+        camera_->set_direction(azimuth, polar);
     }
 
     void on_startup(Tungsten::SdlApplication& app) override
     {
+        using Clock = StartupTrace::Clock;
+        startup_trace.log_phase("Create window", run_time_);
+
+        auto begin = Clock::now();
         app.throttle_events(SDL_MOUSEWHEEL, 50);
         app.throttle_events(SDL_MULTIGESTURE, 50);
         set_swap_interval(app, Tungsten::SwapInterval::ADAPTIVE_VSYNC_OR_VSYNC);
-        sphere_ = std::make_unique<Sphere>(img_, 16, 60);
+        sphere_ = std::make_unique<Sphere>(16, 60);
+        sphere_->texture_options = texture_options_;
+        sphere_->render_mode = render_mode_;
+        sphere_->stereo_layout = stereo_layout_;
+        sphere_->exposure = exposure_;
+        sphere_->tone_mapping = tone_mapping_;
         cross_ = std::make_unique<Cross>();
         hud_ = std::make_unique<Hud>();
+        scaled_framebuffer_ = std::make_unique<ScaledFramebuffer>();
+        annotations_ = std::make_unique<AnnotationLayer>();
+        annotations_->set_markers(markers_);
+        markers_ = {};
+        startup_trace.log_phase("Create scene", begin);
 
-        auto center = to_degrees(pos_calculator_.calc_center_sphere_pos());
-        hud_->set_angles(center.azimuth, center.polar);
+        if (startup_image_.valid())
+        {
+            begin = Clock::now();
+            auto [img, decode_ms] = startup_image_.get();
+            img_ = std::move(img);
+            decode_ms_ = decode_ms;
+            startup_trace.log_phase("Wait for image", begin);
+        }
+        if (img_)
+        {
+            begin = Clock::now();
+            sphere_->set_image(std::move(img_));
+            startup_trace.log_phase("Prepare texture", begin);
+        }
+        img_ = {};
+        update_texture_stats();
+        log_asset_memory();
+
+        update_hud_angles();
         hud_->set_zoom(zoom_level_);
+        if (quality_governor_)
+            apply_quality();
     }
 
     bool on_event(Tungsten::SdlApplication& app, const SDL_Event& event) override
@@ -108,41 +342,148 @@ public:
         case SDL_DROPFILE:
             return on_drop_file(app, event.drop);
         default:
+            if (auto loaded = image_loader.take_result(event))
+            {
+                on_image_loaded(std::move(*loaded));
+                return true;
+            }
+            if (auto rows = image_loader.take_rows(event))
+            {
+                on_rows_decoded(std::move(*rows));
+                return true;
+            }
             return false;
         }
     }
 
     void on_update(Tungsten::SdlApplication& app) override
     {
-        if (!motion_)
-            return;
+        if (pending_image_)
+            continue_upload();
 
-        auto position = calculate_current_position(*motion_);
-        if (!position)
-        {
-            motion_.reset();
+        if (!camera_->update_motion(Camera::Clock::now()))
             return;
-        }
 
-        pos_calculator_.set_fixed_point({0, 0}, *position);
-        auto degrees = Xyz::to_degrees(*position);
-        hud_->set_angles(degrees.azimuth, degrees.polar);
+        update_hud_angles();
         redraw();
     }
 
     void on_draw(Tungsten::SdlApplication& app) override
     {
+        auto now = Hud::Clock::now();
+        hud_->add_frame(now);
         glClearColor(0, 0, 0, 1);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        auto mv_matrix = get_mv_matrix(app);
-        auto p_matrix = get_p_matrix(app);
-        sphere_->draw(mv_matrix, p_matrix);
-        cross_->draw();
+        auto [w, h] = app.window_size();
+        camera_->set_screen_res({double(get_eye_width(w)), double(h)});
+        // The parallax of a stereo panorama is in the image, both eyes
+        // look from the sphere's center and share the matrices.
+        auto mv_matrix = make_mv_matrix(*camera_);
+        auto p_matrix = make_p_matrix(*camera_);
+        if (is_side_by_side())
+        {
+            GLint viewport[4];
+            glGetIntegerv(GL_VIEWPORT, viewport);
+            auto eye_width = viewport[2] / 2;
+            glViewport(viewport[0], viewport[1], eye_width, viewport[3]);
+            draw_scene(mv_matrix, p_matrix, StereoEye::LEFT);
+            glViewport(viewport[0] + eye_width, viewport[1], eye_width,
+                       viewport[3]);
+            draw_scene(mv_matrix, p_matrix, StereoEye::RIGHT);
+            glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        }
+        else
+        {
+            draw_scene(mv_matrix, p_matrix, StereoEye::LEFT);
+        }
         hud_->draw(Xyz::Vector2F(app.window_size()));
 
-        if (motion_)
+        if (quality_governor_)
+        {
+            // The governor needs the time the GPU spends on the frame,
+            // not the time until the buffers are swapped, which includes
+            // waiting for vsync.
+            glFinish();
+            auto draw_time = Hud::Clock::now() - now;
+            if (auto change = quality_governor_->add_frame(now, draw_time))
+                on_quality_changed(*change);
+        }
+
+        if (!has_drawn_)
+        {
+            has_drawn_ = true;
+            startup_trace.log_phase("First frame",
+                                    startup_trace.start_time());
+            set_allocation_sampling(allocation_sample_interval_);
+        }
+
+        if (camera_->is_moving())
             redraw();
+
+        frame_allocations_.end_frame();
+        if (IS_TRACKING_ALLOCATIONS)
+            log_frame_allocations();
+    }
+
+    // The memory used by the images the viewer holds, including the
+    // ones that are being decoded or uploaded.
+    [[nodiscard]]
+    std::vector<AssetMemory> asset_memory() const
+    {
+        auto result = sphere_->asset_memory();
+        if (img_)
+            result.push_back({"decoded image", img_.row_size() * img_.height(), 0});
+        if (region_image_)
+        {
+            result.push_back({"region image",
+                              region_image_->row_size() * region_image_->height(),
+                              0});
+        }
+        if (auto bytes = scaled_framebuffer_->gpu_bytes())
+            result.push_back({"scaled framebuffer", 0, bytes});
+        return result;
+    }
+
+    // Draws everything except the HUD to the current viewport.
+    void draw_scene(const Xyz::Matrix4F& mv_matrix,
+                    const Xyz::Matrix4F& p_matrix, StereoEye eye)
+    {
+        // The markers, cross and HUD are small, only the sphere is drawn
+        // at the reduced resolution.
+        auto is_scaled = scaled_framebuffer_->begin(render_scale_);
+        if (stereo_layout_ != StereoLayout::MONO
+            && stereo_output_ == StereoOutput::ANAGLYPH)
+        {
+            glColorMask(GL_TRUE, GL_FALSE, GL_FALSE, GL_TRUE);
+            sphere_->draw(mv_matrix, p_matrix, StereoEye::LEFT);
+            glColorMask(GL_FALSE, GL_TRUE, GL_TRUE, GL_TRUE);
+            sphere_->draw(mv_matrix, p_matrix, StereoEye::RIGHT);
+            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        }
+        else
+        {
+            sphere_->draw(mv_matrix, p_matrix, eye);
+        }
+        if (is_scaled)
+            scaled_framebuffer_->end();
+        annotations_->draw(*camera_, mv_matrix, p_matrix);
+        cross_->draw();
+    }
+
+    [[nodiscard]]
+    bool is_side_by_side() const
+    {
+        return stereo_layout_ != StereoLayout::MONO
+               && stereo_output_ == StereoOutput::SIDE_BY_SIDE;
+    }
+
+    // Returns the width of the part of the window that shows one eye's
+    // view. Each half shows the whole view in side-by-side output.
+    [[nodiscard]]
+    int get_eye_width(int window_width) const
+    {
+        return is_side_by_side() ? std::max(window_width / 2, 1) : window_width;
     }
 
     void set_zoom_level(int zoom_level)
@@ -151,7 +492,7 @@ public:
         if (zoom_level != zoom_level_)
         {
             zoom_level_ = zoom_level;
-            pos_calculator_.set_view_angle(get_view_angle(zoom_level_));
+            camera_->set_view_angle(get_view_angle(zoom_level_));
             hud_->set_zoom(zoom_level_);
             redraw();
         }
@@ -181,23 +522,30 @@ private:
                          const SDL_MouseMotionEvent& event)
     {
         auto [w, h] = app.window_size();
+        // A drag stays in the half of the window where it began.
+        auto eye_width = get_eye_width(w);
+        if (!is_panning_)
+            eye_offset_ = is_side_by_side() && event.x >= eye_width ? eye_width : 0;
         Xyz::Vector2D new_mouse_pos(
-            2.0 * event.x / double(w) - 1,
+            2.0 * (event.x - eye_offset_) / double(eye_width) - 1,
             2.0 * (h - event.y) / double(h) - 1);
 
         if (is_panning_)
         {
-            pos_calculator_.set_fixed_point(new_mouse_pos,
-                                            pos_calculator_.fixed_point().second);
-            auto center = Xyz::to_spherical(pos_calculator_.calc_center_pos());
-            auto degrees = Xyz::to_degrees(center);
-            hud_->set_angles(degrees.azimuth, degrees.polar);
-            prev_center_points_.push_back({
-                std::chrono::high_resolution_clock::now(),
-                center
-            });
+            camera_->drag(new_mouse_pos, Camera::Clock::now());
+            update_hud_angles();
             redraw();
         }
+        else if (annotations_->marker_count() != 0)
+        {
+            auto marker = annotations_->find_marker(*camera_,
+                                                    new_mouse_pos);
+            if (annotations_->set_highlighted_marker(marker))
+            {
+                hud_->set_marker(marker);
+                redraw();
+            }
+        }
 
         mouse_pos_ = new_mouse_pos;
         return true;
@@ -208,17 +556,8 @@ private:
     {
         if (event.button == SDL_BUTTON_LEFT)
         {
-            auto center = Xyz::to_spherical(pos_calculator_.calc_center_pos());
-            prev_center_points_.clear();
-            prev_center_points_.push_back({
-                std::chrono::high_resolution_clock::now(),
-                center
-            });
             is_panning_ = true;
-            pos_calculator_.set_fixed_point(
-                mouse_pos_,
-                pos_calculator_.calc_sphere_pos(mouse_pos_));
-            motion_ = {};
+            camera_->begin_drag(mouse_pos_, Camera::Clock::now());
         }
         return true;
     }
@@ -228,11 +567,9 @@ private:
     {
         if (event.button == SDL_BUTTON_LEFT)
         {
-            motion_ = calculate_motion(prev_center_points_);
-            if (motion_)
+            if (camera_->end_drag(Camera::Clock::now()))
                 redraw();
             is_panning_ = false;
-            pos_calculator_.clear_fixed_point();
         }
         return true;
     }
@@ -251,6 +588,31 @@ private:
             redraw();
             return true;
         }
+        else if (event.keysym.sym == SDLK_r)
+        {
+            sphere_->render_mode = sphere_->render_mode == SphereRenderMode::MESH
+                                   ? SphereRenderMode::RAY_CAST
+                                   : SphereRenderMode::MESH;
+            update_texture_stats();
+            redraw();
+            return true;
+        }
+        else if (event.keysym.sym == SDLK_LEFTBRACKET
+                 || event.keysym.sym == SDLK_RIGHTBRACKET)
+        {
+            sphere_->exposure += event.keysym.sym == SDLK_LEFTBRACKET
+                                 ? -0.5f : 0.5f;
+            SDL_Log("Exposure: %+.1f EV", sphere_->exposure);
+            redraw();
+            return true;
+        }
+        else if (event.keysym.sym == SDLK_t)
+        {
+            sphere_->tone_mapping = ToneMapping((int(sphere_->tone_mapping) + 1) % 3);
+            SDL_Log("Tone mapping: %s", get_tone_mapping_name(sphere_->tone_mapping));
+            redraw();
+            return true;
+        }
         else if (event.keysym.sym == SDLK_f)
         {
             bool is_fullscreen = SDL_GetWindowFlags(app.window()) & SDL_WINDOW_FULLSCREEN;
@@ -274,123 +636,345 @@ private:
         return true;
     }
 
-    bool on_drop_file(const Tungsten::SdlApplication& app,
-                      const SDL_DropEvent& event)
+    // The current image is shown until the new one has been uploaded.
+    void on_image_loaded(LoadedImage loaded)
     {
-        SDL_Log("Dropped file: %s", event.file);
-        load_image(event.file);
-        SDL_free(event.file);
-        return true;
+        clear_redraw();
+        region_image_.reset();
+        sphere_->start_upload(std::move(loaded.texture), upload_budget_);
+        pending_image_ = PendingImage{loaded.request, loaded.decode_ms};
+        continue_upload();
     }
 
-    [[nodiscard]]
-    Xyz::Matrix4F get_mv_matrix(const Tungsten::SdlApplication& app)
+    void continue_upload()
     {
-        auto [w, h] = app.window_size();
-        pos_calculator_.set_screen_res({double(w), double(h)});
-        auto eye_vec = Xyz::vector_cast<float>(pos_calculator_.calc_eye_pos());
-        auto center_vec = Xyz::vector_cast<float>(pos_calculator_.calc_center_pos());
-        auto up_vec = Xyz::vector_cast<float>(pos_calculator_.calc_up_vector());
-        return Xyz::make_look_at_matrix(eye_vec, center_vec, up_vec);
+        redraw();
+        if (!sphere_->continue_upload())
+            return;
+
+        auto [request, decode_ms] = *pending_image_;
+        pending_image_.reset();
+        decode_ms_ = decode_ms;
+        update_texture_stats();
+        log_asset_memory();
+        set_view_direction(Xyz::to_radians(request.azimuth),
+                           Xyz::to_radians(request.polar));
+        set_zoom_level(request.zoom_level);
     }
 
-    [[nodiscard]]
-    Xyz::Matrix4F get_p_matrix(const Tungsten::SdlApplication& app) const
+    // The visible rows of an image that is loaded a region at a time
+    // arrive first, the view is set to show them right away.
+    void on_rows_decoded(DecodedRows rows)
     {
-        auto [w, h] = app.window_size();
-        float x, y;
-        if (w < h)
+        using namespace std::chrono;
+        const auto& img = *rows.image;
+        auto is_first = rows.image != region_image_;
+        if (is_first)
         {
-            x = float(w) / float(h);
-            y = 1.0;
+            // The loader has already checked that the image can be
+            // uploaded partially.
+            clear_redraw();
+            if (!begin_partial_image(img.width(), img.height(), img.pixel_type()))
+                return;
+            region_image_ = rows.image;
+            set_view_direction(Xyz::to_radians(rows.request.azimuth),
+                               Xyz::to_radians(rows.request.polar));
+            set_zoom_level(rows.request.zoom_level);
         }
-        else
+
+        for (const auto& range: rows.rows)
+            update_partial_image(img, range.first_row, range.row_count);
+        auto msecs = duration<double, std::milli>(steady_clock::now() - rows.start_time).count();
+        if (is_first)
+            SDL_Log("Showed the visible region %.1f ms after loading began.", msecs);
+
+        if (rows.is_complete)
         {
-            x = 1.0;
-            y = float(h) / float(w);
+            SDL_Log("Showed the whole image %.1f ms after loading began.", msecs);
+            region_image_.reset();
+            decode_ms_ = rows.decode_ms;
+            end_partial_image();
+            log_asset_memory();
         }
+    }
 
-        double angle = 0.5 * get_view_angle(zoom_level_);
-        auto size = float(0.5 * sin(angle) / (cos(angle) + 0.5));
-        return Xyz::make_frustum_matrix<float>(-size * x, size * x, -size * y, size * y, 0.5f, 2.f);
+    void update_hud_angles()
+    {
+        auto center = Xyz::to_degrees(Xyz::to_spherical(camera_->calc_center_pos()));
+        hud_->set_angles(center.azimuth, center.polar);
     }
 
-    [[nodiscard]] static std::optional<ScreenMotion>
-    calculate_motion(const PrevPositionList& prev_positions)
+    void on_quality_changed(const QualityChange& change)
     {
-        using namespace std::chrono;
-        auto now = high_resolution_clock::now();
+        SDL_Log("Quality level %zu -> %zu: average draw time %.1f ms,"
+                " target %.1f ms.", change.old_level, change.new_level,
+                change.draw_ms, quality_governor_->target_ms());
+        apply_quality();
+    }
 
-        auto it = std::find_if(prev_positions.begin(),
-                               prev_positions.end(),
-                               [&](const auto& p)
-                               {
-                                   return duration_cast<duration<double>>(
-                                       now - p.first).count() < MAX_CENTER_POINT_AGE;
-                               });
+    void apply_quality()
+    {
+        const auto& quality = quality_governor_->quality();
+        sphere_->set_tessellation(quality.circles, quality.points);
+        sphere_->mip_bias = quality.mip_bias;
+        render_scale_ = quality.render_scale;
+        hud_->set_quality(quality_governor_->level(), quality);
+        hud_->set_triangle_count(sphere_->triangle_count());
+    }
 
-        if (it == prev_positions.end())
-            return {};
+    void update_texture_stats()
+    {
+        hud_->set_load_times(decode_ms_, sphere_->upload_time_ms(),
+                             sphere_->upload_frame_count());
+        hud_->set_texture_memory(sphere_->texture_memory());
+        hud_->set_triangle_count(sphere_->triangle_count());
+    }
 
-        const auto& [time0, pos0] = *it;
-        const auto& [time1, pos1] = prev_positions.back();
-        auto secs = duration_cast<duration<double>>(now - time0).count();
-        auto azimuth_speed = Xyz::clamp((pos1.azimuth - pos0.azimuth) / secs,
-                                        -MAX_SPEED, MAX_SPEED);
-        auto polar_speed = Xyz::clamp((pos1.polar - pos0.polar) / secs,
-                                      -MAX_SPEED, MAX_SPEED);
-        auto max_speed = std::max(std::abs(azimuth_speed),
-                                  std::abs(polar_speed));
+    void log_frame_allocations()
+    {
+        auto now = Hud::Clock::now();
+        if (now - allocation_log_time_ < ALLOCATION_LOG_INTERVAL)
+            return;
+        allocation_log_time_ = now;
+        if (frame_allocations_.frame_count() == 0)
+            return;
 
-        auto duration = std::chrono::duration<double>(std::sqrt(max_speed));
-        auto end_time = now + duration_cast<high_resolution_clock::duration>(duration);
-        return ScreenMotion{now, end_time, pos1, azimuth_speed, polar_speed};
+        SDL_Log("Frame allocations: %zu of %zu frames allocated memory,"
+                " %zu allocations in total, at most %zu in one frame.",
+                frame_allocations_.allocating_frame_count(),
+                frame_allocations_.frame_count(),
+                frame_allocations_.total_allocations(),
+                frame_allocations_.max_allocations());
+        write_allocation_samples();
+        frame_allocations_.reset();
     }
 
-    [[nodiscard]] static std::optional<Xyz::SphericalPointD>
-    calculate_current_position(const ScreenMotion& motion)
+    void log_asset_memory() const
     {
-        using namespace std::chrono;
-        auto now = high_resolution_clock::now();
-        if (now >= motion.end_time)
-            return {};
+        auto assets = asset_memory();
+        SDL_Log("Image memory: %.1f MB host, %.1f MB GPU.",
+                double(get_host_bytes(assets)) / (1 << 20),
+                double(get_gpu_bytes(assets)) / (1 << 20));
+    }
 
-        auto secs = duration_cast<duration<double>>(now - motion.start_time).count();
-
-        // I'm using the equation of the "top left" quarter of an ellipse
-        // to control the "deceleration" of the screen movement.
-        // The ellipses a-value is the square root of the greatest absolute
-        // value of the two speed, its b-value is one quarter of the a-value,
-        // its center lies at x, y = radius, 0.
-        constexpr auto pi = Xyz::Constants<double>::PI;
-        auto radius = std::sqrt(std::max(std::abs(motion.azimuth_speed),
-                                         std::abs(motion.polar_speed)));
-        auto factor = 0.25 * std::sqrt(secs * (2 * radius - secs));
-        auto az = motion.origin.azimuth
-                  + motion.azimuth_speed * factor;
-        if (az < -pi)
-            az += 2 * pi;
-        else if (az > pi)
-            az -= 2 * pi;
-        auto po = Xyz::clamp(motion.origin.polar + motion.polar_speed * factor,
-                             -pi / 2, pi / 2);
-
-        return Xyz::SphericalPointD(1.0, az, po);
+    bool on_drop_file(const Tungsten::SdlApplication& app,
+                      const SDL_DropEvent& event)
+    {
+        SDL_Log("Dropped file: %s", event.file);
+        load_image(event.file);
+        SDL_free(event.file);
+        return true;
     }
 
     int zoom_level_ = 20;
     Xyz::Vector2D mouse_pos_;
     Yimage::Image img_;
-    SpherePosCalculator pos_calculator_;
+    std::future<DecodedImage> startup_image_;
+    double decode_ms_ = 0;
+    StartupTrace::Clock::time_point run_time_;
+    bool has_drawn_ = false;
+    TextureOptions texture_options_;
+    SphereRenderMode render_mode_ = SphereRenderMode::MESH;
+    StereoLayout stereo_layout_ = StereoLayout::MONO;
+    StereoOutput stereo_output_ = StereoOutput::SIDE_BY_SIDE;
+    // The left edge of the half of the window the mouse is in.
+    int eye_offset_ = 0;
+    unsigned allocation_sample_interval_ = 0;
+    FrameAllocationCounter frame_allocations_;
+    Hud::Clock::time_point allocation_log_time_;
+    UploadBudget upload_budget_;
+    std::optional<PendingImage> pending_image_;
+    bool load_visible_first_ = true;
+    // The image that is being loaded a region at a time.
+    std::shared_ptr<const Yimage::Image> region_image_;
+    float exposure_ = 0;
+    ToneMapping tone_mapping_ = ToneMapping::CLIP;
+    std::unique_ptr<Camera> camera_;
     bool is_panning_ = false;
     std::unique_ptr<Cross> cross_;
     std::unique_ptr<Sphere> sphere_;
     std::unique_ptr<Hud> hud_;
-    PrevPositionList prev_center_points_;
-    std::optional<ScreenMotion> motion_;
+    std::optional<QualityGovernor> quality_governor_;
+    std::unique_ptr<ScaledFramebuffer> scaled_framebuffer_;
+    float render_scale_ = 1;
+    std::unique_ptr<AnnotationLayer> annotations_;
+    std::vector<Xyz::SphericalPointD> markers_;
 };
 
 Tungsten::SdlApplication the_app;
+unsigned decode_thread_count = 0;
+
+Yimage::Image read_panorama(const std::string& path)
+{
+    using namespace std::chrono;
+    auto start = steady_clock::now();
+    auto image = image_cache
+                 ? image_cache->read_image_file(path, decode_thread_count)
+                 : read_image_file(path, decode_thread_count);
+    auto msecs = duration<double, std::milli>(steady_clock::now() - start).count();
+    SDL_Log("Read %s (%zux%zu) in %.1f ms.", path.c_str(),
+            image.width(), image.height(), msecs);
+    if (image_cache)
+        log_cache_stats(image_cache->stats());
+    return image;
+}
+
+// Reads a text file with the azimuth and polar angle in degrees of one
+// marker per line.
+std::vector<Xyz::SphericalPointD> read_markers(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("Can not open " + path);
+
+    std::vector<Xyz::SphericalPointD> result;
+    std::string line;
+    for (size_t line_no = 1; std::getline(file, line); ++line_no)
+    {
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+        std::istringstream ss(line);
+        double azimuth, polar;
+        if (!(ss >> azimuth >> polar))
+        {
+            throw std::runtime_error(path + ":" + std::to_string(line_no)
+                                     + ": expected azimuth and polar angle.");
+        }
+        result.push_back({1.0, Xyz::to_radians(azimuth),
+                          Xyz::to_radians(polar)});
+    }
+    return result;
+}
+
+// Returns count markers evenly distributed over the sphere.
+std::vector<Xyz::SphericalPointD> make_random_markers(size_t count)
+{
+    std::mt19937 rng(count);
+    std::uniform_real_distribution<double> az_dist(-Xyz::Constants<double>::PI,
+                                                   Xyz::Constants<double>::PI);
+    std::uniform_real_distribution<double> z_dist(-1, 1);
+    std::vector<Xyz::SphericalPointD> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        result.push_back({1.0, az_dist(rng), std::asin(z_dist(rng))});
+    return result;
+}
+
+ToneMapping get_tone_mapping(const std::string& name)
+{
+    if (name == "clip")
+        return ToneMapping::CLIP;
+    if (name == "reinhard")
+        return ToneMapping::REINHARD;
+    if (name == "aces")
+        return ToneMapping::ACES;
+    throw std::runtime_error("Unknown tone mapping: " + name);
+}
+
+StereoLayout get_stereo_layout(const std::string& name)
+{
+    if (name == "mono")
+        return StereoLayout::MONO;
+    if (name == "over-under")
+        return StereoLayout::OVER_UNDER;
+    throw std::runtime_error("Unknown stereo layout: " + name);
+}
+
+StereoOutput get_stereo_output(const std::string& name)
+{
+    if (name == "side-by-side")
+        return StereoOutput::SIDE_BY_SIDE;
+    if (name == "anaglyph")
+        return StereoOutput::ANAGLYPH;
+    throw std::runtime_error("Unknown stereo output: " + name);
+}
+
+UploadFormat get_upload_format(const std::string& name)
+{
+    if (name == "rgb")
+        return UploadFormat::RGB;
+    if (name == "rgba")
+        return UploadFormat::RGBA;
+    throw std::runtime_error("Unknown upload format: " + name);
+}
+
+std::unique_ptr<Camera> make_camera(const std::string& name)
+{
+    if (name == "spherical")
+        return std::make_unique<SphericalCamera>();
+    if (name == "quaternion")
+        return std::make_unique<QuaternionCamera>();
+    throw std::runtime_error("Unknown camera: " + name);
+}
+
+ImageViewer* get_viewer()
+{
+    auto* viewer = dynamic_cast<ImageViewer*>(the_app.event_loop());
+    if (!viewer)
+        std::cerr << "The ImageViewer has not been initialized yet.\n";
+    return viewer;
+}
+
+void set_view(ImageViewer& viewer, int azimuth, int polar, int zoom_level)
+{
+    viewer.set_view_direction(Xyz::to_radians(azimuth),
+                              Xyz::to_radians(polar));
+    viewer.set_zoom_level(zoom_level);
+}
+
+void show_image(Yimage::Image image, int azimuth, int polar, int zoom_level)
+{
+    auto* viewer = get_viewer();
+    if (!viewer)
+        return;
+    viewer->clear_redraw();
+    viewer->set_image(std::move(image));
+    set_view(*viewer, azimuth, polar, zoom_level);
+    viewer->redraw();
+}
+
+struct ImageStream
+{
+    StreamingImageReader reader;
+    std::chrono::steady_clock::time_point start_time;
+    int azimuth = 0;
+    int polar = 0;
+    int zoom_level = 0;
+    bool has_begun = false;
+    bool is_partial = false;
+    size_t uploaded_rows = 0;
+};
+
+std::unique_ptr<ImageStream> image_stream;
+
+// Uploads the rows that have been decoded since the last time.
+void update_image_stream(ImageStream& stream)
+{
+    const auto& img = stream.reader.image();
+    auto row_count = stream.reader.row_count();
+    if (!img || row_count == stream.uploaded_rows)
+        return;
+
+    auto* viewer = get_viewer();
+    if (!viewer)
+        return;
+
+    if (!stream.has_begun)
+    {
+        stream.has_begun = true;
+        stream.is_partial = viewer->begin_partial_image(
+            img.width(), img.height(), img.pixel_type());
+        if (stream.is_partial)
+            set_view(*viewer, stream.azimuth, stream.polar, stream.zoom_level);
+    }
+
+    if (stream.is_partial)
+    {
+        viewer->update_partial_image(img, stream.uploaded_rows,
+                                     row_count - stream.uploaded_rows);
+        stream.uploaded_rows = row_count;
+    }
+}
 
 extern "C"
 {
@@ -400,19 +984,122 @@ extern "C"
         try
         {
             JEB_SHOW(file_path, azimuth, polar, zoom_level);
-            auto image = Yimage::read_image(file_path);
-            auto* viewer = dynamic_cast<ImageViewer*>(the_app.event_loop());
+            auto* viewer = get_viewer();
             if (!viewer)
+                return;
+            if (auto request = viewer->make_image_request(azimuth, polar, zoom_level))
+                image_loader.load_file(file_path, *request, decode_thread_count,
+                                       image_cache.get());
+            else
+                show_image(read_panorama(file_path), azimuth, polar, zoom_level);
+        }
+        catch (std::exception& ex)
+        {
+            std::cerr << ex.what() << "\n";
+        }
+    }
+
+    // Takes ownership of data, which must have been allocated with
+    // malloc. It is freed as soon as the image has been decoded, also
+    // if decoding fails, and must not be used by the caller afterwards.
+    void load_image_from_memory(void* data, size_t size,
+                                int azimuth, int polar, int zoom_level)
+    {
+        try
+        {
+            auto* viewer = get_viewer();
+            auto request = viewer
+                           ? viewer->make_image_request(azimuth, polar, zoom_level)
+                           : std::nullopt;
+            if (request)
             {
-                std::cerr << "The ImageViewer has not been initialized yet.\n";
+                image_loader.load_data(data, size, *request, decode_thread_count);
                 return;
             }
-            viewer->clear_redraw();
-            viewer->set_image(std::move(image));
-            viewer->set_view_direction(Xyz::to_radians(azimuth),
-                                       Xyz::to_radians(polar));
-            viewer->set_zoom_level(zoom_level);
-            viewer->redraw();
+
+            using namespace std::chrono;
+            auto start = steady_clock::now();
+            Yimage::Image image;
+            try
+            {
+                image = read_image_data(data, size, decode_thread_count);
+            }
+            catch (...)
+            {
+                free(data);
+                throw;
+            }
+            free(data);
+            auto msecs = duration<double, std::milli>(steady_clock::now() - start).count();
+            SDL_Log("Read %zu bytes (%zux%zu) in %.1f ms.", size,
+                    image.width(), image.height(), msecs);
+            show_image(std::move(image), azimuth, polar, zoom_level);
+        }
+        catch (std::exception& ex)
+        {
+            std::cerr << ex.what() << "\n";
+        }
+    }
+
+    // Starts loading an image whose data will be passed to
+    // add_image_stream_data as it arrives. The part of the image that
+    // has been decoded is shown while the rest is loading.
+    void begin_image_stream(int azimuth, int polar, int zoom_level)
+    {
+        image_stream = std::make_unique<ImageStream>();
+        image_stream->start_time = std::chrono::steady_clock::now();
+        image_stream->azimuth = azimuth;
+        image_stream->polar = polar;
+        image_stream->zoom_level = zoom_level;
+    }
+
+    // Takes ownership of data, in the same way as load_image_from_memory.
+    void add_image_stream_data(void* data, size_t size)
+    {
+        std::unique_ptr<void, decltype(&free)> owner(data, free);
+        try
+        {
+            if (!image_stream)
+                throw std::runtime_error("No image stream has been started.");
+            image_stream->reader.add_data(data, size);
+            // The reader keeps its own copy of the data.
+            owner.reset();
+            update_image_stream(*image_stream);
+        }
+        catch (std::exception& ex)
+        {
+            image_stream.reset();
+            std::cerr << ex.what() << "\n";
+        }
+    }
+
+    void end_image_stream()
+    {
+        try
+        {
+            if (!image_stream)
+                return;
+
+            auto stream = std::move(image_stream);
+            stream->reader.finish();
+            update_image_stream(*stream);
+            auto image = stream->reader.release_image();
+
+            using namespace std::chrono;
+            auto msecs = duration<double, std::milli>(steady_clock::now() - stream->start_time).count();
+            SDL_Log("Streamed image (%zux%zu) in %.1f ms.",
+                    image.width(), image.height(), msecs);
+
+            auto* viewer = get_viewer();
+            if (viewer && stream->is_partial)
+            {
+                viewer->end_partial_image();
+            }
+            else
+            {
+                show_image(std::move(image), stream->azimuth, stream->polar,
+                           stream->zoom_level);
+            }
         }
         catch (std::exception& ex)
         {
@@ -434,12 +1121,194 @@ int main(int argc, char* argv[])
         parser.add(argos::Arg("IMAGE")
                        .optional(true)
                        .help("An image file (PNG or JPEG)."));
+        parser.add(argos::Opt("--decode-threads")
+                       .argument("N")
+                       .help("Set the number of threads used when decoding"
+                             " JPEG images with restart markers. The default"
+                             " is the number of CPU cores."));
+        parser.add(argos::Opt("--max-texture-size")
+                       .argument("N")
+                       .help("Scale down images wider or taller than N pixels"
+                             " when they are loaded. Images are always scaled"
+                             " down to the graphics driver's limit."));
+        parser.add(argos::Opt("--etc2")
+                       .help("Compress textures as ETC2 before uploading them,"
+                             " if the graphics driver supports it."));
+        parser.add(argos::Opt("--texture-cache")
+                       .argument("DIR")
+                       .help("Store compressed textures in DIR so that images"
+                             " only have to be compressed once."));
+        parser.add(argos::Opt("--image-cache")
+                       .argument("DIR")
+                       .help("Store decoded images in DIR, identified by the"
+                             " contents of their files, so that an image is"
+                             " only decoded once even if it is read from"
+                             " different paths."));
+        parser.add(argos::Opt("--latitude-atlas")
+                       .help("Store the image in a texture atlas where regions"
+                             " close to the poles have lower horizontal"
+                             " resolution. Uses about 30% less memory."));
+        parser.add(argos::Opt("--upload-format")
+                       .argument("NAME")
+                       .help("Set the pixel format of 8-bit textures: \"rgb\""
+                             " (the default) or \"rgba\", which uses a third"
+                             " more memory, but is faster to upload with some"
+                             " graphics drivers."));
+        parser.add(argos::Opt("--upload-budget")
+                       .argument("MS")
+                       .help("Spread the upload of new images over several"
+                             " frames, using at most MS milliseconds per"
+                             " frame. The previous image is shown until the"
+                             " upload is complete. The default is 4, 0"
+                             " uploads images in a single frame."));
+        parser.add(argos::Opt("--upload-budget-mb")
+                       .argument("MB")
+                       .help("Upload at most MB megabytes of a new image per"
+                             " frame. Can be combined with --upload-budget."));
+        parser.add(argos::Opt("--load-whole-image")
+                       .help("Decode and upload new images completely before"
+                             " showing them. By default, JPEGs with restart"
+                             " markers are loaded a band of rows at a time,"
+                             " starting with the part that is visible from"
+                             " the initial view."));
+        parser.add(argos::Opt("--exposure")
+                       .argument("EV")
+                       .help("Brighten (positive) or darken (negative) 16-bit"
+                             " images by EV stops. Press [ and ] to adjust it"
+                             " while running."));
+        parser.add(argos::Opt("--tone-map")
+                       .argument("NAME")
+                       .help("Set how bright parts of 16-bit images are mapped"
+                             " to the screen: \"clip\" (the default),"
+                             " \"reinhard\" or \"aces\". Press T to switch"
+                             " while running."));
+        parser.add(argos::Opt("--target-fps")
+                       .argument("FPS")
+                       .help("Lower or raise the tessellation of the sphere,"
+                             " the sharpness of the texture and the"
+                             " resolution the image is drawn at while"
+                             " running to hold FPS frames per second. Also"
+                             " generates mipmaps for 8-bit textures. The"
+                             " changes are shown in the HUD and logged."));
+        parser.add(argos::Opt("--stereo")
+                       .argument("LAYOUT")
+                       .help("Set the layout of the images: \"mono\" (the"
+                             " default) or \"over-under\", where the left"
+                             " eye's view is in the upper half of the image"
+                             " and the right eye's in the lower half. Stereo"
+                             " images are uploaded as a single texture and"
+                             " can't be latitude atlases."));
+        parser.add(argos::Opt("--stereo-output")
+                       .argument("MODE")
+                       .help("Set how stereo images are shown:"
+                             " \"side-by-side\" (the default) or"
+                             " \"anaglyph\" for red-cyan glasses."));
+        parser.add(argos::Opt("--markers")
+                       .argument("FILE")
+                       .help("Show markers at the positions in FILE. Each"
+                             " line has the azimuth and polar angle of one"
+                             " marker in degrees."));
+        parser.add(argos::Opt("--random-markers")
+                       .argument("N")
+                       .help("Show N markers at random positions."));
+        parser.add(argos::Opt("--ray-cast")
+                       .help("Draw the image with a single triangle that"
+                             " covers the screen and compute the texture"
+                             " coordinates per pixel instead of drawing a"
+                             " sphere mesh. Press R to switch while"
+                             " running."));
+        parser.add(argos::Opt("--camera")
+                       .argument("NAME")
+                       .help("Set how the view is rotated: \"spherical\""
+                             " (the default) keeps the horizon level,"
+                             " \"quaternion\" rotates freely like a"
+                             " trackball and can pass over the poles."));
+        parser.add(argos::Opt("--startup-trace")
+                       .help("Log when each startup phase begins and ends,"
+                             " up to when the first frame has been drawn."));
+        parser.add(argos::Opt("--sample-allocations")
+                       .argument("N")
+                       .help("Record the call stack of every Nth memory"
+                             " allocation after the first frame, and log"
+                             " them with the allocation counts of the"
+                             " frames. Requires a build with"
+                             " VIEWER_TRACK_ALLOCATIONS on a platform with"
+                             " execinfo.h."));
         Tungsten::SdlApplication::add_command_line_options(parser);
         auto args = parser.parse(argc, argv);
-        Yimage::Image img;
+        decode_thread_count = args.value("--decode-threads").as_uint(0);
+        if (auto cache_arg = args.value("--image-cache"))
+            image_cache = std::make_unique<DecodedImageCache>(cache_arg.as_string());
+        startup_trace.enabled = args.value("--startup-trace").as_bool();
+        startup_trace.log_phase("Parse arguments", startup_trace.start_time());
+
+        auto camera = make_camera(args.value("--camera").as_string("spherical"));
+
+        // Decode the image while the window is being created.
+        std::future<DecodedImage> image;
         if (auto img_arg = args.value("IMAGE"))
-            img = Yimage::read_image(img_arg.as_string());
-        auto event_loop = std::make_unique<ImageViewer>(img);
+        {
+            auto policy = HAS_THREADS ? std::launch::async
+                                      : std::launch::deferred;
+            image = std::async(policy, [path = img_arg.as_string()]
+            {
+                using namespace std::chrono;
+                auto begin = StartupTrace::Clock::now();
+                auto img = read_panorama(path);
+                startup_trace.log_phase("Decode image", begin);
+                auto ms = duration<double, std::milli>(StartupTrace::Clock::now() - begin).count();
+                return DecodedImage{std::move(img), ms};
+            });
+        }
+        auto event_loop = std::make_unique<ImageViewer>(std::move(image),
+                                                        std::move(camera));
+        auto target_fps = args.value("--target-fps").as_double(0);
+        auto stereo_layout = get_stereo_layout(
+            args.value("--stereo").as_string("mono"));
+        if (stereo_layout != StereoLayout::MONO
+            && args.value("--latitude-atlas").as_bool())
+        {
+            throw std::runtime_error("Stereo images can't be stored as"
+                                     " latitude atlases.");
+        }
+        event_loop->set_stereo(stereo_layout, get_stereo_output(
+            args.value("--stereo-output").as_string("side-by-side")));
+        event_loop->set_texture_options({
+            .max_size = args.value("--max-texture-size").as_int(0),
+            .use_etc2 = args.value("--etc2").as_bool(),
+            .cache_dir = args.value("--texture-cache").as_string(),
+            .latitude_atlas = args.value("--latitude-atlas").as_bool(),
+            .upload_format = get_upload_format(
+                args.value("--upload-format").as_string("rgb")),
+            .mipmaps = target_fps > 0
+        });
+        if (target_fps > 0)
+            event_loop->set_target_fps(target_fps);
+        std::vector<Xyz::SphericalPointD> markers;
+        if (auto markers_arg = args.value("--markers"))
+            markers = read_markers(markers_arg.as_string());
+        if (auto count = args.value("--random-markers").as_uint(0))
+        {
+            auto random_markers = make_random_markers(count);
+            markers.insert(markers.end(), random_markers.begin(),
+                           random_markers.end());
+        }
+        event_loop->set_markers(std::move(markers));
+        if (args.value("--ray-cast").as_bool())
+            event_loop->set_render_mode(SphereRenderMode::RAY_CAST);
+        event_loop->set_allocation_sample_interval(
+            args.value("--sample-allocations").as_uint(0));
+        event_loop->set_upload_budget({
+            .max_ms_per_frame = args.value("--upload-budget").as_double(4),
+            .max_bytes_per_frame = size_t(args.value("--upload-budget-mb").as_double(0)
+                                          * 1024 * 1024)
+        });
+        event_loop->set_load_visible_first(
+            !args.value("--load-whole-image").as_bool());
+        event_loop->set_tone_mapping(
+            float(args.value("--exposure").as_double(0)),
+            get_tone_mapping(args.value("--tone-map").as_string("clip")));
+        event_loop->set_run_time(StartupTrace::Clock::now());
         the_app = Tungsten::SdlApplication("360_viewer", std::move(event_loop));
         the_app.set_event_loop_mode(Tungsten::EventLoopMode::WAIT_FOR_EVENTS);
         the_app.read_command_line_options(args);
@@ -0,0 +1,19 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#version 100
+
+uniform highp vec4 u_color;
+
+void main()
+{
+    // Draw the points as circles with a dark outline.
+    mediump float r = length(gl_PointCoord - vec2(0.5));
+    if (r > 0.5)
+        discard;
+    gl_FragColor = r > 0.35 ? vec4(0.0, 0.0, 0.0, 1.0) : u_color;
+}
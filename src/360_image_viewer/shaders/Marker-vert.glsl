@@ -0,0 +1,21 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#version 100
+
+attribute vec3 a_position;
+
+uniform mat4 u_mv_matrix;
+uniform mat4 u_p_matrix;
+uniform float u_point_size;
+
+void main()
+{
+    vec4 p = u_mv_matrix * vec4(a_position, 1.0);
+    gl_Position = u_p_matrix * p;
+    gl_PointSize = u_point_size;
+}
@@ -0,0 +1,94 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#version 100
+
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+precision highp float;
+#else
+precision mediump float;
+#endif
+
+varying highp vec3 v_origin;
+varying highp vec3 v_direction;
+
+uniform sampler2D u_texture;
+// The number of meridians and parallels in the grid, 0 hides the grid.
+uniform vec2 u_grid_size;
+// The angle between the rays through neighboring pixels.
+uniform float u_pixel_angle;
+// The exposure as a factor rather than in stops.
+uniform float u_exposure;
+// 0 shows the texture as it is. The other values are for half-float
+// textures in linear light: 1 clips, 2 is Reinhard, 3 is ACES.
+uniform int u_tone_map;
+// Same as in Render3D-vert.glsl.
+uniform vec2 u_texture_transform;
+// Same as in Render3D-frag.glsl.
+uniform vec2 u_texture_v_range;
+
+// Same as in Render3D-frag.glsl.
+vec3 tone_map(vec3 color)
+{
+    vec3 c = color * u_exposure;
+    if (u_tone_map == 2)
+        c = c / (1.0 + c);
+    else if (u_tone_map == 3)
+        c = (c * (2.51 * c + 0.03)) / (c * (2.43 * c + 0.59) + 0.14);
+    c = clamp(c, 0.0, 1.0);
+    return mix(12.92 * c, 1.055 * pow(c, vec3(1.0 / 2.4)) - 0.055,
+               step(0.0031308, c));
+}
+
+const float PI = 3.14159265358979;
+
+// Returns the distance in radians to the nearest line in a grid with
+// the given spacing, where the first line is at offset.
+float get_line_distance(float angle, float offset, float spacing)
+{
+    float d = mod(angle - offset, spacing);
+    return min(d, spacing - d);
+}
+
+void main()
+{
+    // The eye is inside the sphere, the ray hits it where t is positive.
+    vec3 d = normalize(v_direction);
+    float b = dot(v_origin, d);
+    float c = dot(v_origin, v_origin) - 1.0;
+    float t = -b + sqrt(max(b * b - c, 0.0));
+    vec3 p = v_origin + t * d;
+
+    // Same mapping as get_texture_pos in EquirectangularMapping.hpp.
+    float azimuth = atan(p.y, p.x);
+    float polar = asin(clamp(p.z, -1.0, 1.0));
+    vec2 tex = vec2(fract(0.75 - azimuth / (2.0 * PI)),
+                    clamp((0.5 - polar / PI) * u_texture_transform.x
+                          + u_texture_transform.y,
+                          u_texture_v_range.x, u_texture_v_range.y));
+    gl_FragColor = vec4(texture2D(u_texture, tex).rgb, 1.0);
+    if (u_tone_map != 0)
+        gl_FragColor.rgb = tone_map(gl_FragColor.rgb);
+
+    if (u_grid_size.x > 0.0)
+    {
+        // The grid has the same lines as the sphere mesh: meridians
+        // starting at azimuth -90 degrees and parallels at the middle of
+        // the image's bands.
+        float meridian_spacing = 2.0 * PI / u_grid_size.x;
+        float parallel_spacing = PI / u_grid_size.y;
+        float dist = min(
+            get_line_distance(azimuth, -0.5 * PI, meridian_spacing) * cos(polar),
+            get_line_distance(polar, 0.5 * (parallel_spacing - PI),
+                              parallel_spacing));
+        // One pixel on the sphere, which is larger where the ray hits it
+        // at a shallow angle.
+        float width = u_pixel_angle * t / max(dot(p, d), 0.1);
+        if (dist < width)
+            gl_FragColor = vec4(1.0, 0.0, 0.0, 1.0);
+    }
+}
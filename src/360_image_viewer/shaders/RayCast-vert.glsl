@@ -0,0 +1,26 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#version 100
+
+attribute vec2 a_position;
+
+uniform mat4 u_inv_mv_matrix;
+uniform mat4 u_inv_p_matrix;
+
+varying highp vec3 v_origin;
+varying highp vec3 v_direction;
+
+void main()
+{
+    gl_Position = vec4(a_position, 0.0, 1.0);
+    // The point on the far plane is an affine function of the screen
+    // position, which makes the interpolated direction exact.
+    vec4 p = u_inv_p_matrix * vec4(a_position, 1.0, 1.0);
+    v_direction = (u_inv_mv_matrix * vec4(p.xyz / p.w, 0.0)).xyz;
+    v_origin = (u_inv_mv_matrix * vec4(0.0, 0.0, 0.0, 1.0)).xyz;
+}
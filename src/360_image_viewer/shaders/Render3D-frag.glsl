@@ -7,11 +7,48 @@
 //****************************************************************************
 #version 100
 
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+precision highp float;
+#else
+precision mediump float;
+#endif
+
 varying highp vec2 v_texture_coord;
 
 uniform sampler2D u_texture;
+// The exposure as a factor rather than in stops.
+uniform float u_exposure;
+// 0 shows the texture as it is. The other values are for half-float
+// textures in linear light: 1 clips, 2 is Reinhard, 3 is ACES.
+uniform int u_tone_map;
+// Added to the level of detail when the texture has mipmaps.
+uniform float u_mip_bias;
+// The range of vertical texture coordinates that is sampled. It keeps
+// the linear filter from blending the two eyes of a stereo image.
+uniform vec2 u_texture_v_range;
+
+// Applies the exposure and the tone mapping operator, and converts the
+// result from linear light to sRGB.
+vec3 tone_map(vec3 color)
+{
+    vec3 c = color * u_exposure;
+    if (u_tone_map == 2)
+        c = c / (1.0 + c);
+    else if (u_tone_map == 3)
+        c = (c * (2.51 * c + 0.03)) / (c * (2.43 * c + 0.59) + 0.14);
+    c = clamp(c, 0.0, 1.0);
+    return mix(12.92 * c, 1.055 * pow(c, vec3(1.0 / 2.4)) - 0.055,
+               step(0.0031308, c));
+}
 
 void main()
 {
-    gl_FragColor = texture2D(u_texture, v_texture_coord);
+    // The alpha channel of RGBA textures is ignored, as the canvas would
+    // otherwise become transparent in browsers.
+    vec2 tex = vec2(v_texture_coord.x,
+                    clamp(v_texture_coord.y, u_texture_v_range.x,
+                          u_texture_v_range.y));
+    gl_FragColor = vec4(texture2D(u_texture, tex, u_mip_bias).rgb, 1.0);
+    if (u_tone_map != 0)
+        gl_FragColor.rgb = tone_map(gl_FragColor.rgb);
 }
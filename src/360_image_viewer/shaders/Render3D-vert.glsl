@@ -12,6 +12,9 @@ attribute vec2 a_texture_coord;
 
 uniform mat4 u_mv_matrix;
 uniform mat4 u_p_matrix;
+// The scale and offset of the vertical texture coordinate. Stereo
+// images use them to select one eye's half of the texture.
+uniform vec2 u_texture_transform;
 
 varying highp vec2 v_texture_coord;
 
@@ -19,5 +22,7 @@ void main()
 {
     vec4 p = u_mv_matrix * vec4(a_position, 1.0);
     gl_Position = u_p_matrix * p;
-    v_texture_coord = a_texture_coord;
+    v_texture_coord = vec2(a_texture_coord.x,
+                           a_texture_coord.y * u_texture_transform.x
+                           + u_texture_transform.y);
 }
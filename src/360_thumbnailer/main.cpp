@@ -0,0 +1,230 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <Argos/Argos.hpp>
+#include <Xyz/Xyz.hpp>
+#include "ImageLoader.hpp"
+#include "Parallel.hpp"
+#include "Reprojection.hpp"
+#include "ThumbnailRenderer.hpp"
+
+struct ThumbnailSettings
+{
+    size_t width = 320;
+    size_t height = 180;
+    ProjectionType projection = ProjectionType::PERSPECTIVE;
+    std::vector<ProjectionView> views;
+    // The number of threads that render each image.
+    unsigned render_threads = 1;
+    std::filesystem::path output_dir;
+};
+
+ProjectionView parse_view(const std::string& text, double view_angle)
+{
+    auto comma = text.find(',');
+    if (comma == std::string::npos)
+        throw std::runtime_error("Invalid view: " + text);
+
+    ProjectionView view;
+    view.azimuth = Xyz::to_radians(std::stod(text.substr(0, comma)));
+    view.polar = Xyz::to_radians(std::stod(text.substr(comma + 1)));
+    view.view_angle = view_angle;
+    return view;
+}
+
+std::pair<size_t, size_t> parse_size(const std::string& text)
+{
+    auto x = text.find('x');
+    if (x == std::string::npos)
+        throw std::runtime_error("Invalid size: " + text);
+
+    auto width = std::stoul(text.substr(0, x));
+    auto height = std::stoul(text.substr(x + 1));
+    if (width == 0 || height == 0)
+        throw std::runtime_error("Invalid size: " + text);
+    return {width, height};
+}
+
+std::filesystem::path get_thumbnail_path(const ThumbnailSettings& settings,
+                                         const std::string& file_path,
+                                         size_t view_index)
+{
+    auto name = std::filesystem::path(file_path).stem().string();
+    if (settings.views.size() > 1)
+        name += "-" + std::to_string(view_index + 1);
+    return settings.output_dir / (name + ".png");
+}
+
+// Returns the thumbnails of the given file, one per view.
+std::vector<Yimage::Image> make_thumbnails(const ThumbnailSettings& settings,
+                                           const std::string& file_path)
+{
+    auto panorama = read_image_file(file_path, 1);
+    // The other projections magnify parts of the panorama far more than
+    // a perspective view with the same view angle, shrinking it would
+    // make them blurry.
+    if (settings.projection == ProjectionType::PERSPECTIVE)
+    {
+        // All views have the same view angle.
+        auto small_panorama = shrink_panorama(panorama, settings.width,
+                                              settings.views.front().view_angle, 1);
+        if (small_panorama)
+            panorama = std::move(small_panorama);
+    }
+
+    std::vector<Yimage::Image> result;
+    for (const auto& view: settings.views)
+    {
+        result.push_back(reproject(panorama, settings.projection, view,
+                                   settings.width, settings.height,
+                                   settings.render_threads));
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        argos::ArgumentParser parser(argv[0]);
+        parser.about("Makes perspective thumbnails of 360 degree panoramas,"
+                     " or renders them with other projections.");
+        parser.add(argos::Arg("IMAGE")
+                       .count(1, UINT_MAX)
+                       .help("An equirectangular image file (PNG or JPEG)."));
+        parser.add(argos::Opt("-o", "--output")
+                       .argument("DIR")
+                       .help("Write a PNG thumbnail of each image to DIR."));
+        parser.add(argos::Opt("-s", "--size")
+                       .argument("WIDTHxHEIGHT")
+                       .help("The size of each thumbnail. Default: 320x180."));
+        parser.add(argos::Opt("--view")
+                       .argument("AZIMUTH,POLAR")
+                       .operation(argos::OptionOperation::APPEND)
+                       .help("Make a thumbnail looking in this direction"
+                             " (in degrees). Can be given several times."
+                             " Default: 0,0."));
+        parser.add(argos::Opt("--view-angle")
+                       .argument("DEGREES")
+                       .help("The view angle along the longer side of the"
+                             " image, or the horizontal one for mercator"
+                             " and cylindrical."
+                             " Default: 90."));
+        parser.add(argos::Opt("--projection")
+                       .argument("NAME")
+                       .help("The projection of the output images: perspective,"
+                             " fisheye, stereographic, mercator or cylindrical."
+                             " Use stereographic with --view 0,-90 and"
+                             " --view-angle 300 for a \"little planet\"."
+                             " Default: perspective."));
+        parser.add(argos::Opt("--contact-sheet")
+                       .argument("FILE")
+                       .help("Write all thumbnails to a single PNG image."));
+        parser.add(argos::Opt("--columns")
+                       .argument("N")
+                       .help("The number of columns in the contact sheet."
+                             " Default: the number of views, or 8 if there"
+                             " is only one."));
+        parser.add(argos::Opt("-j", "--jobs")
+                       .argument("N")
+                       .help("Process up to N images at the same time."
+                             " Memory use is proportional to N. The default"
+                             " is the number of CPU cores."));
+        auto args = parser.parse(argc, argv);
+
+        ThumbnailSettings settings;
+        if (auto size = args.value("--size"))
+            std::tie(settings.width, settings.height) = parse_size(size.as_string());
+        auto view_angle = Xyz::to_radians(args.value("--view-angle").as_double(90));
+        if (auto projection = args.value("--projection"))
+            settings.projection = get_projection_type(projection.as_string());
+        for (const auto& view: args.values("--view").as_strings())
+            settings.views.push_back(parse_view(view, view_angle));
+        if (settings.views.empty())
+            settings.views.push_back(parse_view("0,0", view_angle));
+
+        auto output_dir = args.value("--output").as_string();
+        auto sheet_path = args.value("--contact-sheet").as_string();
+        if (output_dir.empty() && sheet_path.empty())
+            throw std::runtime_error("Either --output or --contact-sheet is required.");
+        if (!output_dir.empty())
+        {
+            settings.output_dir = output_dir;
+            std::filesystem::create_directories(settings.output_dir);
+        }
+
+        auto files = args.values("IMAGE").as_strings();
+        auto view_count = settings.views.size();
+        std::optional<ContactSheet> sheet;
+        if (!sheet_path.empty())
+        {
+            auto columns = args.value("--columns").as_uint(
+                view_count > 1 ? unsigned(view_count) : 8u);
+            sheet.emplace(files.size() * view_count, columns,
+                          settings.width, settings.height);
+        }
+
+        auto jobs = args.value("--jobs").as_uint(0);
+        if (jobs == 0)
+            jobs = get_default_thread_count();
+        // A single image is rendered on all the threads instead.
+        if (files.size() == 1)
+            settings.render_threads = jobs;
+
+        std::atomic<size_t> failures = 0;
+        std::mutex log_mutex;
+        auto start = std::chrono::steady_clock::now();
+
+        // Each job decodes a whole image, and only the job count limits
+        // how many images are in memory at the same time.
+        parallel_for(files.size(), [&](size_t i)
+        {
+            try
+            {
+                auto thumbnails = make_thumbnails(settings, files[i]);
+                for (size_t j = 0; j < thumbnails.size(); ++j)
+                {
+                    if (!output_dir.empty())
+                    {
+                        Yimage::write_png(get_thumbnail_path(settings, files[i], j).string(),
+                                          thumbnails[j]);
+                    }
+                    if (sheet)
+                        sheet->set_cell(i * view_count + j, thumbnails[j]);
+                }
+            }
+            catch (std::exception& ex)
+            {
+                ++failures;
+                std::lock_guard lock(log_mutex);
+                std::cerr << files[i] << ": " << ex.what() << "\n";
+            }
+        }, jobs);
+
+        if (sheet)
+            Yimage::write_png(sheet_path, sheet->image());
+
+        using namespace std::chrono;
+        auto secs = duration<double>(steady_clock::now() - start).count();
+        std::cout << "Processed " << files.size() << " files ("
+                  << failures << " failed) in " << secs << " s, "
+                  << double(files.size()) / secs << " files/s.\n";
+        return failures == 0 ? 0 : 1;
+    }
+    catch (std::exception& ex)
+    {
+        std::cerr << ex.what() << "\n";
+        return 1;
+    }
+}
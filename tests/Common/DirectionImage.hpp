@@ -0,0 +1,41 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cmath>
+#include <Xyz/Xyz.hpp>
+#include <Yimage/Yimage.hpp>
+
+// The color value of a direction coordinate in [-1, 1].
+[[nodiscard]]
+inline unsigned char get_direction_color(double coordinate)
+{
+    return static_cast<unsigned char>(std::lround(128 + 100 * coordinate));
+}
+
+// An equirectangular image where the red, green and blue values are
+// linear functions of the x, y and z coordinates of the direction.
+inline Yimage::Image make_direction_image(size_t width)
+{
+    constexpr auto PI = Xyz::Constants<double>::PI;
+    auto height = width / 2;
+    Yimage::Image img(Yimage::PixelType::RGB_8, width, height);
+    for (size_t y = 0; y < height; ++y)
+    {
+        auto row = img.data() + y * img.row_size();
+        auto polar = (0.5 - (double(y) + 0.5) / double(height)) * PI;
+        for (size_t x = 0; x < width; ++x)
+        {
+            // The inverse of get_texture_pos.
+            auto azimuth = (0.75 - (double(x) + 0.5) / double(width)) * 2 * PI;
+            auto dir = to_cartesian(Xyz::SphericalPoint(1.0, azimuth, polar));
+            for (size_t c = 0; c < 3; ++c)
+                row[3 * x + c] = get_direction_color(dir[c]);
+        }
+    }
+    return img;
+}
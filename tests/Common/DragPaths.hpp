@@ -0,0 +1,68 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cmath>
+#include <random>
+#include <vector>
+#include "Camera.hpp"
+
+constexpr size_t EVENTS_PER_DRAG = 50;
+// The time between mouse motion events.
+constexpr auto EVENT_INTERVAL = std::chrono::milliseconds(8);
+
+struct DragPath
+{
+    double azimuth = 0;
+    double polar = 0;
+    Xyz::Vector2D from;
+    Xyz::Vector2D to;
+};
+
+// Makes drags across the screen that start with the camera looking
+// in a random direction with a polar angle in [min_polar, max_polar]
+// or [-max_polar, -min_polar].
+inline std::vector<DragPath> make_drag_paths(size_t count,
+                                             double min_polar,
+                                             double max_polar,
+                                             std::mt19937& rng)
+{
+    constexpr auto PI = Xyz::Constants<double>::PI;
+    std::uniform_real_distribution<double> az_dist(-PI, PI);
+    std::uniform_real_distribution<double> polar_dist(min_polar, max_polar);
+    std::uniform_real_distribution<double> screen_dist(-0.9, 0.9);
+    std::bernoulli_distribution sign_dist;
+    std::vector<DragPath> result;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto polar = polar_dist(rng);
+        result.push_back({az_dist(rng),
+                          sign_dist(rng) ? polar : -polar,
+                          {screen_dist(rng), screen_dist(rng)},
+                          {screen_dist(rng), screen_dist(rng)}});
+    }
+    return result;
+}
+
+inline Xyz::Vector2D get_cursor_pos(const DragPath& path, size_t event)
+{
+    auto t = double(event) / EVENTS_PER_DRAG;
+    return path.from + t * (path.to - path.from);
+}
+
+// Gives camera the viewer's default settings in a 1280x720 window.
+inline void setup_camera(Camera& camera)
+{
+    camera.set_screen_res({1280, 720});
+    camera.set_view_angle(Xyz::to_radians(90.0));
+    camera.set_eye_dist(0.5);
+}
+
+inline double get_vector_angle(const Xyz::Vector3D& a, const Xyz::Vector3D& b)
+{
+    return std::atan2(get_length(cross(a, b)), dot(a, b));
+}
@@ -0,0 +1,90 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <jpeglib.h>
+#include <Yimage/Yimage.hpp>
+
+// An RGB image with colors that change in every direction, so that
+// chroma subsampling and upsampling show up in every row.
+inline Yimage::Image make_colorful_image(size_t width, size_t height)
+{
+    Yimage::Image img(Yimage::PixelType::RGB_8, width, height);
+    for (size_t y = 0; y < height; ++y)
+    {
+        auto row = img.data() + y * img.row_size();
+        for (size_t x = 0; x < width; ++x)
+        {
+            for (size_t c = 0; c < 3; ++c)
+            {
+                auto value = 128 + 100 * std::sin(double(x) * 0.05 * double(c + 1)
+                                                  + double(y) * 0.07 * double(3 - c));
+                row[3 * x + c] = static_cast<unsigned char>(std::lround(value));
+            }
+        }
+    }
+    return img;
+}
+
+struct JpegOptions
+{
+    // Restart markers are inserted every restart_rows MCU rows, or
+    // every restart_mcus MCUs if restart_rows is 0.
+    int restart_rows = 1;
+    unsigned restart_mcus = 0;
+    // The horizontal and vertical sampling factors of the luma
+    // component, 2 and 2 give 4:2:0.
+    int h_sampling = 2;
+    int v_sampling = 2;
+    int quality = 90;
+};
+
+// Encodes img, which must be RGB_8 or MONO_8, as a baseline JPEG.
+inline std::vector<uint8_t> encode_jpeg(const Yimage::Image& img,
+                                        const JpegOptions& options = {})
+{
+    auto is_mono = img.pixel_type() == Yimage::PixelType::MONO_8;
+    jpeg_compress_struct cinfo = {};
+    jpeg_error_mgr err = {};
+    cinfo.err = jpeg_std_error(&err);
+    jpeg_create_compress(&cinfo);
+    unsigned char* buffer = nullptr;
+    unsigned long size = 0;
+    jpeg_mem_dest(&cinfo, &buffer, &size);
+
+    cinfo.image_width = JDIMENSION(img.width());
+    cinfo.image_height = JDIMENSION(img.height());
+    cinfo.input_components = is_mono ? 1 : 3;
+    cinfo.in_color_space = is_mono ? JCS_GRAYSCALE : JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, options.quality, TRUE);
+    cinfo.restart_in_rows = options.restart_rows;
+    cinfo.restart_interval = options.restart_mcus;
+    if (!is_mono)
+    {
+        cinfo.comp_info[0].h_samp_factor = options.h_sampling;
+        cinfo.comp_info[0].v_samp_factor = options.v_sampling;
+    }
+
+    jpeg_start_compress(&cinfo, TRUE);
+    while (cinfo.next_scanline < cinfo.image_height)
+    {
+        auto row = const_cast<JSAMPROW>(img.data() + cinfo.next_scanline * img.row_size());
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+
+    std::vector<uint8_t> result(buffer, buffer + size);
+    free(buffer);
+    return result;
+}
@@ -0,0 +1,46 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <iosfwd>
+
+// Writes the time each camera spends per mouse motion event to os,
+// together with how far the grabbed point drifts from the cursor.
+void benchmark_cameras(std::ostream& os);
+
+// Converts a 16-bit test image to linear light and uploads it both as a
+// GL_RGB32F texture and as the GL_RGB16F texture the viewer uses, and
+// writes the conversion and upload times and the texture sizes to os.
+// Throws std::runtime_error if the driver rejects either texture.
+//
+// Requires a current OpenGL ES 3 context.
+void benchmark_hdr_upload(std::ostream& os);
+
+// Decodes a large 4:2:0 JPEG sequentially and with the parallel stripe
+// decoder on 2, 4 ... threads up to the number of hardware threads, and
+// writes the times and the speed-ups over the sequential decode to os.
+void benchmark_jpeg_decoding(std::ostream& os);
+
+// Builds a MarkerIndex of random markers and writes the time it takes to
+// build it, to find the ranges in a view, and to pick a marker with the
+// index and with a linear scan, to os.
+void benchmark_marker_index(std::ostream& os);
+
+// Writes the throughput of every kernel of every available backend to os.
+void benchmark_pixel_kernels(std::ostream& os);
+
+// Writes the throughput of every projection, on one thread and on all
+// of them, to os.
+void benchmark_reprojection(std::ostream& os);
+
+// Measures how fast TextureStaging converts every supported pixel type to
+// each upload format, and compares uploading an RGB image directly with
+// GL_UNPACK_ALIGNMENT 1 to uploading it through the staging buffer.
+// Writes the results to os.
+//
+// Requires a current OpenGL context.
+void benchmark_texture_staging(std::ostream& os);
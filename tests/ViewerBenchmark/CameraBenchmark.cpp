@@ -0,0 +1,112 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Benchmarks.hpp"
+
+#include <iomanip>
+#include <ostream>
+#include "DragPaths.hpp"
+#include "QuaternionCamera.hpp"
+#include "SphericalCamera.hpp"
+
+namespace
+{
+    constexpr auto PI = Xyz::Constants<double>::PI;
+
+    // Returns the largest angle in radians between the grabbed point
+    // and the point under the cursor.
+    double measure_drift(Camera& camera, const std::vector<DragPath>& paths)
+    {
+        setup_camera(camera);
+        double max_drift = 0;
+        Camera::Clock::time_point time;
+        for (const auto& path: paths)
+        {
+            camera.set_direction(path.azimuth, path.polar);
+            auto grabbed = Xyz::to_cartesian(camera.calc_sphere_pos(path.from));
+            camera.begin_drag(path.from, time);
+            for (size_t i = 1; i <= EVENTS_PER_DRAG; ++i)
+            {
+                time += EVENT_INTERVAL;
+                auto cursor = get_cursor_pos(path, i);
+                camera.drag(cursor, time);
+                auto pos = Xyz::to_cartesian(camera.calc_sphere_pos(cursor));
+                max_drift = std::max(max_drift, get_vector_angle(pos, grabbed));
+            }
+            camera.end_drag(time);
+        }
+        return max_drift;
+    }
+
+    // Returns the average time in nanoseconds spent on each mouse
+    // motion event, which moves the camera and reads the new center
+    // position for the HUD.
+    double measure_event_time(Camera& camera,
+                              const std::vector<DragPath>& paths)
+    {
+        using namespace std::chrono;
+        setup_camera(camera);
+        Camera::Clock::time_point time;
+        Xyz::Vector3D sum;
+        Camera::Clock::duration elapsed = {};
+        for (const auto& path: paths)
+        {
+            camera.set_direction(path.azimuth, path.polar);
+            camera.begin_drag(path.from, time);
+            auto start = steady_clock::now();
+            for (size_t i = 1; i <= EVENTS_PER_DRAG; ++i)
+            {
+                time += EVENT_INTERVAL;
+                camera.drag(get_cursor_pos(path, i), time);
+                sum = sum + camera.calc_center_pos();
+            }
+            elapsed += steady_clock::now() - start;
+            camera.end_drag(time);
+        }
+        // Keeps the compiler from optimizing away the center positions.
+        if (std::isnan(sum[0]))
+            return 0;
+        return duration<double, std::nano>(elapsed).count()
+               / double(paths.size() * EVENTS_PER_DRAG);
+    }
+}
+
+void benchmark_cameras(std::ostream& os)
+{
+    std::mt19937 rng(1234);
+    struct Scenario
+    {
+        const char* name;
+        std::vector<DragPath> paths;
+    };
+    Scenario scenarios[] = {
+        {"equator", make_drag_paths(2000, 0, Xyz::to_radians(60.0), rng)},
+        {"poles", make_drag_paths(2000, Xyz::to_radians(80.0), PI / 2, rng)}
+    };
+
+    os << std::left << std::setw(12) << "camera"
+       << std::setw(10) << "drags"
+       << std::right << std::setw(12) << "ns/event"
+       << std::setw(16) << "max drift (°)" << "\n";
+    auto measure = [&](const char* name, auto make_camera)
+    {
+        for (const auto& scenario: scenarios)
+        {
+            auto camera = make_camera();
+            auto ns = measure_event_time(camera, scenario.paths);
+            auto drift = measure_drift(camera, scenario.paths);
+            os << std::left << std::setw(12) << name
+               << std::setw(10) << scenario.name
+               << std::right << std::fixed
+               << std::setprecision(1) << std::setw(12) << ns
+               << std::setprecision(6) << std::setw(15)
+               << Xyz::to_degrees(drift) << "\n";
+        }
+    };
+    measure("spherical", [] {return SphericalCamera();});
+    measure("quaternion", [] {return QuaternionCamera();});
+}
@@ -0,0 +1,115 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <Tungsten/Tungsten.hpp>
+#include "Benchmarks.hpp"
+#include "HalfFloatImage.hpp"
+#include "Measure.hpp"
+
+#ifndef GL_RGB16F
+    #define GL_RGB16F 0x881B
+#endif
+#ifndef GL_RGB32F
+    #define GL_RGB32F 0x8815
+#endif
+#ifndef GL_HALF_FLOAT
+    #define GL_HALF_FLOAT 0x140B
+#endif
+
+namespace
+{
+    constexpr size_t WIDTH = 4096;
+    constexpr size_t HEIGHT = WIDTH / 2;
+
+    Yimage::Image make_test_image()
+    {
+        Yimage::Image img(Yimage::PixelType::RGB_16, WIDTH, HEIGHT);
+        for (size_t y = 0; y < HEIGHT; ++y)
+        {
+            auto row = reinterpret_cast<uint16_t*>(img.data() + y * img.row_size());
+            for (size_t x = 0; x < WIDTH; ++x)
+            {
+                row[3 * x] = uint16_t(x * 65535 / (WIDTH - 1));
+                row[3 * x + 1] = uint16_t(y * 65535 / (HEIGHT - 1));
+                row[3 * x + 2] = uint16_t((x * 7 + y * 13) * 31);
+            }
+        }
+        return img;
+    }
+
+    double measure_upload_ms(GLint internal_format, GLenum type,
+                             const void* pixels, GLint alignment)
+    {
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+        auto ms = measure_ms([&]
+        {
+            glTexImage2D(GL_TEXTURE_2D, 0, internal_format,
+                         GLsizei(WIDTH), GLsizei(HEIGHT), 0,
+                         GL_RGB, type, pixels);
+            glFinish();
+        });
+        auto error = glGetError();
+        glDeleteTextures(1, &texture);
+        if (error != GL_NO_ERROR)
+        {
+            throw std::runtime_error("The driver rejected the texture: GL error "
+                                     + std::to_string(error) + ".");
+        }
+        return ms;
+    }
+
+    void write_row(std::ostream& os, const char* name, double convert_ms,
+                   double upload_ms, size_t texture_bytes)
+    {
+        auto mpixels = double(WIDTH * HEIGHT) / 1e6;
+        os << std::left << std::setw(10) << name << std::right << std::fixed
+           << std::setprecision(1)
+           << std::setw(12) << convert_ms
+           << std::setw(12) << mpixels / convert_ms * 1000
+           << std::setw(11) << upload_ms
+           << std::setw(12) << double(texture_bytes) / (1 << 20) << "\n";
+    }
+}
+
+void benchmark_hdr_upload(std::ostream& os)
+{
+    auto img = make_test_image();
+
+    std::vector<float> floats;
+    auto float_ms = measure_ms([&] {floats = make_float_image(img);});
+    auto float_upload_ms = measure_upload_ms(GL_RGB32F, GL_FLOAT,
+                                             floats.data(), 4);
+
+    HalfFloatImage half_img;
+    auto half_ms = measure_ms([&]
+    {
+        half_img = make_half_float_image(img, std::max(WIDTH, HEIGHT));
+    });
+    auto half_upload_ms = measure_upload_ms(GL_RGB16F, GL_HALF_FLOAT,
+                                            half_img.pixels.data(), 2);
+
+    os << WIDTH << "x" << HEIGHT << " 16-bit RGB image, fastest of "
+       << MEASUREMENT_RUNS << " runs\n"
+       << std::left << std::setw(10) << "format"
+       << std::right << std::setw(12) << "convert ms"
+       << std::setw(12) << "Mpixels/s"
+       << std::setw(11) << "upload ms"
+       << std::setw(12) << "texture MB" << "\n";
+    write_row(os, "RGB32F", float_ms, float_upload_ms,
+              floats.size() * sizeof(float));
+    write_row(os, "RGB16F", half_ms, half_upload_ms,
+              half_img.pixels.size() * sizeof(uint16_t));
+}
@@ -0,0 +1,78 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Benchmarks.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+#include "JpegDecoder.hpp"
+#include "JpegEncoding.hpp"
+#include "Measure.hpp"
+#include "Parallel.hpp"
+
+namespace
+{
+    constexpr size_t WIDTH = 8192;
+    constexpr size_t HEIGHT = WIDTH / 2;
+
+    // 1, 2, 4 ... up to and including the number of hardware threads,
+    // and always at least one count above 1.
+    std::vector<unsigned> get_thread_counts()
+    {
+        auto max_count = std::max(get_default_thread_count(), 2u);
+        std::vector<unsigned> result;
+        for (unsigned count = 1; count < max_count; count *= 2)
+            result.push_back(count);
+        result.push_back(max_count);
+        return result;
+    }
+}
+
+void benchmark_jpeg_decoding(std::ostream& os)
+{
+    auto jpeg = encode_jpeg(make_colorful_image(WIDTH, HEIGHT));
+    os << "Decoding of a " << WIDTH << "x" << HEIGHT
+       << " 4:2:0 JPEG with a restart marker every MCU row, fastest of "
+       << MEASUREMENT_RUNS << " runs\n"
+       << std::right << std::setw(8) << "threads"
+       << std::setw(10) << "ms"
+       << std::setw(12) << "Mpixels/s"
+       << std::setw(10) << "speed-up" << "\n";
+
+    double sequential_ms = 0;
+    for (auto threads: get_thread_counts())
+    {
+        Yimage::Image img;
+        auto ms = measure_ms([&]
+        {
+            if (threads == 1)
+            {
+                JpegStreamDecoder decoder;
+                decoder.add_data(jpeg.data(), jpeg.size());
+                decoder.finish();
+                img = decoder.release_image();
+            }
+            else
+            {
+                img = read_jpeg_parallel(jpeg.data(), jpeg.size(), threads);
+            }
+        });
+        if (!img)
+            throw std::runtime_error("The JPEG could not be decoded in parallel.");
+        if (threads == 1)
+            sequential_ms = ms;
+
+        os << std::setw(8) << threads << std::fixed << std::setprecision(1)
+           << std::setw(10) << ms
+           << std::setw(12) << double(WIDTH * HEIGHT) / ms / 1000
+           << std::setprecision(2)
+           << std::setw(10) << sequential_ms / ms << "\n";
+    }
+}
@@ -0,0 +1,122 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Benchmarks.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <optional>
+#include <ostream>
+#include <random>
+#include "MarkerIndex.hpp"
+#include "Measure.hpp"
+
+namespace
+{
+    constexpr size_t MARKER_COUNT = 100000;
+    constexpr size_t QUERY_COUNT = 1000;
+    // The cone that covers a view with a 90 degree view angle, and the
+    // radius of a marker when it is picked.
+    constexpr double VIEW_ANGLE = 0.8;
+    constexpr double PICK_ANGLE = 0.01;
+
+    std::vector<Xyz::Vector3D> make_directions(size_t count, std::mt19937& rng)
+    {
+        std::normal_distribution<double> dist;
+        std::vector<Xyz::Vector3D> result;
+        for (size_t i = 0; i < count; ++i)
+            result.push_back(Xyz::get_unit(Xyz::Vector3D(dist(rng), dist(rng), dist(rng))));
+        return result;
+    }
+
+    // The linear scan that MarkerIndex::find_nearest replaces.
+    std::optional<size_t> find_nearest_linear(const std::vector<Xyz::Vector3F>& positions,
+                                              const Xyz::Vector3D& direction,
+                                              double max_angle)
+    {
+        auto dir = Xyz::vector_cast<float>(direction);
+        auto best_dot = float(std::cos(max_angle));
+        std::optional<size_t> result;
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            auto d = Xyz::dot(dir, positions[i]);
+            if (d >= best_dot)
+            {
+                best_dot = d;
+                result = i;
+            }
+        }
+        return result;
+    }
+
+    void write_row(std::ostream& os, const char* name, double us)
+    {
+        os << std::left << std::setw(24) << name
+           << std::right << std::fixed << std::setprecision(1)
+           << std::setw(12) << us << "\n";
+    }
+}
+
+void benchmark_marker_index(std::ostream& os)
+{
+    std::mt19937 rng(42);
+    std::vector<Xyz::Vector3F> markers;
+    for (const auto& dir: make_directions(MARKER_COUNT, rng))
+        markers.push_back(Xyz::vector_cast<float>(dir));
+    auto queries = make_directions(QUERY_COUNT, rng);
+
+    MarkerIndex index;
+    auto build_ms = measure_ms([&] {index = MarkerIndex(markers);});
+
+    std::vector<MarkerIndex::Range> ranges;
+    size_t range_count = 0;
+    auto ranges_ms = measure_ms([&]
+    {
+        range_count = 0;
+        for (const auto& query: queries)
+        {
+            index.find_ranges(query, VIEW_ANGLE, ranges);
+            range_count += ranges.size();
+        }
+    });
+
+    size_t found = 0;
+    auto nearest_ms = measure_ms([&]
+    {
+        found = 0;
+        for (const auto& query: queries)
+        {
+            if (index.find_nearest(query, PICK_ANGLE, ranges))
+                ++found;
+        }
+    });
+
+    size_t linear_found = 0;
+    auto linear_ms = measure_ms([&]
+    {
+        linear_found = 0;
+        for (const auto& query: queries)
+        {
+            if (find_nearest_linear(index.positions(), query, PICK_ANGLE))
+                ++linear_found;
+        }
+    });
+
+    auto per_query_us = [&](double ms) {return ms * 1000 / double(QUERY_COUNT);};
+    os << MARKER_COUNT << " random markers, " << QUERY_COUNT
+       << " random queries, fastest of " << MEASUREMENT_RUNS << " runs\n"
+       << std::left << std::setw(24) << "operation"
+       << std::right << std::setw(12) << "us" << "\n";
+    write_row(os, "build index", build_ms * 1000);
+    write_row(os, "find_ranges (view)", per_query_us(ranges_ms));
+    write_row(os, "find_nearest (pick)", per_query_us(nearest_ms));
+    write_row(os, "linear scan", per_query_us(linear_ms));
+    os << "Average ranges per view: "
+       << double(range_count) / double(QUERY_COUNT)
+       << ", picks that hit a marker: " << found
+       << " (linear scan: " << linear_found << ")\n";
+}
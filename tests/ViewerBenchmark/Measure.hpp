@@ -0,0 +1,31 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <chrono>
+
+// The number of times measure_ms runs each function.
+constexpr int MEASUREMENT_RUNS = 3;
+
+// Calls func MEASUREMENT_RUNS times and returns the fastest run in
+// milliseconds. The fastest run is the one least disturbed by other
+// processes and cold caches.
+template <typename Func>
+double measure_ms(Func func)
+{
+    using namespace std::chrono;
+    double best = 0;
+    for (int i = 0; i < MEASUREMENT_RUNS; ++i)
+    {
+        auto start = steady_clock::now();
+        func();
+        auto ms = duration<double, std::milli>(steady_clock::now() - start).count();
+        best = i == 0 ? ms : std::min(best, ms);
+    }
+    return best;
+}
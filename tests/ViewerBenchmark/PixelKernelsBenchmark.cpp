@@ -0,0 +1,83 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Benchmarks.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <random>
+#include <vector>
+#include "PixelKernels.hpp"
+
+namespace
+{
+    template <typename Func>
+    double measure(size_t bytes_per_call, Func func)
+    {
+        using namespace std::chrono;
+        // Run for at least 50 ms after a warm-up call.
+        func();
+        size_t calls = 0;
+        auto start = steady_clock::now();
+        duration<double> elapsed{};
+        do
+        {
+            func();
+            ++calls;
+            elapsed = steady_clock::now() - start;
+        } while (elapsed.count() < 0.05);
+        return double(bytes_per_call * calls) / elapsed.count() / 1e9;
+    }
+}
+
+void benchmark_pixel_kernels(std::ostream& os)
+{
+    constexpr size_t SIZE = 64 * 1024;
+    std::mt19937 rng(1234);
+    std::vector<uint8_t> bytes(SIZE * 4);
+    for (auto& b: bytes)
+        b = uint8_t(rng());
+    std::uniform_real_distribution<float> dist(-20.0f, 275.0f);
+    std::vector<float> floats(SIZE);
+    for (auto& f: floats)
+        f = dist(rng);
+    std::vector<float> float_out(SIZE);
+    std::vector<uint8_t> byte_out(SIZE * 4);
+    std::vector<uint16_t> half_out(SIZE);
+
+    os << "Selected kernels: " << get_pixel_kernels().name << "\n"
+       << std::left << std::setw(10) << "backend"
+       << std::right << std::setw(12) << "u8_to_f32"
+       << std::setw(12) << "f32_to_u8"
+       << std::setw(14) << "multiply_add"
+       << std::setw(13) << "rgb_to_rgba"
+       << std::setw(13) << "rgba_to_rgb"
+       << std::setw(13) << "mono_to_rgb"
+       << std::setw(12) << "f32_to_f16" << "   (GB/s of input)\n";
+    for (auto kernels: get_available_pixel_kernels())
+    {
+        auto& k = *kernels;
+        os << std::left << std::setw(10) << k.name << std::right << std::fixed
+           << std::setprecision(2)
+           << std::setw(12) << measure(SIZE, [&]
+              {k.u8_to_f32(bytes.data(), float_out.data(), SIZE);})
+           << std::setw(12) << measure(SIZE * 4, [&]
+              {k.f32_to_u8(floats.data(), byte_out.data(), SIZE);})
+           << std::setw(14) << measure(SIZE * 4, [&]
+              {k.multiply_add(floats.data(), 0.5f, float_out.data(), SIZE);})
+           << std::setw(13) << measure(SIZE * 3, [&]
+              {k.rgb_to_rgba(bytes.data(), byte_out.data(), SIZE);})
+           << std::setw(13) << measure(SIZE * 4, [&]
+              {k.rgba_to_rgb(bytes.data(), byte_out.data(), SIZE);})
+           << std::setw(13) << measure(SIZE, [&]
+              {k.mono_to_rgb(bytes.data(), byte_out.data(), SIZE);})
+           << std::setw(12) << measure(SIZE * 4, [&]
+              {k.f32_to_f16(floats.data(), half_out.data(), SIZE);})
+           << "\n";
+    }
+}
@@ -0,0 +1,67 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Benchmarks.hpp"
+
+#include <iomanip>
+#include <ostream>
+#include "DirectionImage.hpp"
+#include "Measure.hpp"
+#include "Reprojection.hpp"
+
+namespace
+{
+    constexpr auto PI = Xyz::Constants<double>::PI;
+    constexpr size_t WIDTH = 1920;
+    constexpr size_t HEIGHT = 1080;
+
+    struct BenchmarkView
+    {
+        ProjectionType type;
+        ProjectionView view;
+    };
+
+    const BenchmarkView VIEWS[] = {
+        {ProjectionType::PERSPECTIVE, {0, 0, PI / 2}},
+        {ProjectionType::FISHEYE, {0, 0, PI}},
+        {ProjectionType::STEREOGRAPHIC, {0, -PI / 2, 5 * PI / 3}},
+        {ProjectionType::MERCATOR, {0, 0, 2 * PI}},
+        {ProjectionType::CYLINDRICAL, {0, 0, 2 * PI}}
+    };
+}
+
+void benchmark_reprojection(std::ostream& os)
+{
+    auto panorama = make_direction_image(4096);
+    auto thread_count = get_default_thread_count();
+    os << "Reprojection of a " << panorama.width() << "x" << panorama.height()
+       << " panorama to " << WIDTH << "x" << HEIGHT
+       << ", fastest of " << MEASUREMENT_RUNS << " runs\n"
+       << std::left << std::setw(18) << "projection"
+       << std::right << std::setw(8) << "threads"
+       << std::setw(10) << "ms"
+       << std::setw(12) << "Mpixels/s" << "\n";
+
+    for (const auto& bv: VIEWS)
+    {
+        for (auto threads: {1u, thread_count})
+        {
+            Yimage::Image img;
+            auto ms = measure_ms([&]
+            {
+                img = reproject(panorama, bv.type, bv.view, WIDTH, HEIGHT, threads);
+            });
+            os << std::left << std::setw(18) << get_projection_name(bv.type)
+               << std::right << std::setw(8) << threads
+               << std::fixed << std::setprecision(1)
+               << std::setw(10) << ms
+               << std::setw(12) << double(WIDTH * HEIGHT) / ms / 1000 << "\n";
+            if (thread_count == 1)
+                break;
+        }
+    }
+}
@@ -0,0 +1,151 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include "Benchmarks.hpp"
+#include "Measure.hpp"
+#include "TextureStaging.hpp"
+
+namespace
+{
+    // The odd width makes the rows of RGB images unaligned.
+    constexpr size_t ODD_WIDTH = 4095;
+    constexpr size_t HEIGHT = 2048;
+
+    struct PixelTypeInfo
+    {
+        Yimage::PixelType type;
+        const char* name;
+    };
+
+    constexpr PixelTypeInfo PIXEL_TYPES[] = {
+        {Yimage::PixelType::MONO_8, "mono"},
+        {Yimage::PixelType::MONO_ALPHA_8, "mono+alpha"},
+        {Yimage::PixelType::RGB_8, "rgb"},
+        {Yimage::PixelType::RGBA_8, "rgba"}
+    };
+
+    const char* get_name(UploadFormat format)
+    {
+        return format == UploadFormat::RGBA ? "RGBA" : "RGB";
+    }
+
+    Yimage::Image make_test_image(Yimage::PixelType type, size_t width)
+    {
+        Yimage::Image img(type, width, HEIGHT);
+        for (size_t y = 0; y < HEIGHT; ++y)
+        {
+            auto row = img.data() + y * img.row_size();
+            for (size_t i = 0; i < img.row_size(); ++i)
+                row[i] = uint8_t(i * 7 + y * 13);
+        }
+        return img;
+    }
+
+    void check_gl_error()
+    {
+        if (auto error = glGetError(); error != GL_NO_ERROR)
+        {
+            throw std::runtime_error("The driver rejected the texture: GL error "
+                                     + std::to_string(error) + ".");
+        }
+    }
+
+    void write_conversions(std::ostream& os)
+    {
+        os << "Conversion of " << ODD_WIDTH << "x" << HEIGHT
+           << " images, fastest of " << MEASUREMENT_RUNS << " runs\n"
+           << std::left << std::setw(12) << "source"
+           << std::setw(8) << "format"
+           << std::right << std::setw(10) << "ms"
+           << std::setw(12) << "Mpixels/s" << "\n";
+        TextureStaging staging;
+        for (const auto& info: PIXEL_TYPES)
+        {
+            auto img = make_test_image(info.type, ODD_WIDTH);
+            for (auto format: {UploadFormat::RGB, UploadFormat::RGBA})
+            {
+                StagedPixels staged;
+                auto ms = measure_ms([&]
+                {
+                    staged = staging.stage(img, format, 0, img.height());
+                });
+                os << std::left << std::setw(12) << info.name
+                   << std::setw(8) << get_name(format) << std::right;
+                if (staged.data == img.data())
+                {
+                    os << std::setw(22) << "uploaded directly\n";
+                    continue;
+                }
+                os << std::fixed << std::setprecision(1)
+                   << std::setw(10) << ms
+                   << std::setw(12) << double(ODD_WIDTH * HEIGHT) / ms / 1000
+                   << "\n";
+            }
+        }
+    }
+
+    // Uploads img the way the viewer did before it had a staging buffer.
+    void upload_unaligned(const Yimage::Image& img)
+    {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        Tungsten::set_texture_image_2d(GL_TEXTURE_2D, 0, GL_RGB,
+                                       int(img.width()), int(img.height()),
+                                       GL_RGB, GL_UNSIGNED_BYTE, img.data());
+    }
+
+    void write_uploads(std::ostream& os)
+    {
+        os << "Upload of RGB images, including conversion\n"
+           << std::left << std::setw(8) << "width"
+           << std::setw(22) << "method"
+           << std::right << std::setw(10) << "ms"
+           << std::setw(12) << "texture MB" << "\n";
+
+        GLuint texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        TextureStaging staging;
+        auto write_row = [&](size_t width, const char* method, double ms,
+                             size_t pixel_size)
+        {
+            check_gl_error();
+            os << std::left << std::setw(8) << width
+               << std::setw(22) << method
+               << std::right << std::fixed << std::setprecision(1)
+               << std::setw(10) << ms
+               << std::setw(12) << double(width * HEIGHT * pixel_size) / (1 << 20)
+               << "\n";
+        };
+
+        for (auto width: {ODD_WIDTH, ODD_WIDTH + 1})
+        {
+            auto img = make_test_image(Yimage::PixelType::RGB_8, width);
+            auto ms = measure_ms([&] {upload_unaligned(img); glFinish();});
+            write_row(width, "RGB, alignment 1", ms, 3);
+            for (auto format: {UploadFormat::RGB, UploadFormat::RGBA})
+            {
+                ms = measure_ms([&] {staging.set_image(img, format); glFinish();});
+                auto method = std::string("staged ") + get_name(format);
+                write_row(width, method.c_str(), ms, get_pixel_size(format));
+            }
+        }
+        glDeleteTextures(1, &texture);
+        os << "Staging buffer: "
+           << std::setprecision(1) << double(staging.buffer_size()) / (1 << 20)
+           << " MB\n";
+    }
+}
+
+void benchmark_texture_staging(std::ostream& os)
+{
+    write_conversions(os);
+    write_uploads(os);
+}
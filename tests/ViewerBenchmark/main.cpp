@@ -0,0 +1,129 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <Argos/Argos.hpp>
+#include <Tungsten/Tungsten.hpp>
+#include "Benchmarks.hpp"
+
+namespace
+{
+    struct Benchmark
+    {
+        const char* name;
+        void (*func)(std::ostream&);
+        bool needs_gl = false;
+    };
+
+    constexpr Benchmark BENCHMARKS[] = {
+        {"camera", benchmark_cameras},
+        {"hdr", benchmark_hdr_upload, true},
+        {"jpeg", benchmark_jpeg_decoding},
+        {"kernels", benchmark_pixel_kernels},
+        {"markers", benchmark_marker_index},
+        {"projections", benchmark_reprojection},
+        {"staging", benchmark_texture_staging, true}
+    };
+
+    void run_benchmark(const Benchmark& benchmark)
+    {
+        std::cout << "== " << benchmark.name << " ==\n";
+        benchmark.func(std::cout);
+        std::cout << "\n";
+    }
+
+    // Runs the benchmarks that need OpenGL once the window and its
+    // context have been created, and quits.
+    class GlBenchmarkRunner : public Tungsten::EventLoop
+    {
+    public:
+        explicit GlBenchmarkRunner(std::vector<const Benchmark*> benchmarks)
+            : benchmarks_(std::move(benchmarks))
+        {}
+
+        void on_startup(Tungsten::SdlApplication&) override
+        {
+            for (auto benchmark: benchmarks_)
+                run_benchmark(*benchmark);
+            SDL_Event event = {};
+            event.type = SDL_QUIT;
+            SDL_PushEvent(&event);
+        }
+    private:
+        std::vector<const Benchmark*> benchmarks_;
+    };
+
+    std::string get_benchmark_names()
+    {
+        std::string result;
+        for (const auto& benchmark: BENCHMARKS)
+        {
+            if (!result.empty())
+                result += ", ";
+            result += benchmark.name;
+        }
+        return result;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        argos::ArgumentParser parser(argv[0]);
+        parser.about("Measures the performance of the viewer's image"
+                     " processing and rendering.");
+        parser.add(argos::Arg("BENCHMARK")
+                       .count(0, UINT_MAX)
+                       .help("The benchmarks to run: " + get_benchmark_names()
+                             + ". All of them are run if none are given."));
+        auto args = parser.parse(argc, argv);
+        auto names = args.values("BENCHMARK").as_strings();
+        for (const auto& name: names)
+        {
+            if (std::none_of(std::begin(BENCHMARKS), std::end(BENCHMARKS),
+                             [&](auto& b) {return name == b.name;}))
+            {
+                throw std::runtime_error("Unknown benchmark: " + name);
+            }
+        }
+
+        std::vector<const Benchmark*> gl_benchmarks;
+        for (const auto& benchmark: BENCHMARKS)
+        {
+            if (!names.empty()
+                && std::find(names.begin(), names.end(), benchmark.name) == names.end())
+            {
+                continue;
+            }
+            if (benchmark.needs_gl)
+                gl_benchmarks.push_back(&benchmark);
+            else
+                run_benchmark(benchmark);
+        }
+
+        if (!gl_benchmarks.empty())
+        {
+            Tungsten::SdlApplication app(
+                "ViewerBenchmark",
+                std::make_unique<GlBenchmarkRunner>(std::move(gl_benchmarks)));
+            app.run();
+        }
+    }
+    catch (std::exception& ex)
+    {
+        std::cerr << ex.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <vector>
+#include "Sphere.hpp"
+#include "SphericalCamera.hpp"
+
+struct TestView
+{
+    double azimuth;
+    double polar;
+    double view_angle;
+    int width;
+    int height;
+};
+
+// Draws sphere with the view and eye in an off-screen buffer and returns
+// the pixels as RGBA with the top row first.
+inline std::vector<unsigned char> draw_view(Sphere& sphere, const TestView& view,
+                                            StereoEye eye = StereoEye::LEFT)
+{
+    SphericalCamera camera;
+    camera.set_screen_res({double(view.width), double(view.height)});
+    camera.set_view_angle(view.view_angle);
+    camera.set_eye_dist(0.5);
+    camera.set_direction(view.azimuth, view.polar);
+
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, view.width, view.height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    GLuint framebuffer = 0;
+    glGenFramebuffers(1, &framebuffer);
+    GLint prev_framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prev_framebuffer);
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                           GL_TEXTURE_2D, texture, 0);
+    glViewport(0, 0, view.width, view.height);
+    glClearColor(0, 0, 0, 1);
+    glClear(GL_COLOR_BUFFER_BIT);
+    sphere.draw(make_mv_matrix(camera), make_p_matrix(camera), eye);
+
+    auto row_size = size_t(view.width) * 4;
+    std::vector<unsigned char> pixels(row_size * size_t(view.height));
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, view.width, view.height, GL_RGBA, GL_UNSIGNED_BYTE,
+                 pixels.data());
+
+    glBindFramebuffer(GL_FRAMEBUFFER, GLuint(prev_framebuffer));
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &texture);
+
+    // OpenGL returns the bottom row first.
+    std::vector<unsigned char> result(pixels.size());
+    for (size_t y = 0; y < size_t(view.height); ++y)
+    {
+        std::copy_n(pixels.data() + (size_t(view.height) - 1 - y) * row_size,
+                    row_size, result.data() + y * row_size);
+    }
+    return result;
+}
@@ -0,0 +1,58 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <iostream>
+#include <catch2/catch_session.hpp>
+#include <Tungsten/Tungsten.hpp>
+
+namespace
+{
+    // Runs the tests once the window and its OpenGL context have been
+    // created, and quits.
+    class TestRunner : public Tungsten::EventLoop
+    {
+    public:
+        TestRunner(int argc, char* argv[])
+            : argc_(argc), argv_(argv)
+        {}
+
+        void on_startup(Tungsten::SdlApplication&) override
+        {
+            result_ = Catch::Session().run(argc_, argv_);
+            SDL_Event event = {};
+            event.type = SDL_QUIT;
+            SDL_PushEvent(&event);
+        }
+
+        [[nodiscard]]
+        int result() const
+        {
+            return result_;
+        }
+    private:
+        int argc_;
+        char** argv_;
+        int result_ = 1;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        auto runner = std::make_unique<TestRunner>(argc, argv);
+        auto& runner_ref = *runner;
+        Tungsten::SdlApplication app("ViewerGlTest", std::move(runner));
+        app.run();
+        return runner_ref.result();
+    }
+    catch (std::exception& ex)
+    {
+        std::cerr << ex.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,100 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <algorithm>
+#include <sstream>
+#include <catch2/catch_test_macros.hpp>
+#include "Sphere.hpp"
+
+namespace
+{
+    constexpr size_t WIDTH = 2048;
+    constexpr size_t HEIGHT = WIDTH / 2;
+
+    Yimage::Image make_test_image()
+    {
+        Yimage::Image img(Yimage::PixelType::RGB_8, WIDTH, HEIGHT);
+        for (size_t y = 0; y < HEIGHT; ++y)
+        {
+            auto row = img.data() + y * img.row_size();
+            for (size_t i = 0; i < img.row_size(); ++i)
+                row[i] = uint8_t(i + y);
+        }
+        return img;
+    }
+
+    const AssetMemory* find_asset(const std::vector<AssetMemory>& assets,
+                                  const std::string& name)
+    {
+        auto it = std::find_if(assets.begin(), assets.end(),
+                               [&](auto& a) {return a.name == name;});
+        return it != assets.end() ? &*it : nullptr;
+    }
+
+    std::string to_string(const std::vector<AssetMemory>& assets)
+    {
+        std::ostringstream ss;
+        write_asset_memory(ss, assets);
+        return ss.str();
+    }
+
+    // Checks that the image has been uploaded and that the staging
+    // buffer is the only host memory left.
+    void require_uploaded(const std::vector<AssetMemory>& assets,
+                          size_t texture_bytes)
+    {
+        INFO(to_string(assets));
+        REQUIRE(find_asset(assets, "pending texture") == nullptr);
+        auto staging = find_asset(assets, "staging buffer");
+        REQUIRE(staging != nullptr);
+        REQUIRE(get_host_bytes(assets) == staging->host_bytes);
+        auto texture = find_asset(assets, "texture");
+        REQUIRE(texture != nullptr);
+        REQUIRE(texture->gpu_bytes == texture_bytes);
+    }
+}
+
+TEST_CASE("Sphere keeps no host copy of an image after set_image")
+{
+    Sphere sphere(16, 60);
+    auto pixel_size = get_pixel_size(sphere.texture_options.upload_format);
+    sphere.set_image(make_test_image());
+    require_uploaded(sphere.asset_memory(), WIDTH * HEIGHT * pixel_size);
+}
+
+TEST_CASE("Sphere releases the host copy when an incremental upload finishes")
+{
+    Sphere sphere(16, 60);
+    auto pixel_size = get_pixel_size(sphere.texture_options.upload_format);
+    auto texture_bytes = WIDTH * HEIGHT * pixel_size;
+    sphere.set_image(make_test_image());
+
+    auto texture = prepare_sphere_texture(make_test_image(),
+                                          sphere.texture_options,
+                                          sphere.texture_limits());
+    auto image_bytes = get_host_bytes(texture);
+    REQUIRE(image_bytes == WIDTH * HEIGHT * 3);
+
+    // A small budget makes the upload take several frames.
+    sphere.start_upload(std::move(texture), {0, WIDTH * pixel_size * 64});
+    auto assets = sphere.asset_memory();
+    INFO(to_string(assets));
+    auto pending = find_asset(assets, "pending texture");
+    REQUIRE(pending != nullptr);
+    REQUIRE(pending->host_bytes == image_bytes);
+    REQUIRE(pending->gpu_bytes == texture_bytes);
+    // The previous texture is drawn until the upload has finished.
+    auto previous = find_asset(assets, "texture");
+    REQUIRE(previous != nullptr);
+    REQUIRE(previous->gpu_bytes == texture_bytes);
+
+    int frames = 1;
+    while (!sphere.continue_upload())
+        ++frames;
+    REQUIRE(frames > 1);
+    require_uploaded(sphere.asset_memory(), texture_bytes);
+}
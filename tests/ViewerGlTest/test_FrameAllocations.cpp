@@ -0,0 +1,125 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <random>
+#include <catch2/catch_test_macros.hpp>
+#include "AllocationTracker.hpp"
+#include "AnnotationLayer.hpp"
+#include "DragPaths.hpp"
+#include "Hud.hpp"
+#include "Sphere.hpp"
+#include "SphericalCamera.hpp"
+
+namespace
+{
+    // The check pans for a while before it starts counting, to let
+    // buffers and caches grow to their steady-state size.
+    constexpr size_t WARMUP_FRAMES = 30;
+    constexpr size_t CHECKED_FRAMES = 120;
+    constexpr size_t MARKER_COUNT = 1000;
+
+    Yimage::Image make_test_image()
+    {
+        Yimage::Image img(Yimage::PixelType::RGB_8, 2048, 1024);
+        for (size_t y = 0; y < img.height(); ++y)
+        {
+            auto row = img.data() + y * img.row_size();
+            for (size_t i = 0; i < img.row_size(); ++i)
+                row[i] = uint8_t(i ^ y);
+        }
+        return img;
+    }
+
+    std::vector<Xyz::SphericalPointD> make_markers(std::mt19937& rng)
+    {
+        constexpr auto PI = Xyz::Constants<double>::PI;
+        std::uniform_real_distribution<double> az_dist(-PI, PI);
+        std::uniform_real_distribution<double> polar_dist(-PI / 2, PI / 2);
+        std::vector<Xyz::SphericalPointD> result;
+        for (size_t i = 0; i < MARKER_COUNT; ++i)
+            result.emplace_back(1.0, az_dist(rng), polar_dist(rng));
+        return result;
+    }
+
+    // Draws a frame the way the viewer does while the mouse drags the
+    // view, with the HUD and markers visible.
+    class PanningScene
+    {
+    public:
+        PanningScene()
+            : sphere_(make_test_image(), 16, 60)
+        {
+            std::mt19937 rng(42);
+            paths_ = make_drag_paths(8, 0, 1.2, rng);
+            setup_camera(camera_);
+            annotations_.set_markers(make_markers(rng));
+            hud_.visible = true;
+        }
+
+        void draw_frame()
+        {
+            const auto& path = paths_[(frame_ / EVENTS_PER_DRAG) % paths_.size()];
+            auto event = frame_ % EVENTS_PER_DRAG;
+            time_ += EVENT_INTERVAL;
+            if (event == 0)
+            {
+                camera_.set_direction(path.azimuth, path.polar);
+                camera_.begin_drag(path.from, time_);
+            }
+            auto pos = get_cursor_pos(path, event + 1);
+            camera_.drag(pos, time_);
+            auto center = Xyz::to_degrees(Xyz::to_spherical(camera_.calc_center_pos()));
+            hud_.set_angles(center.azimuth, center.polar);
+            hud_.set_marker(annotations_.find_marker(camera_, pos));
+            hud_.add_frame(Hud::Clock::now());
+            if (event + 1 == EVENTS_PER_DRAG)
+                camera_.end_drag(time_);
+
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            auto mv_matrix = make_mv_matrix(camera_);
+            auto p_matrix = make_p_matrix(camera_);
+            sphere_.draw(mv_matrix, p_matrix);
+            annotations_.draw(camera_, mv_matrix, p_matrix);
+            hud_.draw({1280, 720});
+            glFinish();
+            ++frame_;
+        }
+    private:
+        Sphere sphere_;
+        SphericalCamera camera_;
+        AnnotationLayer annotations_;
+        Hud hud_;
+        std::vector<DragPath> paths_;
+        size_t frame_ = 0;
+        Camera::Clock::time_point time_ = Camera::Clock::now();
+    };
+}
+
+TEST_CASE("Panning with the HUD visible doesn't allocate memory")
+{
+    static_assert(IS_TRACKING_ALLOCATIONS,
+                  "ViewerGlTest must be built with VIEWER_TRACK_ALLOCATIONS.");
+    PanningScene scene;
+    for (size_t i = 0; i < WARMUP_FRAMES; ++i)
+        scene.draw_frame();
+
+    FrameAllocationCounter counter;
+    counter.end_frame();
+    set_allocation_sampling(1);
+    for (size_t i = 0; i < CHECKED_FRAMES; ++i)
+    {
+        scene.draw_frame();
+        counter.end_frame();
+    }
+    set_allocation_sampling(0);
+
+    if (counter.allocating_frame_count() != 0)
+        write_allocation_samples();
+    INFO("At most " << counter.max_allocations() << " allocations in one frame.");
+    REQUIRE(counter.frame_count() == CHECKED_FRAMES);
+    REQUIRE(counter.total_allocations() == 0);
+}
@@ -0,0 +1,96 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <cmath>
+#include <catch2/catch_test_macros.hpp>
+#include "DrawView.hpp"
+#include "Reprojection.hpp"
+
+namespace
+{
+    // The largest allowed average difference per channel, and the
+    // largest allowed share of channels that differ by more than
+    // OUTLIER_DIFF. Edges in the test image can move by a fraction of a
+    // pixel because the GPU has less precision than the CPU.
+    constexpr double MAX_MEAN_DIFF = 1.0;
+    constexpr int OUTLIER_DIFF = 32;
+    constexpr double MAX_OUTLIER_SHARE = 0.005;
+
+    // A smooth gradient with a checkerboard on top, so that both small
+    // and large errors in the texture coordinates show up.
+    Yimage::Image make_test_image()
+    {
+        constexpr size_t WIDTH = 1024;
+        constexpr size_t HEIGHT = WIDTH / 2;
+        Yimage::Image img(Yimage::PixelType::RGB_8, WIDTH, HEIGHT);
+        for (size_t y = 0; y < HEIGHT; ++y)
+        {
+            auto row = img.data() + y * img.row_size();
+            for (size_t x = 0; x < WIDTH; ++x)
+            {
+                bool is_dark = ((x / 64) + (y / 64)) % 2 != 0;
+                row[3 * x] = static_cast<unsigned char>(x * 255 / (WIDTH - 1));
+                row[3 * x + 1] = static_cast<unsigned char>(y * 255 / (HEIGHT - 1));
+                row[3 * x + 2] = is_dark ? 40 : 220;
+            }
+        }
+        return img;
+    }
+}
+
+// Draws a test image in a few views with the ray-cast render mode and
+// compares the pixels with reproject, which does the same projection on
+// the CPU.
+TEST_CASE("The ray-cast render mode matches the CPU projection")
+{
+    constexpr auto PI = Xyz::Constants<double>::PI;
+    const TestView views[] = {
+        {0, 0, PI / 2, 320, 240},
+        {2.1, 0.8, PI / 3, 320, 240},
+        {-1.0, 1.55, 1.75, 320, 240},
+        {0.5, -PI / 2, 2.0, 240, 320},
+        {PI, 0.2, 0.07, 320, 240}
+    };
+
+    auto panorama = make_test_image();
+    Sphere sphere(panorama, 16, 60);
+    sphere.render_mode = SphereRenderMode::RAY_CAST;
+
+    for (const auto& view: views)
+    {
+        CAPTURE(view.azimuth, view.polar, view.view_angle);
+        auto gpu = draw_view(sphere, view);
+        auto cpu = reproject<PerspectiveProjection>(
+            panorama, {view.azimuth, view.polar, view.view_angle},
+            size_t(view.width), size_t(view.height));
+
+        double sum = 0;
+        size_t outliers = 0;
+        auto width = size_t(view.width), height = size_t(view.height);
+        for (size_t y = 0; y < height; ++y)
+        {
+            auto gpu_row = gpu.data() + y * width * 4;
+            auto cpu_row = cpu.data() + y * cpu.row_size();
+            for (size_t x = 0; x < width; ++x)
+            {
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    auto diff = std::abs(int(gpu_row[4 * x + c])
+                                         - int(cpu_row[3 * x + c]));
+                    sum += diff;
+                    if (diff > OUTLIER_DIFF)
+                        ++outliers;
+                }
+            }
+        }
+
+        auto mean = sum / double(3 * width * height);
+        auto outlier_share = double(outliers) / double(3 * width * height);
+        REQUIRE(mean <= MAX_MEAN_DIFF);
+        REQUIRE(outlier_share <= MAX_OUTLIER_SHARE);
+    }
+}
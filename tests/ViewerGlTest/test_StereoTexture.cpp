@@ -0,0 +1,93 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <cstdlib>
+#include <catch2/catch_test_macros.hpp>
+#include "DrawView.hpp"
+
+namespace
+{
+    // The largest difference from the eye's color that is allowed. The
+    // rows next to the border between the eyes would be half of each
+    // color if the filter blended them.
+    constexpr int MAX_DIFF = 4;
+
+    // An over/under stereo image where the left eye's half is red and
+    // the right eye's half is blue.
+    Yimage::Image make_stereo_image()
+    {
+        constexpr size_t WIDTH = 256;
+        constexpr size_t HEIGHT = WIDTH;
+        Yimage::Image img(Yimage::PixelType::RGB_8, WIDTH, HEIGHT);
+        for (size_t y = 0; y < HEIGHT; ++y)
+        {
+            auto row = img.data() + y * img.row_size();
+            bool is_left = y < HEIGHT / 2;
+            for (size_t x = 0; x < WIDTH; ++x)
+            {
+                row[3 * x] = is_left ? 255 : 0;
+                row[3 * x + 1] = 0;
+                row[3 * x + 2] = is_left ? 0 : 255;
+            }
+        }
+        return img;
+    }
+
+    // Returns the number of pixels that differ from the eye's color.
+    size_t count_foreign_pixels(const std::vector<unsigned char>& pixels,
+                                StereoEye eye)
+    {
+        int red = eye == StereoEye::LEFT ? 255 : 0;
+        int blue = 255 - red;
+        size_t count = 0;
+        for (size_t i = 0; i < pixels.size(); i += 4)
+        {
+            if (std::abs(pixels[i] - red) > MAX_DIFF
+                || pixels[i + 1] > MAX_DIFF
+                || std::abs(pixels[i + 2] - blue) > MAX_DIFF)
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+}
+
+// The poles are at the border between the eyes' halves of the texture
+// (the left eye's nadir and the right eye's zenith) and at its top and
+// bottom edges.
+TEST_CASE("Each eye only samples its own half of a stereo texture")
+{
+    constexpr auto PI = Xyz::Constants<double>::PI;
+    const TestView views[] = {
+        {0, PI / 2, 1.5, 64, 64},
+        {0, -PI / 2, 1.5, 64, 64},
+        {1.0, 0, 1.5, 64, 64}
+    };
+
+    Sphere sphere(16, 60);
+    sphere.stereo_layout = StereoLayout::OVER_UNDER;
+    // A large bias makes the mesh use the smallest mipmaps if the
+    // texture has them.
+    sphere.texture_options.mipmaps = true;
+    sphere.mip_bias = 4;
+    sphere.set_image(make_stereo_image());
+
+    for (auto mode: {SphereRenderMode::MESH, SphereRenderMode::RAY_CAST})
+    {
+        sphere.render_mode = mode;
+        for (auto eye: {StereoEye::LEFT, StereoEye::RIGHT})
+        {
+            for (const auto& view: views)
+            {
+                CAPTURE(int(mode), int(eye), view.polar);
+                auto pixels = draw_view(sphere, view, eye);
+                REQUIRE(count_foreign_pixels(pixels, eye) == 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "AllocationTracker.hpp"
+#include "TextureStaging.hpp"
+
+namespace
+{
+    // The odd width makes the rows unaligned in both upload formats.
+    constexpr size_t WIDTH = 1023;
+    constexpr size_t HEIGHT = 512;
+    // The number of rows IncrementalUpload typically uploads per frame.
+    constexpr size_t STRIPE_ROWS = 32;
+
+    Yimage::Image make_mono_image()
+    {
+        Yimage::Image img(Yimage::PixelType::MONO_8, WIDTH, HEIGHT);
+        for (size_t y = 0; y < HEIGHT; ++y)
+        {
+            auto row = img.data() + y * img.row_size();
+            for (size_t x = 0; x < WIDTH; ++x)
+                row[x] = uint8_t(x * 7 + y * 13);
+        }
+        return img;
+    }
+}
+
+TEST_CASE("TextureStaging converts mono rows to RGBA")
+{
+    auto img = make_mono_image();
+    TextureStaging staging;
+    for (size_t first_row = 0; first_row < HEIGHT; first_row += STRIPE_ROWS)
+    {
+        auto staged = staging.stage(img, UploadFormat::RGBA,
+                                    first_row, STRIPE_ROWS);
+        REQUIRE(staged.format == GLenum(GL_RGBA));
+        REQUIRE(staged.row_count == STRIPE_ROWS);
+        for (size_t i = 0; i < STRIPE_ROWS; ++i)
+        {
+            auto src = img.data() + (first_row + i) * img.row_size();
+            auto dst = staged.data + i * WIDTH * 4;
+            for (size_t x = 0; x < WIDTH; ++x)
+            {
+                CAPTURE(first_row + i, x);
+                REQUIRE(dst[4 * x] == src[x]);
+                REQUIRE(dst[4 * x + 1] == src[x]);
+                REQUIRE(dst[4 * x + 2] == src[x]);
+                REQUIRE(dst[4 * x + 3] == 255);
+            }
+        }
+    }
+}
+
+TEST_CASE("Uploading stripes through TextureStaging doesn't allocate memory")
+{
+    auto img = make_mono_image();
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    Tungsten::set_texture_image_2d(GL_TEXTURE_2D, 0, GL_RGBA,
+                                   int(WIDTH), int(HEIGHT),
+                                   GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    // The first stripe makes the staging buffers large enough for the
+    // rest, the remaining stripes are uploaded the way Sphere's
+    // incremental uploads do it, one per frame.
+    TextureStaging staging;
+    staging.set_rows(img, UploadFormat::RGBA, 0, STRIPE_ROWS);
+    auto buffer_size = staging.buffer_size();
+    auto before = get_thread_allocation_counts();
+    for (size_t row = STRIPE_ROWS; row < HEIGHT; row += STRIPE_ROWS)
+        staging.set_rows(img, UploadFormat::RGBA, row, STRIPE_ROWS);
+    auto after = get_thread_allocation_counts();
+    glDeleteTextures(1, &texture);
+
+    REQUIRE(glGetError() == GLenum(GL_NO_ERROR));
+    REQUIRE(after.allocations == before.allocations);
+    REQUIRE(staging.buffer_size() == buffer_size);
+}
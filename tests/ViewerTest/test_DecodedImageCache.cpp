@@ -0,0 +1,244 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "DecodedImageCache.hpp"
+
+namespace
+{
+    // A directory that is empty at the start of each test and removed
+    // at the end.
+    class TemporaryDirectory
+    {
+    public:
+        explicit TemporaryDirectory(const std::string& name)
+            : path_(std::filesystem::temp_directory_path() / name)
+        {
+            std::filesystem::remove_all(path_);
+            std::filesystem::create_directories(path_);
+        }
+
+        ~TemporaryDirectory()
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(path_, ec);
+        }
+
+        [[nodiscard]]
+        std::string operator/(const std::string& name) const
+        {
+            return (path_ / name).string();
+        }
+    private:
+        std::filesystem::path path_;
+    };
+
+    // An image where every byte depends on its position. The values
+    // of 16-bit images use both bytes.
+    Yimage::Image make_test_image(Yimage::PixelType type)
+    {
+        Yimage::Image img(type, 37, 23);
+        for (size_t i = 0; i < img.size(); ++i)
+            img.data()[i] = uint8_t(i * 7 + i / 5);
+        return img;
+    }
+
+    bool is_same_image(const Yimage::Image& a, const Yimage::Image& b)
+    {
+        return a.pixel_type() == b.pixel_type()
+               && a.width() == b.width()
+               && a.height() == b.height()
+               && a.size() == b.size()
+               && std::equal(a.data(), a.data() + a.size(), b.data());
+    }
+
+    // Returns the paths of the files in dir whose names end with suffix.
+    std::vector<std::string> find_files(const std::string& dir,
+                                        const std::string& suffix)
+    {
+        std::vector<std::string> result;
+        for (const auto& entry: std::filesystem::directory_iterator(dir))
+        {
+            auto name = entry.path().filename().string();
+            if (name.size() >= suffix.size()
+                && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+            {
+                result.push_back(entry.path().string());
+            }
+        }
+        return result;
+    }
+
+    bool contains_temporary_files(const std::string& dir)
+    {
+        for (const auto& entry: std::filesystem::directory_iterator(dir))
+        {
+            if (entry.path().filename().string().find(".tmp") != std::string::npos)
+                return true;
+        }
+        return false;
+    }
+
+    void require_round_trip(Yimage::PixelType type)
+    {
+        TemporaryDirectory dir("ViewerTest-decoded-image-cache");
+        auto path = dir / "image.png";
+        auto img = make_test_image(type);
+        Yimage::write_png(path, img);
+
+        DecodedImageCache cache(dir / "cache");
+        auto decoded = cache.read_image_file(path, 1);
+        auto cached = cache.read_image_file(path, 1);
+
+        auto stats = cache.stats();
+        REQUIRE(stats.lookups == 2);
+        REQUIRE(stats.hits == 1);
+        REQUIRE(stats.bytes_saved == img.size());
+        REQUIRE(is_same_image(decoded, img));
+        REQUIRE(is_same_image(cached, img));
+    }
+}
+
+TEST_CASE("DecodedImageCache returns cached 8-bit images")
+{
+    require_round_trip(Yimage::PixelType::RGB_8);
+}
+
+TEST_CASE("DecodedImageCache returns cached 16-bit images")
+{
+    require_round_trip(Yimage::PixelType::RGB_16);
+}
+
+TEST_CASE("DecodedImageCache misses images it hasn't seen")
+{
+    TemporaryDirectory dir("ViewerTest-decoded-image-cache");
+    auto path_a = dir / "a.png";
+    auto path_b = dir / "b.png";
+    Yimage::write_png(path_a, make_test_image(Yimage::PixelType::RGB_8));
+    Yimage::write_png(path_b, make_test_image(Yimage::PixelType::MONO_8));
+
+    DecodedImageCache cache(dir / "cache");
+    (void)cache.read_image_file(path_a, 1);
+    auto img = cache.read_image_file(path_b, 1);
+    REQUIRE(cache.stats().hits == 0);
+    REQUIRE(img.pixel_type() == Yimage::PixelType::MONO_8);
+    REQUIRE(find_files(dir / "cache", ".dimg").size() == 2);
+}
+
+TEST_CASE("DecodedImageCache finds images by content, not by path")
+{
+    TemporaryDirectory dir("ViewerTest-decoded-image-cache");
+    auto img = make_test_image(Yimage::PixelType::RGB_8);
+    Yimage::write_png(dir / "a.png", img);
+    std::filesystem::copy_file(dir / "a.png", dir / "copy.png");
+
+    DecodedImageCache cache(dir / "cache");
+    (void)cache.read_image_file(dir / "a.png", 1);
+    auto cached = cache.read_image_file(dir / "copy.png", 1);
+    REQUIRE(cache.stats().hits == 1);
+    REQUIRE(is_same_image(cached, img));
+}
+
+TEST_CASE("DecodedImageCache ignores blobs of other files")
+{
+    TemporaryDirectory dir("ViewerTest-decoded-image-cache");
+    auto path = dir / "image.png";
+    auto old_img = make_test_image(Yimage::PixelType::RGB_8);
+    Yimage::write_png(path, old_img);
+
+    DecodedImageCache cache(dir / "cache");
+    (void)cache.read_image_file(path, 1);
+    auto old_blobs = find_files(dir / "cache", ".dimg");
+    REQUIRE(old_blobs.size() == 1);
+
+    SECTION("The file has changed")
+    {
+        auto new_img = make_test_image(Yimage::PixelType::MONO_8);
+        Yimage::write_png(path, new_img);
+        auto img = cache.read_image_file(path, 1);
+        REQUIRE(cache.stats().hits == 0);
+        REQUIRE(is_same_image(img, new_img));
+    }
+
+    SECTION("The blob has the name of another file's blob")
+    {
+        // The header records the key of the file the blob was made
+        // from, which no longer matches the name.
+        auto new_img = make_test_image(Yimage::PixelType::MONO_8);
+        Yimage::write_png(path, new_img);
+        (void)cache.read_image_file(path, 1);
+        auto blobs = find_files(dir / "cache", ".dimg");
+        REQUIRE(blobs.size() == 2);
+        auto new_blob = blobs[0] == old_blobs[0] ? blobs[1] : blobs[0];
+        std::filesystem::copy_file(old_blobs[0], new_blob,
+                                   std::filesystem::copy_options::overwrite_existing);
+
+        auto img = cache.read_image_file(path, 1);
+        REQUIRE(cache.stats().hits == 0);
+        REQUIRE(is_same_image(img, new_img));
+    }
+}
+
+TEST_CASE("DecodedImageCache replaces corrupt blobs")
+{
+    TemporaryDirectory dir("ViewerTest-decoded-image-cache");
+    auto path = dir / "image.png";
+    auto img = make_test_image(Yimage::PixelType::RGB_8);
+    Yimage::write_png(path, img);
+
+    DecodedImageCache cache(dir / "cache");
+    (void)cache.read_image_file(path, 1);
+    auto blobs = find_files(dir / "cache", ".dimg");
+    REQUIRE(blobs.size() == 1);
+
+    SECTION("The header is corrupt")
+    {
+        std::fstream file(blobs[0], std::ios::in | std::ios::out | std::ios::binary);
+        file.write("JUNK", 4);
+    }
+
+    SECTION("The pixels are truncated")
+    {
+        std::filesystem::resize_file(blobs[0], std::filesystem::file_size(blobs[0]) - 1);
+    }
+
+    auto decoded = cache.read_image_file(path, 1);
+    REQUIRE(cache.stats().hits == 0);
+    REQUIRE(is_same_image(decoded, img));
+
+    // The corrupt blob has been replaced.
+    auto cached = cache.read_image_file(path, 1);
+    REQUIRE(cache.stats().hits == 1);
+    REQUIRE(is_same_image(cached, img));
+}
+
+TEST_CASE("DecodedImageCache removes the temporary file if the blob can't be stored")
+{
+    TemporaryDirectory dir("ViewerTest-decoded-image-cache");
+    auto path = dir / "image.png";
+    auto img = make_test_image(Yimage::PixelType::RGB_8);
+    Yimage::write_png(path, img);
+
+    DecodedImageCache cache(dir / "cache");
+    (void)cache.read_image_file(path, 1);
+    auto blobs = find_files(dir / "cache", ".dimg");
+    REQUIRE(blobs.size() == 1);
+
+    // A non-empty directory with the blob's name makes the rename fail.
+    std::filesystem::remove(blobs[0]);
+    std::filesystem::create_directories(blobs[0] + "/x");
+
+    auto decoded = cache.read_image_file(path, 1);
+    REQUIRE(is_same_image(decoded, img));
+    REQUIRE(!contains_temporary_files(dir / "cache"));
+}
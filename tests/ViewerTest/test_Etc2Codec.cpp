@@ -0,0 +1,270 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <random>
+#include <catch2/catch_test_macros.hpp>
+#include "Etc2Codec.hpp"
+
+namespace
+{
+    constexpr size_t SIZE = 128;
+
+    enum class BlockMode
+    {
+        INDIVIDUAL,
+        DIFFERENTIAL,
+        PLANAR,
+        OTHER
+    };
+
+    constexpr size_t MODE_COUNT = 4;
+
+    // Determines the mode of an ETC2 RGB8 block from the differential bit
+    // and which of the differential color components overflow.
+    BlockMode get_block_mode(const uint8_t* block)
+    {
+        if ((block[3] & 2u) == 0)
+            return BlockMode::INDIVIDUAL;
+
+        for (int c = 0; c < 3; ++c)
+        {
+            auto base = block[c] >> 3;
+            auto delta = block[c] & 7;
+            auto sum = base + (delta >= 4 ? delta - 8 : delta);
+            if (sum < 0 || sum > 31)
+                return c == 2 ? BlockMode::PLANAR : BlockMode::OTHER;
+        }
+        return BlockMode::DIFFERENTIAL;
+    }
+
+    double to_psnr(double squared_error, size_t pixel_count)
+    {
+        if (squared_error == 0)
+            return INFINITY;
+        return 10 * std::log10(255.0 * 255.0 * 3 * double(pixel_count)
+                               / squared_error);
+    }
+
+    struct ModeStats
+    {
+        size_t blocks[MODE_COUNT] = {};
+        double errors[MODE_COUNT] = {};
+
+        [[nodiscard]]
+        size_t count(BlockMode mode) const
+        {
+            return blocks[size_t(mode)];
+        }
+
+        [[nodiscard]]
+        double psnr(BlockMode mode) const
+        {
+            return to_psnr(errors[size_t(mode)], 16 * count(mode));
+        }
+    };
+
+    // Encodes img, which must be RGB_8 with a size that is a multiple of
+    // 4, and returns the number of blocks and the PSNR of each mode.
+    ModeStats encode_and_measure(const Yimage::Image& img)
+    {
+        auto etc2 = encode_etc2(img);
+        auto decoded = decode_etc2(etc2);
+        ModeStats stats;
+        auto blocks_x = img.width() / 4;
+        for (size_t by = 0; by < img.height() / 4; ++by)
+        {
+            for (size_t bx = 0; bx < blocks_x; ++bx)
+            {
+                auto mode = size_t(get_block_mode(&etc2.blocks[(by * blocks_x + bx) * 8]));
+                ++stats.blocks[mode];
+                for (size_t y = by * 4; y < by * 4 + 4; ++y)
+                {
+                    for (size_t i = bx * 12; i < bx * 12 + 12; ++i)
+                    {
+                        auto offset = y * img.row_size() + i;
+                        auto diff = double(img.data()[offset]) - double(decoded.data()[offset]);
+                        stats.errors[mode] += diff * diff;
+                    }
+                }
+            }
+        }
+        return stats;
+    }
+
+    template <typename Func>
+    Yimage::Image make_block_image(Func get_block_color)
+    {
+        std::mt19937 rng(42);
+        Yimage::Image img(Yimage::PixelType::RGB_8, SIZE, SIZE);
+        for (size_t by = 0; by < SIZE / 4; ++by)
+        {
+            for (size_t bx = 0; bx < SIZE / 4; ++bx)
+            {
+                // Every block gets its own random parameters.
+                auto seed = rng();
+                for (size_t y = 0; y < 4; ++y)
+                {
+                    auto row = img.data() + (by * 4 + y) * img.row_size();
+                    for (size_t x = 0; x < 4; ++x)
+                    {
+                        std::mt19937 block_rng(seed);
+                        auto color = get_block_color(int(x), int(y), block_rng);
+                        for (size_t c = 0; c < 3; ++c)
+                            row[(bx * 4 + x) * 3 + c] = uint8_t(std::clamp(color[c], 0, 255));
+                    }
+                }
+            }
+        }
+        return img;
+    }
+
+    using Color = std::array<int, 3>;
+
+    Color get_random_color(std::mt19937& rng, int min, int max)
+    {
+        std::uniform_int_distribution<int> dist(min, max);
+        return {dist(rng), dist(rng), dist(rng)};
+    }
+
+    // A smooth, photograph-like image: sky-like gradients, soft shapes,
+    // hard edges and fine texture.
+    Yimage::Image make_photographic_image()
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> phase_dist(0, 6.28);
+        std::normal_distribution<double> grain(0, 3);
+        double phases[6];
+        for (auto& p: phases)
+            p = phase_dist(rng);
+
+        Yimage::Image img(Yimage::PixelType::RGB_8, SIZE * 2, SIZE * 2);
+        auto size = double(img.width());
+        for (size_t y = 0; y < img.height(); ++y)
+        {
+            auto row = img.data() + y * img.row_size();
+            for (size_t x = 0; x < img.width(); ++x)
+            {
+                auto u = double(x) / size, v = double(y) / size;
+                auto light = 0.5 + 0.3 * std::sin(3 * u + phases[0])
+                                      * std::cos(2 * v + phases[1])
+                             + 0.1 * std::sin(17 * u + 11 * v + phases[2]);
+                // A horizon that separates a blue sky from brown ground.
+                auto horizon = 0.55 + 0.05 * std::sin(9 * u + phases[3]);
+                Color color;
+                if (v < horizon)
+                    color = {int(90 * light + 40), int(140 * light + 50), int(220 * light + 30)};
+                else
+                    color = {int(160 * light + 30), int(120 * light + 20), int(70 * light + 10)};
+                // Foliage-like texture in part of the ground.
+                if (v > horizon && u > 0.6)
+                {
+                    auto leaf = 25 * std::sin(40 * u + phases[4]) * std::sin(37 * v + phases[5]);
+                    color[1] += int(leaf) + 30;
+                }
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    auto value = double(color[c]) + grain(rng);
+                    row[3 * x + c] = uint8_t(std::clamp(int(std::lround(value)), 0, 255));
+                }
+            }
+        }
+        return img;
+    }
+}
+
+TEST_CASE("ETC2 uses individual mode for subblocks with different colors")
+{
+    auto img = make_block_image([](int x, int, std::mt19937& rng)
+    {
+        auto left = get_random_color(rng, 0, 100);
+        auto right = get_random_color(rng, 155, 255);
+        return x < 2 ? left : right;
+    });
+    auto stats = encode_and_measure(img);
+    CAPTURE(stats.count(BlockMode::INDIVIDUAL), stats.count(BlockMode::DIFFERENTIAL),
+            stats.count(BlockMode::PLANAR));
+    REQUIRE(stats.count(BlockMode::INDIVIDUAL) > (SIZE / 4) * (SIZE / 4) * 9 / 10);
+    REQUIRE(stats.count(BlockMode::OTHER) == 0);
+    CHECK(stats.psnr(BlockMode::INDIVIDUAL) >= 34);
+}
+
+TEST_CASE("ETC2 uses differential mode for subblocks with similar colors")
+{
+    auto img = make_block_image([](int x, int y, std::mt19937& rng)
+    {
+        auto base = get_random_color(rng, 20, 235);
+        auto offset = get_random_color(rng, -12, 12);
+        // A checkerboard of two levels that a plane can't approximate.
+        auto level = (x + y) % 2 == 0 ? 10 : -10;
+        return x < 2 ? Color{base[0] + level, base[1] + level, base[2] + level}
+                     : Color{base[0] + offset[0] + level, base[1] + offset[1] + level,
+                             base[2] + offset[2] + level};
+    });
+    auto stats = encode_and_measure(img);
+    CAPTURE(stats.count(BlockMode::INDIVIDUAL), stats.count(BlockMode::DIFFERENTIAL),
+            stats.count(BlockMode::PLANAR));
+    REQUIRE(stats.count(BlockMode::DIFFERENTIAL) > (SIZE / 4) * (SIZE / 4) * 9 / 10);
+    REQUIRE(stats.count(BlockMode::OTHER) == 0);
+    CHECK(stats.psnr(BlockMode::DIFFERENTIAL) >= 34);
+}
+
+TEST_CASE("ETC2 uses planar mode for smooth gradients")
+{
+    auto img = make_block_image([](int x, int y, std::mt19937& rng)
+    {
+        auto origin = get_random_color(rng, 40, 215);
+        auto dx = get_random_color(rng, -10, 10);
+        auto dy = get_random_color(rng, -10, 10);
+        Color result;
+        for (size_t c = 0; c < 3; ++c)
+            result[c] = origin[c] + x * dx[c] + y * dy[c];
+        return result;
+    });
+    auto stats = encode_and_measure(img);
+    CAPTURE(stats.count(BlockMode::INDIVIDUAL), stats.count(BlockMode::DIFFERENTIAL),
+            stats.count(BlockMode::PLANAR));
+    REQUIRE(stats.count(BlockMode::PLANAR) > (SIZE / 4) * (SIZE / 4) * 9 / 10);
+    REQUIRE(stats.count(BlockMode::OTHER) == 0);
+    CHECK(stats.psnr(BlockMode::PLANAR) >= 40);
+}
+
+TEST_CASE("ETC2 keeps the quality of photographic images in every mode")
+{
+    auto img = make_photographic_image();
+    auto stats = encode_and_measure(img);
+    CAPTURE(stats.count(BlockMode::INDIVIDUAL), stats.count(BlockMode::DIFFERENTIAL),
+            stats.count(BlockMode::PLANAR));
+    REQUIRE(stats.count(BlockMode::OTHER) == 0);
+    for (auto mode: {BlockMode::INDIVIDUAL, BlockMode::DIFFERENTIAL, BlockMode::PLANAR})
+    {
+        CAPTURE(int(mode), stats.psnr(mode));
+        REQUIRE(stats.count(mode) != 0);
+        CHECK(stats.psnr(mode) >= 32);
+    }
+    CHECK(calc_psnr(img, decode_etc2(encode_etc2(img))) >= 34);
+}
+
+TEST_CASE("get_etc2_image only calculates the PSNR for cached images")
+{
+    auto img = make_photographic_image();
+    REQUIRE(get_etc2_image(img, "").psnr == 0);
+
+    auto cache_dir = std::filesystem::temp_directory_path() / "ViewerTest-etc2-cache";
+    std::filesystem::remove_all(cache_dir);
+    auto encoded = get_etc2_image(img, cache_dir.string());
+    auto cached = get_etc2_image(img, cache_dir.string());
+    std::filesystem::remove_all(cache_dir);
+
+    auto psnr = calc_psnr(img, decode_etc2(encoded));
+    REQUIRE(encoded.psnr == psnr);
+    REQUIRE(cached.psnr == psnr);
+    REQUIRE(cached.blocks == encoded.blocks);
+}
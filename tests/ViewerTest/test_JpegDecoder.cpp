@@ -0,0 +1,117 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <cstring>
+#include <numeric>
+#include <catch2/catch_test_macros.hpp>
+#include "JpegDecoder.hpp"
+#include "JpegEncoding.hpp"
+
+namespace
+{
+    Yimage::Image decode_sequentially(const std::vector<uint8_t>& jpeg)
+    {
+        JpegStreamDecoder decoder;
+        decoder.add_data(jpeg.data(), jpeg.size());
+        decoder.finish();
+        return decoder.release_image();
+    }
+
+    // Returns the index of the first row that differs, or the height if
+    // the images are identical.
+    size_t find_first_different_row(const Yimage::Image& a,
+                                    const Yimage::Image& b)
+    {
+        for (size_t y = 0; y < a.height(); ++y)
+        {
+            if (memcmp(a.data() + y * a.row_size(), b.data() + y * b.row_size(),
+                       a.row_size()) != 0)
+            {
+                return y;
+            }
+        }
+        return a.height();
+    }
+
+    void require_same_as_sequential(const Yimage::Image& img,
+                                    const JpegOptions& options)
+    {
+        auto jpeg = encode_jpeg(img, options);
+        auto expected = decode_sequentially(jpeg);
+        auto result = read_jpeg_parallel(jpeg.data(), jpeg.size(), 4);
+        REQUIRE(result.width() == expected.width());
+        REQUIRE(result.height() == expected.height());
+        REQUIRE(result.pixel_type() == expected.pixel_type());
+        REQUIRE(find_first_different_row(result, expected) == expected.height());
+    }
+}
+
+TEST_CASE("Parallel JPEG decoding matches a sequential decode")
+{
+    // Odd sizes make the last MCU row and column partial.
+    auto img = make_colorful_image(1001, 499);
+
+    SECTION("4:2:0 with a restart marker every MCU row")
+    {
+        require_same_as_sequential(img, {.restart_rows = 1});
+    }
+
+    SECTION("4:2:0 with a restart marker every third MCU row")
+    {
+        require_same_as_sequential(img, {.restart_rows = 3});
+    }
+
+    SECTION("4:2:0 with restart intervals that rarely start an MCU row")
+    {
+        // An MCU row is 63 MCUs wide, every seventh interval starts one.
+        require_same_as_sequential(img, {.restart_rows = 0, .restart_mcus = 9});
+    }
+
+    SECTION("4:2:2")
+    {
+        require_same_as_sequential(img, {.v_sampling = 1});
+    }
+
+    SECTION("4:4:4")
+    {
+        require_same_as_sequential(img, {.h_sampling = 1, .v_sampling = 1});
+    }
+
+    SECTION("Grayscale")
+    {
+        Yimage::Image mono(Yimage::PixelType::MONO_8, img.width(), img.height());
+        for (size_t y = 0; y < img.height(); ++y)
+        {
+            for (size_t x = 0; x < img.width(); ++x)
+                mono.data()[y * mono.row_size() + x] = img.data()[y * img.row_size() + 3 * x];
+        }
+        require_same_as_sequential(mono, {});
+    }
+}
+
+TEST_CASE("Stripes decoded in any order match a sequential decode")
+{
+    auto jpeg = encode_jpeg(make_colorful_image(640, 480));
+    auto expected = decode_sequentially(jpeg);
+
+    JpegStripeDecoder decoder(jpeg.data(), jpeg.size(), 8);
+    REQUIRE(decoder.stripe_count() == 8);
+    auto img = decoder.make_image();
+    // Every other stripe first, as when the visible part of an image is
+    // decoded before the rest.
+    decoder.decode_stripes({1, 3, 5, 7}, img, 2);
+    decoder.decode_stripes({6, 4, 2, 0}, img, 1);
+    REQUIRE(find_first_different_row(img, expected) == expected.height());
+}
+
+TEST_CASE("JPEGs without restart markers can't be decoded in parallel")
+{
+    auto jpeg = encode_jpeg(make_colorful_image(256, 128), {.restart_rows = 0});
+    JpegStripeDecoder decoder(jpeg.data(), jpeg.size(), 4);
+    REQUIRE(decoder.stripe_count() == 0);
+    REQUIRE(!read_jpeg_parallel(jpeg.data(), jpeg.size(), 4));
+}
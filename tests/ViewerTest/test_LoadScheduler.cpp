@@ -0,0 +1,160 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <algorithm>
+#include <cmath>
+#include <catch2/catch_test_macros.hpp>
+#include "LoadScheduler.hpp"
+#include "SpherePosCalculator.hpp"
+
+namespace
+{
+    constexpr auto PI = Xyz::Constants<double>::PI;
+    constexpr size_t IMAGE_HEIGHT = 1000;
+    // The last band is shorter than the others, as in JPEG images whose
+    // height isn't a multiple of the band height.
+    constexpr size_t BAND_ROWS = 64;
+    const Xyz::Vector2D SCREEN_RES(800, 600);
+    // The number of points sampled along each axis of the screen.
+    constexpr int SCREEN_SAMPLES = 101;
+
+    std::vector<RowRange> make_bands()
+    {
+        std::vector<RowRange> result;
+        for (size_t row = 0; row < IMAGE_HEIGHT; row += BAND_ROWS)
+            result.push_back({row, std::min(BAND_ROWS, IMAGE_HEIGHT - row)});
+        return result;
+    }
+
+    double get_row_polar(size_t y)
+    {
+        return PI / 2 - PI * double(y) / double(IMAGE_HEIGHT);
+    }
+
+    // The range of polar angles that is visible on the screen, found by
+    // sampling the whole screen rather than just its edges.
+    std::pair<double, double> sample_polar_range(double view_angle,
+                                                 double azimuth, double polar)
+    {
+        SpherePosCalculator calculator;
+        calculator.set_screen_res(SCREEN_RES);
+        calculator.set_eye_dist(0.5);
+        calculator.set_view_angle(view_angle);
+        calculator.set_fixed_point({0, 0}, {1, azimuth, polar});
+
+        std::pair result(polar, polar);
+        for (int i = 0; i < SCREEN_SAMPLES; ++i)
+        {
+            auto x = 2.0 * i / (SCREEN_SAMPLES - 1) - 1;
+            for (int j = 0; j < SCREEN_SAMPLES; ++j)
+            {
+                auto y = 2.0 * j / (SCREEN_SAMPLES - 1) - 1;
+                auto p = calculator.calc_sphere_pos({x, y});
+                result.first = std::min(result.first, p.polar);
+                result.second = std::max(result.second, p.polar);
+            }
+        }
+        return result;
+    }
+
+    // Checks the region against the sampled polar range, and that the
+    // load order has every band once with those that overlap the region
+    // first. Returns the region.
+    ViewRegion check_view(double view_angle, double azimuth, double polar)
+    {
+        CAPTURE(view_angle, azimuth, polar);
+        auto region = calc_view_region(SCREEN_RES, view_angle, azimuth, polar);
+        auto [min_polar, max_polar] = sample_polar_range(view_angle, azimuth,
+                                                         polar);
+        CAPTURE(region.min_polar, region.max_polar, min_polar, max_polar);
+        REQUIRE(region.center_polar == polar);
+        REQUIRE(region.min_polar <= min_polar + 1e-3);
+        REQUIRE(region.max_polar >= max_polar - 1e-3);
+        REQUIRE(region.min_polar > min_polar - 0.05);
+        REQUIRE(region.max_polar < max_polar + 0.05);
+
+        auto bands = make_bands();
+        auto order = make_load_order(region, bands, IMAGE_HEIGHT);
+        REQUIRE(order.bands.size() == bands.size());
+        auto sorted = order.bands;
+        std::sort(sorted.begin(), sorted.end());
+        for (size_t i = 0; i < sorted.size(); ++i)
+            REQUIRE(sorted[i] == i);
+
+        REQUIRE(order.visible_count > 0);
+        double prev_distance = 0;
+        for (size_t i = 0; i < order.bands.size(); ++i)
+        {
+            const auto& band = bands[order.bands[i]];
+            auto top = get_row_polar(band.first_row);
+            auto bottom = get_row_polar(band.first_row + band.row_count);
+            CAPTURE(i, order.bands[i], top, bottom);
+            bool is_visible = bottom <= max_polar && top >= min_polar;
+            if (i < order.visible_count)
+            {
+                REQUIRE(bottom <= region.max_polar);
+                REQUIRE(top >= region.min_polar);
+                continue;
+            }
+            REQUIRE(!is_visible);
+            // The hidden bands follow in order of their distance from
+            // the center.
+            auto distance = std::max(bottom - polar, polar - top);
+            REQUIRE(distance >= prev_distance);
+            prev_distance = distance;
+        }
+        return region;
+    }
+}
+
+TEST_CASE("Load order for a view at the equator")
+{
+    auto region = check_view(PI / 2, 0.3, 0);
+    REQUIRE(region.min_polar < 0);
+    REQUIRE(region.max_polar > 0);
+    REQUIRE(region.max_polar < PI / 2);
+    REQUIRE(region.min_polar > -PI / 2);
+
+    auto order = make_load_order(region, make_bands(), IMAGE_HEIGHT);
+    REQUIRE(order.visible_count < order.bands.size());
+}
+
+TEST_CASE("Load order for a view over the azimuth seam")
+{
+    // The polar range doesn't depend on the azimuth, also when the view
+    // spans the seam where the azimuth wraps around.
+    auto expected = calc_view_region(SCREEN_RES, PI / 2, 0, 0.4);
+    for (double azimuth: {PI, PI - 0.01, -PI + 0.01, 3 * PI / 2, -PI / 2})
+    {
+        CAPTURE(azimuth);
+        auto region = check_view(PI / 2, azimuth, 0.4);
+        REQUIRE(std::abs(region.min_polar - expected.min_polar) < 1e-9);
+        REQUIRE(std::abs(region.max_polar - expected.max_polar) < 1e-9);
+    }
+}
+
+TEST_CASE("Load order for a view that includes a pole")
+{
+    auto bands = make_bands();
+    SECTION("North pole")
+    {
+        auto region = check_view(PI / 2, 1.0, PI / 2 - 0.2);
+        REQUIRE(region.max_polar == PI / 2);
+        auto order = make_load_order(region, bands, IMAGE_HEIGHT);
+        auto visible_end = order.bands.begin() + ptrdiff_t(order.visible_count);
+        REQUIRE(std::find(order.bands.begin(), visible_end, 0) != visible_end);
+    }
+    SECTION("South pole")
+    {
+        auto region = check_view(PI / 2, -2.0, -PI / 2 + 0.2);
+        REQUIRE(region.min_polar == -PI / 2);
+        auto order = make_load_order(region, bands, IMAGE_HEIGHT);
+        auto visible_end = order.bands.begin() + ptrdiff_t(order.visible_count);
+        REQUIRE(std::find(order.bands.begin(), visible_end, bands.size() - 1)
+                != visible_end);
+    }
+}
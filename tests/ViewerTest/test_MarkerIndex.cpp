@@ -0,0 +1,172 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <catch2/catch_test_macros.hpp>
+#include "MarkerIndex.hpp"
+
+namespace
+{
+    constexpr size_t RANDOM_MARKERS = 20000;
+    constexpr size_t MARKERS_PER_EDGE_POINT = 200;
+    constexpr size_t RANDOM_QUERIES = 1000;
+    constexpr size_t QUERIES_PER_EDGE_POINT = 20;
+
+    Xyz::Vector3D get_random_direction(std::mt19937& rng)
+    {
+        std::normal_distribution<double> dist;
+        return Xyz::get_unit(Xyz::Vector3D(dist(rng), dist(rng), dist(rng)));
+    }
+
+    // Points on the edges between the cube faces and on their corners,
+    // where the neighbors of a cell are on another face.
+    std::vector<Xyz::Vector3D> get_edge_points()
+    {
+        std::vector<Xyz::Vector3D> result;
+        for (double x: {-1.0, 1.0})
+        {
+            for (double y: {-1.0, 1.0})
+            {
+                result.push_back(Xyz::get_unit(Xyz::Vector3D(x, y, 0.3)));
+                result.push_back(Xyz::get_unit(Xyz::Vector3D(x, -0.6, y)));
+                result.push_back(Xyz::get_unit(Xyz::Vector3D(0, x, y)));
+                for (double z: {-1.0, 1.0})
+                    result.push_back(Xyz::get_unit(Xyz::Vector3D(x, y, z)));
+            }
+        }
+        return result;
+    }
+
+    // Returns a direction at a small random angle from dir.
+    Xyz::Vector3D get_nearby_direction(const Xyz::Vector3D& dir,
+                                       double spread, std::mt19937& rng)
+    {
+        std::normal_distribution<double> dist(0, spread);
+        return Xyz::get_unit(dir + Xyz::Vector3D(dist(rng), dist(rng), dist(rng)));
+    }
+
+    std::vector<Xyz::Vector3F> make_markers(std::mt19937& rng)
+    {
+        std::vector<Xyz::Vector3F> result;
+        for (size_t i = 0; i < RANDOM_MARKERS; ++i)
+            result.push_back(Xyz::vector_cast<float>(get_random_direction(rng)));
+        for (const auto& point: get_edge_points())
+        {
+            for (size_t i = 0; i < MARKERS_PER_EDGE_POINT; ++i)
+            {
+                auto dir = get_nearby_direction(point, 0.02, rng);
+                result.push_back(Xyz::vector_cast<float>(dir));
+            }
+        }
+        return result;
+    }
+
+    std::vector<Xyz::Vector3D> make_queries(std::mt19937& rng)
+    {
+        std::vector<Xyz::Vector3D> result;
+        for (size_t i = 0; i < RANDOM_QUERIES; ++i)
+            result.push_back(get_random_direction(rng));
+        for (const auto& point: get_edge_points())
+        {
+            result.push_back(point);
+            for (size_t i = 0; i < QUERIES_PER_EDGE_POINT; ++i)
+                result.push_back(get_nearby_direction(point, 0.01, rng));
+        }
+        return result;
+    }
+
+    // The dot product of direction and the nearest position that is
+    // within max_angle of it, found the same way as find_nearest, but
+    // by checking every position.
+    std::optional<float> find_nearest_dot(const MarkerIndex& index,
+                                          const Xyz::Vector3D& direction,
+                                          double max_angle)
+    {
+        auto dir = Xyz::vector_cast<float>(Xyz::get_unit(direction));
+        auto min_dot = float(std::cos(max_angle));
+        std::optional<float> result;
+        for (const auto& pos: index.positions())
+        {
+            auto d = Xyz::dot(dir, pos);
+            if (d >= min_dot && (!result || d > *result))
+                result = d;
+        }
+        return result;
+    }
+
+    bool is_in_ranges(size_t i, const std::vector<MarkerIndex::Range>& ranges)
+    {
+        return std::any_of(ranges.begin(), ranges.end(), [&](auto& r)
+        {
+            return r.first <= i && i < r.second;
+        });
+    }
+}
+
+TEST_CASE("MarkerIndex::find_nearest matches a linear scan")
+{
+    std::mt19937 rng(42);
+    MarkerIndex index(make_markers(rng));
+    auto queries = make_queries(rng);
+    std::vector<MarkerIndex::Range> ranges;
+    for (double max_angle: {0.005, 0.02, 0.2})
+    {
+        size_t found = 0;
+        for (const auto& query: queries)
+        {
+            CAPTURE(max_angle, query[0], query[1], query[2]);
+            auto expected = find_nearest_dot(index, query, max_angle);
+            auto result = index.find_nearest(query, max_angle, ranges);
+            REQUIRE(result.has_value() == expected.has_value());
+            if (!result)
+                continue;
+            auto dir = Xyz::vector_cast<float>(Xyz::get_unit(query));
+            // Several positions can be equally close.
+            REQUIRE(Xyz::dot(dir, index.positions()[*result]) == *expected);
+            ++found;
+        }
+        // Make sure the test doesn't pass only because nothing is found.
+        CAPTURE(max_angle);
+        REQUIRE(found > queries.size() / 10);
+    }
+}
+
+TEST_CASE("MarkerIndex::find_ranges includes every position within the angle")
+{
+    std::mt19937 rng(7);
+    MarkerIndex index(make_markers(rng));
+    std::vector<MarkerIndex::Range> ranges;
+    for (const auto& query: make_queries(rng))
+    {
+        CAPTURE(query[0], query[1], query[2]);
+        constexpr double ANGLE = 0.1;
+        index.find_ranges(query, ANGLE, ranges);
+        auto dir = Xyz::vector_cast<float>(query);
+        auto min_dot = float(std::cos(ANGLE));
+        const auto& positions = index.positions();
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            if (Xyz::dot(dir, positions[i]) >= min_dot)
+                REQUIRE(is_in_ranges(i, ranges));
+        }
+    }
+}
+
+TEST_CASE("MarkerIndex::ids maps positions to the original directions")
+{
+    std::mt19937 rng(3);
+    auto markers = make_markers(rng);
+    MarkerIndex index(markers);
+    REQUIRE(index.size() == markers.size());
+    for (size_t i = 0; i < index.size(); ++i)
+    {
+        auto expected = Xyz::get_unit(markers[index.ids()[i]]);
+        REQUIRE(Xyz::get_length(index.positions()[i] - expected) < 1e-6f);
+    }
+}
@@ -0,0 +1,112 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <cmath>
+#include <random>
+#include <catch2/catch_test_macros.hpp>
+#include "PixelKernels.hpp"
+
+namespace
+{
+    // The sizes are chosen so that every backend also has to handle a
+    // tail that doesn't fill a whole vector.
+    constexpr size_t TEST_SIZES[] = {0, 1, 5, 15, 16, 17, 31, 64, 1001};
+
+    std::vector<uint8_t> make_random_bytes(size_t count, std::mt19937& rng)
+    {
+        std::vector<uint8_t> result(count);
+        for (auto& b: result)
+            b = uint8_t(rng());
+        return result;
+    }
+
+    std::vector<float> make_random_floats(size_t count, std::mt19937& rng)
+    {
+        // Include values outside [0, 255] to test the clamping.
+        std::uniform_real_distribution<float> dist(-20.0f, 275.0f);
+        std::vector<float> result(count);
+        for (auto& f: result)
+            f = dist(rng);
+        return result;
+    }
+
+    // Covers the whole range of half floats and beyond, including
+    // subnormals, values that round to infinity, and infinity itself.
+    std::vector<float> make_random_half_range_floats(size_t count,
+                                                     std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> mantissa_dist(-1.0f, 1.0f);
+        std::uniform_int_distribution<int> exponent_dist(-27, 18);
+        std::vector<float> result(count);
+        for (auto& f: result)
+            f = std::ldexp(mantissa_dist(rng), exponent_dist(rng));
+        const float specials[] = {0.0f, -0.0f, 65504.0f, 65519.0f, 65520.0f,
+                                  6.1035156e-5f, -5.9604645e-8f, INFINITY};
+        for (size_t i = 0; i < count && i < std::size(specials); ++i)
+            result[i * 7 % count] = specials[i];
+        return result;
+    }
+}
+
+TEST_CASE("Every pixel kernel backend gives the same results as the scalar one")
+{
+    std::mt19937 rng(1234);
+    auto backends = get_available_pixel_kernels();
+    REQUIRE(std::string(backends.front()->name) == "scalar");
+    const auto& ref = *backends.front();
+    for (auto backend: backends)
+    {
+        const auto& kernels = *backend;
+        for (auto size: TEST_SIZES)
+        {
+            CAPTURE(kernels.name, size);
+            auto bytes = make_random_bytes(size * 4, rng);
+            auto floats = make_random_floats(size, rng);
+
+            std::vector<float> f1(size), f2(size);
+            ref.u8_to_f32(bytes.data(), f1.data(), size);
+            kernels.u8_to_f32(bytes.data(), f2.data(), size);
+            REQUIRE(f1 == f2);
+
+            std::vector<uint8_t> b1(size), b2(size);
+            ref.f32_to_u8(floats.data(), b1.data(), size);
+            kernels.f32_to_u8(floats.data(), b2.data(), size);
+            REQUIRE(b1 == b2);
+
+            f2 = f1;
+            ref.multiply_add(floats.data(), 0.3f, f1.data(), size);
+            kernels.multiply_add(floats.data(), 0.3f, f2.data(), size);
+            REQUIRE(f1 == f2);
+
+            std::vector<uint8_t> rgba1(size * 4), rgba2(size * 4);
+            ref.rgb_to_rgba(bytes.data(), rgba1.data(), size);
+            kernels.rgb_to_rgba(bytes.data(), rgba2.data(), size);
+            REQUIRE(rgba1 == rgba2);
+
+            std::vector<uint8_t> rgb1(size * 3), rgb2(size * 3);
+            ref.rgba_to_rgb(bytes.data(), rgb1.data(), size);
+            kernels.rgba_to_rgb(bytes.data(), rgb2.data(), size);
+            REQUIRE(rgb1 == rgb2);
+
+            ref.mono_to_rgb(bytes.data(), rgb1.data(), size);
+            kernels.mono_to_rgb(bytes.data(), rgb2.data(), size);
+            REQUIRE(rgb1 == rgb2);
+
+            auto half_range = make_random_half_range_floats(size, rng);
+            std::vector<uint16_t> h1(size), h2(size);
+            ref.f32_to_f16(half_range.data(), h1.data(), size);
+            kernels.f32_to_f16(half_range.data(), h2.data(), size);
+            REQUIRE(h1 == h2);
+        }
+    }
+}
+
+TEST_CASE("get_pixel_kernels selects the last available backend")
+{
+    auto backends = get_available_pixel_kernels();
+    REQUIRE(&get_pixel_kernels() == backends.back());
+}
@@ -0,0 +1,163 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include "QualityGovernor.hpp"
+
+namespace
+{
+    using namespace std::chrono_literals;
+    using Clock = QualityGovernor::Clock;
+
+    // The target is 50 fps, 20 ms per frame.
+    constexpr double TARGET_FPS = 50;
+    // Clearly above the target, and clearly below it.
+    constexpr auto SLOW_DRAW = 30ms;
+    constexpr auto FAST_DRAW = 5ms;
+    // The frames arrive at a rate that has nothing to do with the time
+    // it takes to draw them, as when they follow mouse events.
+    constexpr auto FRAME_INTERVAL = 40ms;
+    constexpr size_t WINDOW_FRAMES = 20;
+
+    // Feeds frames to a governor with a simulated clock.
+    class FrameFeeder
+    {
+    public:
+        explicit FrameFeeder(size_t level)
+            : governor(TARGET_FPS, level)
+        {}
+
+        // Adds frames until the governor changes the level or the
+        // time limit is reached, and returns the change.
+        std::optional<QualityChange> add_frames(Clock::duration draw_time,
+                                                Clock::duration limit)
+        {
+            auto end = time + limit;
+            while (time < end)
+            {
+                time += FRAME_INTERVAL;
+                if (auto change = governor.add_frame(time, draw_time))
+                    return change;
+            }
+            return {};
+        }
+
+        // Adds fast frames until the governor raises the level, and
+        // returns the time it took.
+        Clock::duration time_until_raise()
+        {
+            auto start = time;
+            auto change = add_frames(FAST_DRAW, 200s);
+            REQUIRE(change);
+            REQUIRE(change->new_level + 1 == change->old_level);
+            return time - start;
+        }
+
+        QualityGovernor governor;
+        // A time point of 0 means that there is no previous frame.
+        Clock::time_point time = Clock::time_point(1h);
+    };
+}
+
+TEST_CASE("QualityGovernor lowers the quality one level when drawing is slow")
+{
+    FrameFeeder feeder(1);
+    // The first frame only starts the window.
+    for (size_t i = 0; i < WINDOW_FRAMES; ++i)
+    {
+        feeder.time += FRAME_INTERVAL;
+        REQUIRE(!feeder.governor.add_frame(feeder.time, SLOW_DRAW));
+    }
+    feeder.time += FRAME_INTERVAL;
+    auto change = feeder.governor.add_frame(feeder.time, SLOW_DRAW);
+    REQUIRE(change);
+    REQUIRE(change->old_level == 1);
+    REQUIRE(change->new_level == 2);
+    REQUIRE(change->draw_ms == 30);
+    REQUIRE(feeder.governor.level() == 2);
+}
+
+TEST_CASE("QualityGovernor ignores the interval between frames")
+{
+    FrameFeeder feeder(1);
+    // Frames every 40 ms are far below the target of 50 fps, but each
+    // one only takes 5 ms to draw.
+    auto change = feeder.add_frames(FAST_DRAW, 1s);
+    REQUIRE(!change);
+    REQUIRE(feeder.governor.level() == 1);
+}
+
+TEST_CASE("QualityGovernor raises the quality only after the raise delay")
+{
+    FrameFeeder feeder(3);
+    auto duration = feeder.time_until_raise();
+    REQUIRE(duration >= 2s);
+    // The level is evaluated once per window.
+    REQUIRE(duration < 2s + WINDOW_FRAMES * FRAME_INTERVAL + FRAME_INTERVAL);
+    REQUIRE(feeder.governor.level() == 2);
+}
+
+TEST_CASE("QualityGovernor doubles the raise delay when a raise fails")
+{
+    FrameFeeder feeder(3);
+    auto expected_delay = Clock::duration(2s);
+    REQUIRE(feeder.time_until_raise() >= expected_delay);
+    for (int i = 0; i < 7; ++i)
+    {
+        // Drawing at the raised level is too slow, and the level is
+        // lowered again within 3 seconds.
+        auto change = feeder.add_frames(SLOW_DRAW, 3s);
+        REQUIRE(change);
+        REQUIRE(change->new_level == 3);
+
+        expected_delay = std::min<Clock::duration>(expected_delay * 2, 64s);
+        auto duration = feeder.time_until_raise();
+        CAPTURE(i, duration.count(), expected_delay.count());
+        REQUIRE(duration >= expected_delay);
+        REQUIRE(duration < expected_delay + 1s);
+    }
+
+    SECTION("A raise that holds for 3 seconds resets the delay")
+    {
+        // With the delay back at 2 seconds, the time already spent at
+        // the target is enough for another raise.
+        auto change = feeder.add_frames(FAST_DRAW, 4s);
+        REQUIRE(change);
+        REQUIRE(change->new_level == 1);
+
+        change = feeder.add_frames(SLOW_DRAW, 3s);
+        REQUIRE(change);
+        REQUIRE(change->new_level == 2);
+        auto duration = feeder.time_until_raise();
+        REQUIRE(duration >= 4s);
+        REQUIRE(duration < 5s);
+    }
+}
+
+TEST_CASE("QualityGovernor starts a new window after an idle gap")
+{
+    FrameFeeder feeder(1);
+    for (size_t i = 0; i < WINDOW_FRAMES / 2; ++i)
+    {
+        feeder.time += FRAME_INTERVAL;
+        REQUIRE(!feeder.governor.add_frame(feeder.time, SLOW_DRAW));
+    }
+
+    // The frame after the gap isn't counted, and the slow frames before
+    // it are forgotten.
+    feeder.time += 250ms;
+    REQUIRE(!feeder.governor.add_frame(feeder.time, SLOW_DRAW));
+    for (size_t i = 0; i < WINDOW_FRAMES - 1; ++i)
+    {
+        feeder.time += FRAME_INTERVAL;
+        REQUIRE(!feeder.governor.add_frame(feeder.time, SLOW_DRAW));
+    }
+    feeder.time += FRAME_INTERVAL;
+    REQUIRE(feeder.governor.add_frame(feeder.time, SLOW_DRAW));
+    REQUIRE(feeder.governor.level() == 2);
+}
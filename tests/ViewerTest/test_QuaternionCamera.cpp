@@ -0,0 +1,112 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <catch2/catch_test_macros.hpp>
+#include "DragPaths.hpp"
+#include "QuaternionCamera.hpp"
+
+namespace
+{
+    constexpr auto PI = Xyz::Constants<double>::PI;
+
+    void require_orthonormal(QuaternionCamera& camera)
+    {
+        auto center = camera.calc_center_pos();
+        auto up = camera.calc_up_vector();
+        REQUIRE(std::abs(get_norm(camera.orientation()) - 1) < 1e-12);
+        REQUIRE(std::abs(get_length(center) - 1) < 1e-9);
+        REQUIRE(std::abs(get_length(up) - 1) < 1e-9);
+        REQUIRE(std::abs(dot(center, up)) < 1e-9);
+    }
+}
+
+TEST_CASE("QuaternionCamera can look straight at the poles")
+{
+    QuaternionCamera camera;
+    setup_camera(camera);
+    for (double polar: {PI / 2, -PI / 2})
+    {
+        for (double azimuth: {-PI, -1.0, 0.0, 2.0})
+        {
+            CAPTURE(polar, azimuth);
+            camera.set_direction(azimuth, polar);
+            require_orthonormal(camera);
+            auto center = camera.calc_center_pos();
+            REQUIRE(std::abs(center[2] - std::sin(polar)) < 1e-12);
+            // The up vector points away from the azimuth, just as it
+            // would if the camera had tilted up or down to the pole.
+            auto up = camera.calc_up_vector();
+            auto expected = Xyz::to_cartesian(
+                Xyz::SphericalPointD(1.0, azimuth, polar + PI / 2));
+            REQUIRE(get_vector_angle(up, expected) < 1e-9);
+        }
+    }
+}
+
+TEST_CASE("QuaternionCamera keeps the grabbed point under the cursor across the poles")
+{
+    QuaternionCamera camera;
+    setup_camera(camera);
+    std::mt19937 rng(1234);
+    auto paths = make_drag_paths(2000, Xyz::to_radians(80.0), PI / 2, rng);
+    Camera::Clock::time_point time;
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        CAPTURE(i);
+        const auto& path = paths[i];
+        // Only reset the direction now and then to let rounding
+        // errors accumulate in the orientation.
+        if (i % 10 == 0)
+            camera.set_direction(path.azimuth, path.polar);
+        auto grabbed = Xyz::to_cartesian(camera.calc_sphere_pos(path.from));
+        camera.begin_drag(path.from, time);
+        double max_drift = 0;
+        for (size_t j = 1; j <= EVENTS_PER_DRAG; ++j)
+        {
+            time += EVENT_INTERVAL;
+            auto cursor = get_cursor_pos(path, j);
+            camera.drag(cursor, time);
+            auto pos = Xyz::to_cartesian(camera.calc_sphere_pos(cursor));
+            max_drift = std::max(max_drift, get_vector_angle(pos, grabbed));
+        }
+        REQUIRE(max_drift < 1e-9);
+        require_orthonormal(camera);
+        camera.end_drag(time);
+    }
+}
+
+TEST_CASE("QuaternionCamera's inertia motion over a pole stops where it should")
+{
+    QuaternionCamera camera;
+    setup_camera(camera);
+    // A fast vertical drag over the north pole.
+    camera.set_direction(0.5, Xyz::to_radians(75.0));
+    Camera::Clock::time_point time;
+    camera.begin_drag({0, -0.8}, time);
+    for (size_t i = 1; i <= 10; ++i)
+    {
+        time += EVENT_INTERVAL;
+        camera.drag({0, -0.8 + 0.16 * double(i)}, time);
+    }
+    REQUIRE(camera.end_drag(time));
+
+    auto origin = camera.orientation();
+    double prev_angle = 0;
+    while (camera.update_motion(time += EVENT_INTERVAL))
+    {
+        require_orthonormal(camera);
+        // The motion never turns back.
+        auto angle = get_angle(camera.orientation() * get_conjugate(origin));
+        REQUIRE(angle >= prev_angle - 1e-12);
+        prev_angle = angle;
+    }
+    require_orthonormal(camera);
+    auto max_angle = MAX_SPEED * get_inertia_factor(
+        MAX_SPEED, get_inertia_duration(MAX_SPEED));
+    REQUIRE(prev_angle > 0);
+    REQUIRE(prev_angle <= max_angle + 1e-9);
+}
@@ -0,0 +1,219 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <catch2/catch_test_macros.hpp>
+#include "DirectionImage.hpp"
+#include "Reprojection.hpp"
+
+namespace
+{
+    constexpr auto PI = Xyz::Constants<double>::PI;
+    // The colors of the test image change by at most 100 per radian,
+    // and bilinear sampling of such an image is nearly exact.
+    constexpr int MAX_REFERENCE_DIFF = 3;
+    constexpr size_t REFERENCE_POINTS = 2000;
+
+    struct TestView
+    {
+        ProjectionType type;
+        ProjectionView view;
+        size_t width;
+        size_t height;
+    };
+
+    const TestView TEST_VIEWS[] = {
+        {ProjectionType::PERSPECTIVE, {0.5, 0.3, PI / 2}, 384, 256},
+        {ProjectionType::PERSPECTIVE, {-2.0, -1.2, 1.2}, 256, 384},
+        {ProjectionType::FISHEYE, {1.0, 0.4, 2 * PI}, 384, 384},
+        {ProjectionType::FISHEYE, {0, 0, PI}, 384, 256},
+        {ProjectionType::STEREOGRAPHIC, {0, -PI / 2, 5 * PI / 3}, 384, 384},
+        {ProjectionType::STEREOGRAPHIC, {2.5, 0.5, PI}, 384, 256},
+        {ProjectionType::MERCATOR, {0, 0, 2 * PI}, 512, 256},
+        {ProjectionType::MERCATOR, {1.0, 0.5, PI}, 256, 384},
+        {ProjectionType::CYLINDRICAL, {0, 0, 2 * PI}, 512, 256},
+        {ProjectionType::CYLINDRICAL, {-1.5, -0.6, PI / 2}, 256, 384}
+    };
+
+    // Returns the screen position where the projection shows dir, using
+    // the forward formulas rather than the ones in Projections.hpp.
+    std::optional<Xyz::Vector2D> project(const TestView& tv,
+                                         const Xyz::Vector3D& dir)
+    {
+        const auto& view = tv.view;
+        auto vectors = calc_view_vectors({1.0, view.azimuth, view.polar});
+        auto f = dot(dir, vectors.forward);
+        auto r = dot(dir, vectors.right);
+        auto u = dot(dir, vectors.up);
+        auto aspect = get_aspect_factors(tv.width, tv.height);
+        auto side = std::hypot(r, u);
+        // The distance from the center of the image, with the longer
+        // side's edges at 1, in the direction (r, u).
+        auto to_screen = [&](double distance)
+        {
+            if (side == 0)
+                return Xyz::Vector2D(0, 0);
+            return Xyz::Vector2D(distance * r / side / aspect[0],
+                                 distance * u / side / aspect[1]);
+        };
+
+        switch (tv.type)
+        {
+        case ProjectionType::PERSPECTIVE:
+        {
+            // The screen is in the plane through the sphere's center.
+            constexpr auto EYE_DIST = PerspectiveProjection::EYE_DIST;
+            if (f <= -EYE_DIST / 2)
+                return {};
+            auto t = EYE_DIST / (f + EYE_DIST);
+            auto factors = calc_screen_factors({double(tv.width), double(tv.height)},
+                                               view.view_angle, EYE_DIST);
+            return Xyz::Vector2D(t * r / factors[0], t * u / factors[1]);
+        }
+        case ProjectionType::FISHEYE:
+        {
+            // Stay away from the edge of the circle.
+            auto angle = std::atan2(side, f);
+            if (angle > 0.97 * PI)
+                return {};
+            return to_screen(angle / (view.view_angle / 2));
+        }
+        case ProjectionType::STEREOGRAPHIC:
+        {
+            auto angle = std::atan2(side, f);
+            if (angle > 0.97 * PI)
+                return {};
+            return to_screen(std::tan(angle / 2) / std::tan(view.view_angle / 4));
+        }
+        case ProjectionType::MERCATOR:
+        case ProjectionType::CYLINDRICAL:
+        {
+            auto pos = to_spherical(dir);
+            auto azimuth = std::remainder(view.azimuth - pos.azimuth, 2 * PI);
+            auto half_angle = view.view_angle / 2;
+            auto y = tv.type == ProjectionType::MERCATOR
+                         ? std::asinh(std::tan(pos.polar))
+                           - std::asinh(std::tan(view.polar))
+                         : std::tan(pos.polar) - std::tan(view.polar);
+            return Xyz::Vector2D(azimuth / half_angle,
+                                 y / (half_angle * double(tv.height) / double(tv.width)));
+        }
+        }
+        return {};
+    }
+
+    std::string get_description(const TestView& tv)
+    {
+        std::ostringstream ss;
+        ss << get_projection_name(tv.type) << " " << std::fixed
+           << std::setprecision(2) << tv.view.azimuth << ", "
+           << tv.view.polar << ", " << tv.view.view_angle
+           << " " << tv.width << "x" << tv.height;
+        return ss.str();
+    }
+
+    // Returns the largest difference between the colors in img and the
+    // colors of the directions that were projected onto it, and the
+    // number of directions that were checked.
+    std::pair<int, size_t> compare_with_reference(const Yimage::Image& img,
+                                                  const TestView& tv)
+    {
+        std::mt19937 rng(42);
+        std::normal_distribution<double> dist;
+        int max_diff = 0;
+        size_t count = 0;
+        auto width = double(tv.width), height = double(tv.height);
+        for (size_t i = 0; i < REFERENCE_POINTS; ++i)
+        {
+            Xyz::Vector3D dir(dist(rng), dist(rng), dist(rng));
+            dir = dir / get_length(dir);
+            auto screen_pos = project(tv, dir);
+            if (!screen_pos)
+                continue;
+
+            // Skip the outermost pixels, their neighbors can be outside
+            // the image or on the other side of a seam.
+            auto x = ((*screen_pos)[0] + 1) / 2 * width;
+            auto y = (1 - (*screen_pos)[1]) / 2 * height;
+            if (x < 1 || x > width - 1 || y < 1 || y > height - 1)
+                continue;
+
+            unsigned char rgb[3];
+            sample_panorama(img, 3, {x / width, y / height}, rgb);
+            for (size_t c = 0; c < 3; ++c)
+            {
+                max_diff = std::max(max_diff, std::abs(int(rgb[c])
+                                                       - int(get_direction_color(dir[c]))));
+            }
+            ++count;
+        }
+        return {max_diff, count};
+    }
+}
+
+TEST_CASE("Every projection type is in ALL_PROJECTION_TYPES and has a name")
+{
+    for (auto type: ALL_PROJECTION_TYPES)
+    {
+        CAPTURE(get_projection_name(type));
+        REQUIRE(get_projection_type(get_projection_name(type)) == type);
+        REQUIRE(std::any_of(std::begin(TEST_VIEWS), std::end(TEST_VIEWS),
+                            [&](auto& tv) {return tv.type == type;}));
+    }
+    REQUIRE_THROWS(get_projection_type("equirectangular"));
+}
+
+TEST_CASE("Reprojected images match the projections' forward formulas")
+{
+    auto panorama = make_direction_image(2048);
+    for (const auto& tv: TEST_VIEWS)
+    {
+        CAPTURE(get_description(tv));
+        auto img = reproject(panorama, tv.type, tv.view, tv.width, tv.height);
+        auto [max_diff, count] = compare_with_reference(img, tv);
+        CAPTURE(count);
+        REQUIRE(count >= REFERENCE_POINTS / 20);
+        REQUIRE(max_diff <= MAX_REFERENCE_DIFF);
+
+        auto single = reproject(panorama, tv.type, tv.view, tv.width, tv.height, 1);
+        REQUIRE(single.size() == img.size());
+        REQUIRE(std::equal(img.data(), img.data() + img.size(), single.data()));
+    }
+}
+
+TEST_CASE("The perspective projection matches the viewer's")
+{
+    for (const auto& tv: TEST_VIEWS)
+    {
+        if (tv.type != ProjectionType::PERSPECTIVE)
+            continue;
+
+        CAPTURE(get_description(tv));
+        PerspectiveProjection projection(tv.view, tv.width, tv.height);
+        SpherePosCalculator calculator;
+        calculator.set_screen_res({double(tv.width), double(tv.height)});
+        calculator.set_view_angle(tv.view.view_angle);
+        calculator.set_eye_dist(PerspectiveProjection::EYE_DIST);
+        calculator.set_fixed_point({0, 0}, {1.0, tv.view.azimuth, tv.view.polar});
+        for (double x = -1; x <= 1; x += 0.25)
+        {
+            for (double y = -1; y <= 1; y += 0.25)
+            {
+                CAPTURE(x, y);
+                auto dir = projection.calc_direction({x, y});
+                REQUIRE(dir);
+                auto expected = to_cartesian(calculator.calc_sphere_pos({x, y}));
+                REQUIRE(get_length(*dir / get_length(*dir) - expected) < 1e-9);
+            }
+        }
+    }
+}
@@ -54,3 +54,88 @@ function(target_embed_cpp_data target_name)
             $<BUILD_INTERFACE:${CMAKE_CURRENT_BINARY_DIR}/cppembed_include>
         )
 endfunction()
+
+# Sets CPPEMBED_BINARY_FORMAT to the fastest format the C compiler
+# supports: embed if it supports C23's #embed, incbin if it accepts the
+# assembler's .incbin directive, otherwise string.
+function(cppembed_find_binary_format)
+    if (DEFINED CPPEMBED_BINARY_FORMAT)
+        return()
+    endif ()
+
+    find_package(Python3 COMPONENTS Interpreter REQUIRED)
+    get_property(SCRIPT_DIR GLOBAL PROPERTY cppembed_cmake_module_dir)
+    set(PROBE_DIR "${CMAKE_BINARY_DIR}/cppembed_probe")
+    file(WRITE "${PROBE_DIR}/probe.bin" "cppembed")
+
+    set(RESULT string)
+    foreach (FORMAT IN ITEMS embed incbin)
+        execute_process(
+            COMMAND "${Python3_EXECUTABLE}" "${SCRIPT_DIR}/cppembed.py"
+                --binary CPPEMBED_PROBE --format ${FORMAT}
+                "${PROBE_DIR}/probe.bin" -o "${PROBE_DIR}/${FORMAT}.c"
+            RESULT_VARIABLE SCRIPT_RESULT)
+        if (SCRIPT_RESULT EQUAL 0)
+            set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+            try_compile(HAS_FORMAT "${PROBE_DIR}/${FORMAT}"
+                SOURCES "${PROBE_DIR}/${FORMAT}.c")
+            if (HAS_FORMAT)
+                set(RESULT ${FORMAT})
+                break()
+            endif ()
+        endif ()
+    endforeach ()
+
+    message(STATUS "cppembed binary format: ${RESULT}")
+    set(CPPEMBED_BINARY_FORMAT ${RESULT} CACHE STRING
+        "How cppembed includes binary files: embed, incbin or string.")
+endfunction()
+
+# Embeds FILE as the C array NAME in target_name. The header NAME.hpp
+# declares the array, NAME_SIZE and NAME_ALIGNMENT. Unlike
+# target_embed_cpp_data, the data is never parsed as a C++ string
+# literal if the compiler supports #embed or .incbin, which makes it
+# practical to embed files that are several megabytes large.
+function(target_embed_binary_data target_name)
+    find_package(Python3 COMPONENTS Interpreter REQUIRED)
+
+    cmake_parse_arguments(ARG "" "NAME;FILE;FORMAT;ALIGNMENT" "" ${ARGN})
+
+    if (NOT DEFINED ARG_NAME OR NOT DEFINED ARG_FILE)
+        message(FATAL_ERROR "target_embed_binary_data requires NAME and FILE.")
+    endif ()
+
+    if (DEFINED ARG_FORMAT)
+        set(FORMAT ${ARG_FORMAT})
+    else ()
+        cppembed_find_binary_format()
+        set(FORMAT ${CPPEMBED_BINARY_FORMAT})
+    endif ()
+
+    if (DEFINED ARG_ALIGNMENT)
+        set(ALIGNMENT ${ARG_ALIGNMENT})
+    else ()
+        set(ALIGNMENT 16)
+    endif ()
+
+    file(REAL_PATH "${ARG_FILE}" REAL_INPUT_PATH)
+    set(SOURCE_PATH "${CMAKE_CURRENT_BINARY_DIR}/cppembed_src/${ARG_NAME}.c")
+    set(HEADER_PATH "${CMAKE_CURRENT_BINARY_DIR}/cppembed_include/${ARG_NAME}.hpp")
+    get_property(SCRIPT_DIR GLOBAL PROPERTY cppembed_cmake_module_dir)
+    add_custom_command(OUTPUT "${SOURCE_PATH}" "${HEADER_PATH}"
+        COMMAND "${Python3_EXECUTABLE}" ${SCRIPT_DIR}/cppembed.py
+            --binary ${ARG_NAME} --format ${FORMAT} --align ${ALIGNMENT}
+            "${REAL_INPUT_PATH}" -o "${SOURCE_PATH}" --header "${HEADER_PATH}"
+        DEPENDS "${REAL_INPUT_PATH}" ${SCRIPT_DIR}/cppembed.py)
+
+    # The assembler reads the file itself when the format is incbin.
+    set_source_files_properties("${SOURCE_PATH}"
+        PROPERTIES OBJECT_DEPENDS "${REAL_INPUT_PATH}")
+
+    target_sources(${target_name} PRIVATE "${SOURCE_PATH}" "${HEADER_PATH}")
+
+    target_include_directories(${target_name} BEFORE
+        PRIVATE
+            $<BUILD_INTERFACE:${CMAKE_CURRENT_BINARY_DIR}/cppembed_include>
+        )
+endfunction()
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+# -*- coding: UTF-8 -*-
+# ===========================================================================
+# Copyright © 2026 Jan Erik Breimo. All rights reserved.
+# Created by Jan Erik Breimo on 2026-10-18.
+#
+# This file is distributed under the BSD License.
+# License text is included with the source distribution.
+# ===========================================================================
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+SCRIPT_DIR = os.path.dirname(os.path.realpath(__file__))
+
+
+def run_timed(command):
+    start = time.perf_counter()
+    result = subprocess.run(command, stdout=subprocess.DEVNULL,
+                            stderr=subprocess.PIPE, text=True)
+    return time.perf_counter() - start, result
+
+
+def benchmark_format(binary_format, data_path, work_dir, compiler):
+    source_path = os.path.join(work_dir, f"{binary_format}.c")
+    object_path = os.path.join(work_dir, f"{binary_format}.o")
+    gen_time, result = run_timed([
+        sys.executable, os.path.join(SCRIPT_DIR, "cppembed.py"),
+        "--binary", "BENCHMARK_DATA", "--format", binary_format,
+        data_path, "-o", source_path])
+    if result.returncode != 0:
+        return None
+    compile_time, result = run_timed(
+        compiler + ["-O2", "-c", source_path, "-o", object_path])
+    if result.returncode != 0:
+        return None
+    return (gen_time, compile_time, os.path.getsize(source_path),
+            os.path.getsize(object_path))
+
+
+def main():
+    ap = argparse.ArgumentParser(
+        description="Compares the time it takes to generate and compile"
+                    " the sources for each of cppembed's binary formats.")
+    ap.add_argument("-s", "--size", metavar="MB", default=10, type=float,
+                    help="Set the size of the embedded file. Default is"
+                         " 10 MB.")
+    ap.add_argument("-c", "--compiler", metavar="CMD",
+                    default=os.environ.get("CC", "cc"),
+                    help="Set the C compiler. Default is $CC or cc.")
+    args = ap.parse_args()
+
+    with tempfile.TemporaryDirectory() as work_dir:
+        data_path = os.path.join(work_dir, "data.bin")
+        with open(data_path, "wb") as f:
+            f.write(os.urandom(int(args.size * 1024 * 1024)))
+
+        print(f"Embedding {args.size:g} MB with {args.compiler}")
+        print(f"{'format':8} {'generate':>10} {'compile':>10}"
+              f" {'source':>12} {'object':>12}")
+        for binary_format in ["embed", "incbin", "string"]:
+            result = benchmark_format(binary_format, data_path, work_dir,
+                                      args.compiler.split())
+            if result is None:
+                print(f"{binary_format:8} {'not supported':>10}")
+                continue
+            gen_time, compile_time, source_size, object_size = result
+            print(f"{binary_format:8} {gen_time:9.2f}s {compile_time:9.2f}s"
+                  f" {source_size:12} {object_size:12}")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
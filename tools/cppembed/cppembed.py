@@ -195,6 +195,98 @@ def process_template(file, search_paths, line_width, output_func):
             output_func(line)
 
 
+BINARY_FORMATS = ["embed", "incbin", "string"]
+
+BINARY_HEADER = """\
+// Generated by cppembed from {file_name}.
+#pragma once
+#include <cstddef>
+
+extern "C" const unsigned char {name}[];
+constexpr size_t {name}_SIZE = {size};
+constexpr size_t {name}_ALIGNMENT = {align};
+"""
+
+EMBED_SOURCE = """\
+// Generated by cppembed from {file_name}.
+_Alignas({align}) const unsigned char {name}[] = {{
+#embed "{path}"
+}};
+"""
+
+EMPTY_SOURCE = """\
+// Generated by cppembed from {file_name}.
+_Alignas({align}) const unsigned char {name}[1] = {{0}};
+"""
+
+# The data is placed in the read-only data section by the assembler.
+# __USER_LABEL_PREFIX__ is the underscore that Mach-O and 32-bit Windows
+# put in front of C symbols.
+INCBIN_SOURCE = """\
+// Generated by cppembed from {file_name}.
+#define CPPEMBED_STR2(s) #s
+#define CPPEMBED_STR(s) CPPEMBED_STR2(s)
+#define CPPEMBED_SYMBOL CPPEMBED_STR(__USER_LABEL_PREFIX__) "{name}"
+
+#if defined(__APPLE__)
+#define CPPEMBED_SECTION ".const_data"
+#elif defined(_WIN32)
+#define CPPEMBED_SECTION ".section .rdata,\\"dr\\""
+#else
+#define CPPEMBED_SECTION ".section .rodata"
+#endif
+
+__asm__(
+    CPPEMBED_SECTION "\\n"
+    ".globl " CPPEMBED_SYMBOL "\\n"
+    ".balign {align}\\n"
+    CPPEMBED_SYMBOL ":\\n"
+    ".incbin \\"{path}\\"\\n"
+    ".text\\n"
+);
+"""
+
+
+def escape_c_path(path):
+    return path.replace("\\", "/").replace('"', '\\"')
+
+
+def write_binary_source(file_path, name, binary_format, align, line_width,
+                        output_func):
+    values = {
+        "file_name": os.path.basename(file_path),
+        "name": name,
+        "path": escape_c_path(os.path.realpath(file_path)),
+        "align": align
+    }
+    if binary_format == "string":
+        output_func("// Generated by cppembed from {file_name}.\n"
+                    "_Alignas({align}) const unsigned char {name}[] =\n"
+                    .format(**values))
+        write_file_as_string(file_path, line_width, "    ", ";\n",
+                             output_func)
+    elif binary_format == "incbin":
+        output_func(INCBIN_SOURCE.format(**values))
+    elif os.path.getsize(file_path) == 0:
+        output_func(EMPTY_SOURCE.format(**values))
+    else:
+        output_func(EMBED_SOURCE.format(**values))
+
+
+def write_binary_header(file_path, name, align, output_func):
+    output_func(BINARY_HEADER.format(file_name=os.path.basename(file_path),
+                                     name=name,
+                                     size=os.path.getsize(file_path),
+                                     align=align))
+
+
+def open_output_file(path):
+    dir_name = os.path.dirname(path)
+    if dir_name and not os.path.exists(dir_name):
+        os.makedirs(dir_name)
+    return open(path, "w")
+
+
 def main():
     ap = argparse.ArgumentParser()
     ap.add_argument("--stdin", action="store_const", const=True,
@@ -206,12 +298,46 @@ def main():
                          " look for the embedded files.")
     ap.add_argument("-o", "--output", metavar="PATH",
                     help="Set the name of the output file. Default is stdout.")
+    ap.add_argument("-b", "--binary", metavar="NAME",
+                    help="Make FILE the contents of the C array NAME."
+                         " The output is a C file that defines the array,"
+                         " --header sets the name of the C++ header that"
+                         " declares it.")
+    ap.add_argument("--header", metavar="PATH",
+                    help="Set the name of the header file in --binary"
+                         " mode.")
+    ap.add_argument("-f", "--format", choices=BINARY_FORMATS,
+                    default="string",
+                    help="Set how the data is included in --binary mode:"
+                         " with C23's #embed, with the assembler's .incbin"
+                         " directive or as a string literal. Default is"
+                         " string.")
+    ap.add_argument("-a", "--align", metavar="N", default=16, type=int,
+                    help="Set the alignment of the array in --binary mode."
+                         " Default is 16.")
     ap.add_argument("file", metavar="FILE", nargs="?",
-                    help="A C or C++ file with #embed directives.")
+                    help="A C or C++ file with #embed directives, or any"
+                         " file in --binary mode.")
     args = ap.parse_args()
     if (not args.file) == (not args.stdin):
         ap.error("Must either specify FILE or --stdin")
 
+    if args.binary:
+        if not args.file:
+            ap.error("--binary requires FILE")
+        if not os.path.exists(args.file):
+            print(f"File not found: {args.file}")
+            return 1
+        output_file = open_output_file(args.output) if args.output \
+            else sys.stdout
+        write_binary_source(args.file, args.binary, args.format, args.align,
+                            args.width, output_file.write)
+        if args.header:
+            with open_output_file(args.header) as header_file:
+                write_binary_header(args.file, args.binary, args.align,
+                                    header_file.write)
+        return 0
+
     include_dirs = args.include or []
     input_file = sys.stdin
     if args.file:
@@ -221,10 +347,7 @@ def main():
     include_dirs.append(os.path.curdir)
 
     if args.output:
-        dir_name = os.path.dirname(args.output)
-        if not os.path.exists(dir_name):
-            os.makedirs(dir_name)
-        output_file = open(args.output, "w")
+        output_file = open_output_file(args.output)
     else:
         output_file = sys.stdout
 